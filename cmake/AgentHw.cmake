@@ -49,6 +49,10 @@ add_library(hw_switch_warmboot_helper
   fboss/agent/hw/HwSwitchWarmBootHelper.cpp
 )
 
+add_library(state_delta_scheduler
+  fboss/agent/hw/StateDeltaScheduler.cpp
+)
+
 add_library(buffer_stats
   fboss/agent/hw/BufferStatsLogger.cpp
 )
@@ -57,6 +61,11 @@ add_library(hw_resource_stats_publisher
   fboss/agent/hw/HwResourceStatsPublisher.cpp
 )
 
+target_link_libraries(state_delta_scheduler
+  error
+  Folly::folly
+)
+
 target_link_libraries(hw_switch_warmboot_helper
   async_logger
   utils
@@ -226,6 +226,32 @@ target_link_libraries(hw_ecmp_shrink_speed
   Folly::folly
 )
 
+add_library(hw_voq_ecmp_shrink_speed
+  fboss/agent/hw/benchmarks/HwVoqEcmpShrinkSpeedBenchmark.cpp
+)
+
+target_link_libraries(hw_voq_ecmp_shrink_speed
+  config_factory
+  hw_packet_utils
+  ecmp_helper
+  agent_ensemble
+  agent_benchmarks
+  function_call_time_reporter
+  Folly::folly
+)
+
+add_library(hw_l2_learning_burst_speed
+  fboss/agent/hw/benchmarks/HwL2LearningBurstBenchmark.cpp
+)
+
+target_link_libraries(hw_l2_learning_burst_speed
+  config_factory
+  hw_packet_utils
+  agent_ensemble
+  agent_benchmarks
+  Folly::folly
+)
+
 add_library(hw_ecmp_shrink_with_competing_route_updates_speed
   fboss/agent/hw/benchmarks/HwEcmpShrinkWithCompetingRouteUpdatesBenchmark.cpp
 )
@@ -6,6 +6,26 @@
 # NOTE: All the benchmark executables need to link in ${SAI_IMPL_ARG}
 # using '--whole-archive' flag in order to ensure SAI_IMPL symbols are included
 
+add_library(hw_sai_store_reload_speed
+  fboss/agent/hw/sai/benchmarks/HwSaiStoreReloadBenchmark.cpp
+)
+
+target_link_libraries(hw_sai_store_reload_speed
+  config_factory
+  agent_ensemble
+  agent_benchmarks
+  route_scale_gen
+  sai_switch
+  sai_store
+  Folly::folly
+)
+
+set_target_properties(hw_sai_store_reload_speed PROPERTIES COMPILE_FLAGS
+  "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+  -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+  -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+)
+
 function(BUILD_SAI_BENCHMARKS SAI_IMPL_NAME SAI_IMPL_ARG)
 
   message(STATUS "Building SAI benchmarks SAI_IMPL_NAME: ${SAI_IMPL_NAME} SAI_IMPL_ARG: ${SAI_IMPL_ARG}")
@@ -238,6 +258,24 @@ function(BUILD_SAI_BENCHMARKS SAI_IMPL_NAME SAI_IMPL_ARG)
     -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
   )
 
+  add_executable(sai_store_reload_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX} /dev/null)
+
+  target_link_libraries(sai_store_reload_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
+    -Wl,--whole-archive
+    sai_agent_benchmarks_main
+    hw_sai_store_reload_speed
+    route_scale_gen
+    ${SAI_IMPL_ARG}
+    -Wl,--no-whole-archive
+  )
+
+  set_target_properties(sai_store_reload_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
+    PROPERTIES COMPILE_FLAGS
+    "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+    -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+    -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+  )
+
   add_executable(sai_ecmp_shrink_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX} /dev/null)
 
   target_link_libraries(sai_ecmp_shrink_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
@@ -257,6 +295,42 @@ function(BUILD_SAI_BENCHMARKS SAI_IMPL_NAME SAI_IMPL_ARG)
     -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
   )
 
+  add_executable(sai_voq_ecmp_shrink_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX} /dev/null)
+
+  target_link_libraries(sai_voq_ecmp_shrink_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
+    -Wl,--whole-archive
+    hw_voq_ecmp_shrink_speed
+    sai_agent_benchmarks_main
+    sai_ecmp_utils
+    sai_port_utils
+    ${SAI_IMPL_ARG}
+    -Wl,--no-whole-archive
+  )
+
+  set_target_properties(sai_voq_ecmp_shrink_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
+    PROPERTIES COMPILE_FLAGS
+    "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+    -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+    -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+  )
+
+  add_executable(sai_l2_learning_burst_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX} /dev/null)
+
+  target_link_libraries(sai_l2_learning_burst_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
+    -Wl,--whole-archive
+    sai_agent_benchmarks_main
+    hw_l2_learning_burst_speed
+    ${SAI_IMPL_ARG}
+    -Wl,--no-whole-archive
+  )
+
+  set_target_properties(sai_l2_learning_burst_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
+    PROPERTIES COMPILE_FLAGS
+    "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+    -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+    -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+  )
+
   add_executable(sai_ecmp_shrink_with_competing_route_updates_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX} /dev/null)
 
   target_link_libraries(sai_ecmp_shrink_with_competing_route_updates_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
@@ -460,6 +534,9 @@ if(SAI_IMPL AND BENCHMARK_INSTALL)
   install(
     TARGETS
     sai_ecmp_shrink_speed-sai_impl-${SAI_VER_SUFFIX})
+  install(
+    TARGETS
+    sai_voq_ecmp_shrink_speed-sai_impl-${SAI_VER_SUFFIX})
   install(
     TARGETS
     sai_hgrid_uu_scale_route_add_speed-sai_impl-${SAI_VER_SUFFIX})
@@ -472,6 +549,9 @@ if(SAI_IMPL AND BENCHMARK_INSTALL)
   install(
     TARGETS
     sai_warm_boot_exit_speed-sai_impl-${SAI_VER_SUFFIX})
+  install(
+    TARGETS
+    sai_store_reload_speed-sai_impl-${SAI_VER_SUFFIX})
   install(
     TARGETS
     sai_tx_slow_path_rate-sai_impl-${SAI_VER_SUFFIX})
@@ -143,6 +143,7 @@ target_link_libraries(hw_switch_ensemble
 )
 
 add_library(load_balancer_utils
+  fboss/agent/hw/test/LoadBalancerSimulator.cpp
   fboss/agent/hw/test/LoadBalancerUtils.cpp
 )
 
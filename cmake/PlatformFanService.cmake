@@ -52,6 +52,7 @@ target_link_libraries(fan_service
 
 add_executable(fan_service_sw_test
   fboss/platform/fan_service/tests/BspTests.cpp
+  fboss/platform/fan_service/tests/ControlLogicTests.cpp
   fboss/platform/fan_service/tests/ServiceConfigTests.cpp
 )
 
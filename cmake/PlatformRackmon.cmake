@@ -25,6 +25,7 @@ add_fbthrift_cpp_library(
 add_library(rackmon_lib
   fboss/platform/rackmon/RackmonThriftHandler.cpp
   fboss/platform/rackmon/Device.cpp
+  fboss/platform/rackmon/InterfaceWorker.cpp
   fboss/platform/rackmon/Modbus.cpp
   fboss/platform/rackmon/ModbusCmds.cpp
   fboss/platform/rackmon/ModbusDevice.cpp
@@ -60,6 +61,7 @@ target_link_libraries(rackmon
 add_executable(rackmon_test
   fboss/platform/rackmon/tests/DeviceTest.cpp
   fboss/platform/rackmon/tests/TempDir.h
+  fboss/platform/rackmon/tests/InterfaceWorkerTest.cpp
   fboss/platform/rackmon/tests/ModbusCmdsTest.cpp
   fboss/platform/rackmon/tests/ModbusDeviceTest.cpp
   fboss/platform/rackmon/tests/ModbusTest.cpp
@@ -28,6 +28,7 @@ add_library(sensor_service_lib
   fboss/platform/sensor_service/Flags.cpp
   fboss/platform/sensor_service/SensorServiceImpl.cpp
   fboss/platform/sensor_service/SensorServiceThriftHandler.cpp
+  fboss/platform/sensor_service/SysfsSampler.cpp
   fboss/platform/sensor_service/oss/FsdbSyncer.cpp
   fboss/platform/sensor_service/oss/SensorStatsPub.cpp
 )
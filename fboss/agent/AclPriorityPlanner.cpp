@@ -0,0 +1,118 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "fboss/agent/AclPriorityPlanner.h"
+
+#include "fboss/agent/FbossError.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace facebook::fboss {
+
+AclPriorityPlanner::AclPriorityPlanner(int minPriority, int gap)
+    : minPriority_(minPriority), gap_(gap) {
+  CHECK_GT(gap_, 0);
+}
+
+std::vector<bool> AclPriorityPlanner::findKept(
+    const std::vector<std::optional<int>>& curPriorities) const {
+  // Patience sort: tails[len] is the entry ending the lowest run of
+  // length len + 1 found so far, parents link each entry to its run.
+  std::vector<size_t> tails;
+  std::vector<int64_t> parents(curPriorities.size(), -1);
+  for (size_t i = 0; i < curPriorities.size(); ++i) {
+    const auto& priority = curPriorities[i];
+    if (!priority || *priority < minPriority_) {
+      continue;
+    }
+    auto it = std::lower_bound(
+        tails.begin(), tails.end(), *priority, [&](size_t entry, int prio) {
+          return *curPriorities[entry] < prio;
+        });
+    if (it != tails.begin()) {
+      parents[i] = *(it - 1);
+    }
+    if (it == tails.end()) {
+      tails.push_back(i);
+    } else {
+      *it = i;
+    }
+  }
+  std::vector<bool> kept(curPriorities.size(), false);
+  for (int64_t i = tails.empty() ? -1 : tails.back(); i >= 0; i = parents[i]) {
+    kept[i] = true;
+  }
+  return kept;
+}
+
+std::vector<int> AclPriorityPlanner::plan(
+    const std::vector<std::optional<int>>& curPriorities,
+    const folly::F14FastSet<int>& inUse) const {
+  auto kept = findKept(curPriorities);
+  auto isFree = [&](int64_t priority) {
+    if (priority > std::numeric_limits<int>::max()) {
+      throw FbossError("Ran out of ACL priorities above ", minPriority_);
+    }
+    return !inUse.contains(priority);
+  };
+  std::vector<int> priorities(curPriorities.size());
+  // Last priority assigned, the next entry needs a higher one
+  int64_t lo = static_cast<int64_t>(minPriority_) - 1;
+  size_t begin = 0;
+  while (begin < curPriorities.size()) {
+    if (kept[begin]) {
+      lo = priorities[begin] = *curPriorities[begin];
+      ++begin;
+      continue;
+    }
+    // Entries in [begin, end) need priorities between lo and the entry
+    // kept at end, if any.
+    auto end = begin;
+    std::vector<int> free;
+    auto scanFrom = lo + 1;
+    while (true) {
+      while (end < curPriorities.size() && !kept[end]) {
+        ++end;
+      }
+      if (end == curPriorities.size()) {
+        break;
+      }
+      for (auto priority = scanFrom; priority < *curPriorities[end];
+           ++priority) {
+        if (isFree(priority)) {
+          free.push_back(priority);
+        }
+      }
+      scanFrom = *curPriorities[end] + 1;
+      if (free.size() >= end - begin) {
+        break;
+      }
+      // No room before the next kept entry, move it as well
+      kept[end] = false;
+    }
+    auto numEntries = end - begin;
+    if (end == curPriorities.size()) {
+      // Nothing kept after these, lay them out gap apart
+      for (auto i = begin; i < end; ++i) {
+        auto priority = lo + gap_;
+        while (!isFree(priority)) {
+          ++priority;
+        }
+        priorities[i] = static_cast<int>(priority);
+        lo = priority;
+      }
+    } else {
+      // Spread evenly over the free priorities
+      for (size_t i = 0; i < numEntries; ++i) {
+        auto freeIdx = (i + 1) * (free.size() + 1) / (numEntries + 1) - 1;
+        priorities[begin + i] = free[freeIdx];
+      }
+    }
+    begin = end;
+  }
+  return priorities;
+}
+
+} // namespace facebook::fboss
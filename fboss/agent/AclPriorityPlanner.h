@@ -0,0 +1,52 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <folly/container/F14Set.h>
+
+#include <optional>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * Assigns priorities to an ordered list of ACL entries, lower priorities
+ * matching first, while moving as few already programmed entries as
+ * possible.
+ *
+ * HW cannot change the priority of an ACL entry in place, a move is a
+ * remove and an add. So instead of numbering entries by their position,
+ * entries are laid out gap apart. Entries whose current priorities are
+ * still in order (the longest increasing run of them) keep their
+ * priority, and the others are spread over the free priorities between
+ * them. If there is no room between two kept entries, the next kept
+ * entries are moved too, until there is.
+ *
+ * New priorities are never ones in use before the update. So new entries
+ * can be added in any order, and a moved entry can be programmed at its
+ * new priority before being removed from its old one.
+ */
+class AclPriorityPlanner {
+ public:
+  AclPriorityPlanner(int minPriority, int gap);
+
+  /*
+   * curPriorities holds, in the desired order, the priority each entry is
+   * programmed at, if any. inUse holds every priority programmed, including
+   * the ones of entries going away. Returns strictly increasing priorities,
+   * no lower than minPriority, for all entries.
+   */
+  std::vector<int> plan(
+      const std::vector<std::optional<int>>& curPriorities,
+      const folly::F14FastSet<int>& inUse) const;
+
+ private:
+  // Entries in the longest strictly increasing run of current priorities
+  std::vector<bool> findKept(
+      const std::vector<std::optional<int>>& curPriorities) const;
+
+  int minPriority_;
+  int gap_;
+};
+
+} // namespace facebook::fboss
@@ -18,6 +18,7 @@
 #include <string>
 
 #include "fboss/agent/AclNexthopHandler.h"
+#include "fboss/agent/AclPriorityPlanner.h"
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/LacpTypes.h"
 #include "fboss/agent/LoadBalancerConfigApplier.h"
@@ -86,6 +87,21 @@ using folly::StringPiece;
 using std::make_shared;
 using std::shared_ptr;
 
+DEFINE_bool(
+    skip_unchanged_config_sections,
+    true,
+    "On config reload, skip re-evaluating config sections that are "
+    "identical to the previously applied config");
+
+DEFINE_int32(
+    acl_priority_gap,
+    0,
+    "If non zero, space dataplane ACL priorities this far apart and keep "
+    "the priorities of ACLs that stay in order on config changes, so that "
+    "inserting an ACL does not reprogram the ones after it. Gaps use up HW "
+    "priorities, so size this to the ACL table and priority range. "
+    "0 numbers ACLs by their position in config.");
+
 namespace {
 
 const uint8_t kV6LinkLocalAddrMask{64};
@@ -130,9 +146,11 @@ class ThriftConfigApplier {
       const cfg::SwitchConfig* config,
       const Platform* platform,
       RoutingInformationBase* rib,
-      AclNexthopHandler* aclNexthopHandler)
+      AclNexthopHandler* aclNexthopHandler,
+      const cfg::SwitchConfig* prevConfig = nullptr)
       : orig_(orig),
         cfg_(config),
+        prevCfg_(prevConfig),
         platform_(platform),
         rib_(rib),
         aclNexthopHandler_(aclNexthopHandler) {}
@@ -141,9 +159,11 @@ class ThriftConfigApplier {
       const cfg::SwitchConfig* config,
       const Platform* platform,
       RouteUpdateWrapper* routeUpdater,
-      AclNexthopHandler* aclNexthopHandler)
+      AclNexthopHandler* aclNexthopHandler,
+      const cfg::SwitchConfig* prevConfig = nullptr)
       : orig_(orig),
         cfg_(config),
+        prevCfg_(prevConfig),
         platform_(platform),
         routeUpdater_(routeUpdater),
         aclNexthopHandler_(aclNexthopHandler) {}
@@ -155,6 +175,23 @@ class ThriftConfigApplier {
   ThriftConfigApplier(ThriftConfigApplier const&) = delete;
   ThriftConfigApplier& operator=(ThriftConfigApplier const&) = delete;
 
+  /*
+   * Section fingerprinting for incremental config application. Each
+   * *Unchanged() returns true if every config field the corresponding
+   * update*() reads is identical in prevCfg_ and cfg_, in which case orig_
+   * already holds the resulting state and the update can be skipped.
+   * Sections that also depend on state not derived from config (ports and
+   * transceivers, interfaces and routes, ...) are always re-evaluated.
+   */
+  bool canSkipUnchangedSections() const;
+  bool qcmCfgUnchanged() const;
+  bool bufferPoolConfigsUnchanged() const;
+  bool aclsUnchanged(bool mirrorsChanged) const;
+  bool qosPoliciesUnchanged() const;
+  bool sflowCollectorsUnchanged() const;
+  bool loadBalancersUnchanged() const;
+  bool ipInIpTunnelsUnchanged() const;
+
   template <typename Node, typename NodeMap>
   bool updateMap(
       NodeMap* map,
@@ -304,8 +341,29 @@ class ThriftConfigApplier {
       int* numExistingTablesProcessed);
   std::shared_ptr<AclMap> updateAcls(
       cfg::AclStage aclStage,
-      std::vector<cfg::AclEntry> configEntries,
+      const std::vector<cfg::AclEntry>& configEntries,
       std::optional<std::string> tableName = std::nullopt);
+  // Priorities for the dataplane ACLs, with --acl_priority_gap
+  std::vector<int> planDataplaneAclPriorities(
+      cfg::AclStage aclStage,
+      const std::vector<cfg::AclEntry>& configEntries,
+      const std::optional<std::string>& tableName) const;
+  struct PrevAclConfig {
+    const cfg::AclEntry* entry{nullptr};
+    // traffic policy action the entry was matched to, if any
+    const cfg::MatchAction* action{nullptr};
+    bool isCoppAcl{false};
+  };
+  flat_map<std::string, PrevAclConfig> getPrevAclConfigs(
+      const std::optional<std::string>& tableName) const;
+  std::shared_ptr<AclEntry> getUnchangedAcl(
+      const flat_map<std::string, PrevAclConfig>& prevAcls,
+      cfg::AclStage aclStage,
+      const cfg::AclEntry& acl,
+      const cfg::MatchAction* action,
+      bool isCoppAcl,
+      int priority,
+      const std::optional<std::string>& tableName) const;
   std::shared_ptr<AclEntry> createAcl(
       const cfg::AclEntry* config,
       int priority,
@@ -411,6 +469,9 @@ class ThriftConfigApplier {
   std::shared_ptr<SwitchState> orig_;
   std::shared_ptr<SwitchState> new_;
   const cfg::SwitchConfig* cfg_{nullptr};
+  // Config orig_ was built from, if known. Used to skip sections of cfg_
+  // that did not change.
+  const cfg::SwitchConfig* prevCfg_{nullptr};
   const Platform* platform_{nullptr};
   RoutingInformationBase* rib_{nullptr};
   RouteUpdateWrapper* routeUpdater_{nullptr};
@@ -440,7 +501,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
   new_ = orig_->clone();
   bool changed = false;
 
-  {
+  if (!qcmCfgUnchanged()) {
     bool qcmChanged = false;
     auto newQcmConfig = updateQcmCfg(&qcmChanged);
     if (qcmChanged) {
@@ -459,7 +520,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
 
   processVlanPorts();
 
-  {
+  if (!bufferPoolConfigsUnchanged()) {
     bool bufferPoolConfigChanged = false;
     auto newBufferPoolCfg = updateBufferPoolConfigs(&bufferPoolConfigChanged);
     if (bufferPoolConfigChanged) {
@@ -512,16 +573,18 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
   }
 
   // updateMirrors must be called after updatePorts, mirror needs ports!
+  bool mirrorsChanged = false;
   {
     auto newMirrors = updateMirrors();
     if (newMirrors) {
       new_->resetMirrors(std::move(newMirrors));
+      mirrorsChanged = true;
       changed = true;
     }
   }
 
   // updateAcls must be called after updateMirrors, acls may need mirror!
-  {
+  if (!aclsUnchanged(mirrorsChanged)) {
     if (FLAGS_enable_acl_table_group) {
       auto newAclTableGroups = updateAclTableGroups();
       if (newAclTableGroups) {
@@ -537,7 +600,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
     }
   }
 
-  {
+  if (!qosPoliciesUnchanged()) {
     auto newQosPolicies = updateQosPolicies();
     if (newQosPolicies) {
       new_->resetQosPolicies(std::move(newQosPolicies));
@@ -725,7 +788,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
   }
 
   // Add sFlow collectors
-  {
+  if (!sflowCollectorsUnchanged()) {
     auto newCollectors = updateSflowCollectors();
     if (newCollectors) {
       new_->resetSflowCollectors(std::move(newCollectors));
@@ -733,7 +796,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
     }
   }
 
-  {
+  if (!loadBalancersUnchanged()) {
     LoadBalancerConfigApplier loadBalancerConfigApplier(
         orig_->getLoadBalancers(), cfg_->get_loadBalancers(), platform_);
     auto newLoadBalancers = loadBalancerConfigApplier.updateLoadBalancers();
@@ -743,7 +806,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
     }
   }
 
-  {
+  if (!ipInIpTunnelsUnchanged()) {
     auto newTunnels = updateIpInIpTunnels();
     if (newTunnels) {
       new_->resetTunnels(std::move(newTunnels));
@@ -820,6 +883,79 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
   return new_;
 }
 
+bool ThriftConfigApplier::canSkipUnchangedSections() const {
+  return prevCfg_ && FLAGS_skip_unchanged_config_sections;
+}
+
+bool ThriftConfigApplier::qcmCfgUnchanged() const {
+  return canSkipUnchangedSections() &&
+      prevCfg_->qcmConfig() == cfg_->qcmConfig();
+}
+
+bool ThriftConfigApplier::bufferPoolConfigsUnchanged() const {
+  return canSkipUnchangedSections() &&
+      prevCfg_->bufferPoolConfigs() == cfg_->bufferPoolConfigs();
+}
+
+bool ThriftConfigApplier::aclsUnchanged(bool mirrorsChanged) const {
+  // ACLs are validated against the mirrors in new_
+  if (!canSkipUnchangedSections() || mirrorsChanged) {
+    return false;
+  }
+  if (prevCfg_->acls() != cfg_->acls() ||
+      prevCfg_->aclTableGroup() != cfg_->aclTableGroup() ||
+      prevCfg_->trafficCounters() != cfg_->trafficCounters() ||
+      prevCfg_->cpuTrafficPolicy() != cfg_->cpuTrafficPolicy() ||
+      prevCfg_->dataPlaneTrafficPolicy() != cfg_->dataPlaneTrafficPolicy()) {
+    return false;
+  }
+  // Redirect ACLs resolve their nexthops against the current FIB, so their
+  // state is not a function of config alone.
+  auto hasRedirect = [](const cfg::TrafficPolicyConfig& policy) {
+    return std::any_of(
+        policy.matchToAction()->begin(),
+        policy.matchToAction()->end(),
+        [](const auto& mta) {
+          return mta.action()->redirectToNextHop().has_value();
+        });
+  };
+  if (auto cpuTrafficPolicy = cfg_->cpuTrafficPolicy()) {
+    if (auto trafficPolicy = cpuTrafficPolicy->trafficPolicy()) {
+      if (hasRedirect(*trafficPolicy)) {
+        return false;
+      }
+    }
+  }
+  if (auto dataPlaneTrafficPolicy = cfg_->dataPlaneTrafficPolicy()) {
+    if (hasRedirect(*dataPlaneTrafficPolicy)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ThriftConfigApplier::qosPoliciesUnchanged() const {
+  // The default dataplane qos policy is picked by dataPlaneTrafficPolicy
+  return canSkipUnchangedSections() &&
+      prevCfg_->qosPolicies() == cfg_->qosPolicies() &&
+      prevCfg_->dataPlaneTrafficPolicy() == cfg_->dataPlaneTrafficPolicy();
+}
+
+bool ThriftConfigApplier::sflowCollectorsUnchanged() const {
+  return canSkipUnchangedSections() &&
+      prevCfg_->sFlowCollectors() == cfg_->sFlowCollectors();
+}
+
+bool ThriftConfigApplier::loadBalancersUnchanged() const {
+  return canSkipUnchangedSections() &&
+      prevCfg_->loadBalancers() == cfg_->loadBalancers();
+}
+
+bool ThriftConfigApplier::ipInIpTunnelsUnchanged() const {
+  return canSkipUnchangedSections() &&
+      prevCfg_->ipInIpTunnels() == cfg_->ipInIpTunnels();
+}
+
 void ThriftConfigApplier::processUpdatedDsfNodes() {
   auto mySwitchId = new_->getSwitchSettings()->getSwitchId();
   CHECK(mySwitchId) << " Dsf node config requires switch ID to be set";
@@ -2684,13 +2820,56 @@ std::shared_ptr<AclTable> ThriftConfigApplier::updateAclTable(
 
 std::shared_ptr<AclMap> ThriftConfigApplier::updateAcls(
     cfg::AclStage aclStage,
-    std::vector<cfg::AclEntry> configEntries,
+    const std::vector<cfg::AclEntry>& configEntries,
     std::optional<std::string> tableName) {
   AclMap::NodeContainer newAcls;
   bool changed = false;
   int numExistingProcessed = 0;
   int priority = AclTable::kDataplaneAclMaxPriority;
   int cpuPriority = 1;
+  std::vector<int> plannedPriorities;
+  if (FLAGS_acl_priority_gap > 0) {
+    plannedPriorities =
+        planDataplaneAclPriorities(aclStage, configEntries, tableName);
+  }
+  size_t numPlannedPrioritiesUsed = 0;
+  auto nextDataplanePriority = [&]() {
+    if (FLAGS_acl_priority_gap > 0) {
+      return plannedPriorities.at(numPlannedPrioritiesUsed++);
+    }
+    return priority++;
+  };
+
+  // Entries whose config did not change since prevCfg_ are reused as is,
+  // so that changing one ACL does not re-create all of them.
+  auto prevAcls = getPrevAclConfigs(tableName);
+  auto updateOrReuseAcl = [&](const cfg::AclEntry& aclCfg,
+                              const cfg::MatchAction* actionCfg,
+                              bool isCoppAcl,
+                              int aclPriority,
+                              const MatchAction* matchAction = nullptr,
+                              bool enable = true) {
+    if (auto origAcl = getUnchangedAcl(
+            prevAcls,
+            aclStage,
+            aclCfg,
+            actionCfg,
+            isCoppAcl,
+            aclPriority,
+            tableName)) {
+      ++numExistingProcessed;
+      return origAcl;
+    }
+    return updateAcl(
+        aclStage,
+        aclCfg,
+        aclPriority,
+        &numExistingProcessed,
+        &changed,
+        tableName,
+        matchAction,
+        enable);
+  };
 
   // Start with the DROP acls, these should have highest priority
   auto acls = folly::gen::from(configEntries) |
@@ -2698,13 +2877,8 @@ std::shared_ptr<AclMap> ThriftConfigApplier::updateAcls(
                 return *entry.actionType() == cfg::AclActionType::DENY;
               }) |
       folly::gen::map([&](const cfg::AclEntry& entry) {
-                auto acl = updateAcl(
-                    aclStage,
-                    entry,
-                    priority++,
-                    &numExistingProcessed,
-                    &changed,
-                    tableName);
+                auto acl = updateOrReuseAcl(
+                    entry, nullptr, false, nextDataplanePriority());
                 return std::make_pair(acl->getID(), acl);
               }) |
       folly::gen::appendTo(newAcls);
@@ -2733,7 +2907,7 @@ std::shared_ptr<AclMap> ThriftConfigApplier::updateAcls(
     for (const auto& mta : *policy.matchToAction()) {
       auto a = aclByName.find(*mta.matcher());
       if (a != aclByName.end()) {
-        auto aclCfg = *(a->second);
+        const auto& aclCfg = *(a->second);
 
         // We've already added any DENY acls
         if (*aclCfg.actionType() == cfg::AclActionType::DENY) {
@@ -2781,13 +2955,11 @@ std::shared_ptr<AclMap> ThriftConfigApplier::updateAcls(
           }
         }
 
-        auto acl = updateAcl(
-            aclStage,
+        auto acl = updateOrReuseAcl(
             aclCfg,
-            isCoppAcl ? cpuPriority++ : priority++,
-            &numExistingProcessed,
-            &changed,
-            tableName,
+            &*mta.action(),
+            isCoppAcl,
+            isCoppAcl ? cpuPriority++ : nextDataplanePriority(),
             &matchAction,
             enableAcl);
 
@@ -2850,6 +3022,138 @@ std::shared_ptr<AclMap> ThriftConfigApplier::updateAcls(
   return orig_->getAcls()->clone(std::move(newAcls));
 }
 
+std::vector<int> ThriftConfigApplier::planDataplaneAclPriorities(
+    cfg::AclStage aclStage,
+    const std::vector<cfg::AclEntry>& configEntries,
+    const std::optional<std::string>& tableName) const {
+  // Dataplane ACLs, in the order updateAcls() assigns them priorities
+  std::vector<std::string> aclNames;
+  flat_map<std::string, const cfg::AclEntry*> aclByName;
+  for (const auto& entry : configEntries) {
+    if (*entry.actionType() == cfg::AclActionType::DENY) {
+      aclNames.push_back(*entry.name());
+    }
+    aclByName[*entry.name()] = &entry;
+  }
+  if (auto dataPlaneTrafficPolicy = cfg_->dataPlaneTrafficPolicy()) {
+    for (const auto& mta : *dataPlaneTrafficPolicy->matchToAction()) {
+      auto acl = aclByName.find(*mta.matcher());
+      if (acl != aclByName.end() &&
+          *acl->second->actionType() != cfg::AclActionType::DENY) {
+        aclNames.push_back(*mta.matcher());
+      }
+    }
+  }
+
+  std::shared_ptr<const AclMap> origAcls;
+  if (tableName.has_value()) {
+    origAcls = orig_->getAclsForTable(aclStage, tableName.value());
+  } else {
+    origAcls = orig_->getAcls();
+  }
+  folly::F14FastSet<int> inUse;
+  if (origAcls) {
+    for (const auto& iter : std::as_const(*origAcls)) {
+      inUse.insert(iter.second->getPriority());
+    }
+  }
+  std::vector<std::optional<int>> curPriorities;
+  curPriorities.reserve(aclNames.size());
+  for (const auto& aclName : aclNames) {
+    auto origAcl = origAcls ? origAcls->getEntryIf(aclName) : nullptr;
+    curPriorities.push_back(
+        origAcl ? std::make_optional(origAcl->getPriority()) : std::nullopt);
+  }
+  return AclPriorityPlanner(
+             AclTable::kDataplaneAclMaxPriority, FLAGS_acl_priority_gap)
+      .plan(curPriorities, inUse);
+}
+
+flat_map<std::string, ThriftConfigApplier::PrevAclConfig>
+ThriftConfigApplier::getPrevAclConfigs(
+    const std::optional<std::string>& tableName) const {
+  flat_map<std::string, PrevAclConfig> prevAcls;
+  // Counters are looked up by name from trafficCounters, any change there
+  // may change any entry.
+  if (!canSkipUnchangedSections() ||
+      prevCfg_->trafficCounters() != cfg_->trafficCounters()) {
+    return prevAcls;
+  }
+  const std::vector<cfg::AclEntry>* prevEntries = &*prevCfg_->acls();
+  if (tableName.has_value()) {
+    prevEntries = nullptr;
+    if (auto prevAclTableGroup = prevCfg_->aclTableGroup()) {
+      for (const auto& aclTable : *prevAclTableGroup->aclTables()) {
+        if (*aclTable.name() == tableName.value()) {
+          prevEntries = &*aclTable.aclEntries();
+        }
+      }
+    }
+    if (!prevEntries) {
+      return prevAcls;
+    }
+  }
+  for (const auto& entry : *prevEntries) {
+    prevAcls[*entry.name()].entry = &entry;
+  }
+  auto addActions = [&](const cfg::TrafficPolicyConfig& policy,
+                        bool isCoppAcl) {
+    for (const auto& mta : *policy.matchToAction()) {
+      auto prevAcl = prevAcls.find(*mta.matcher());
+      if (prevAcl != prevAcls.end()) {
+        prevAcl->second.action = &*mta.action();
+        prevAcl->second.isCoppAcl = isCoppAcl;
+      }
+    }
+  };
+  if (auto cpuTrafficPolicy = prevCfg_->cpuTrafficPolicy()) {
+    if (auto trafficPolicy = cpuTrafficPolicy->trafficPolicy()) {
+      addActions(*trafficPolicy, true);
+    }
+  }
+  if (auto dataPlaneTrafficPolicy = prevCfg_->dataPlaneTrafficPolicy()) {
+    addActions(*dataPlaneTrafficPolicy, false);
+  }
+  return prevAcls;
+}
+
+std::shared_ptr<AclEntry> ThriftConfigApplier::getUnchangedAcl(
+    const flat_map<std::string, PrevAclConfig>& prevAcls,
+    cfg::AclStage aclStage,
+    const cfg::AclEntry& acl,
+    const cfg::MatchAction* action,
+    bool isCoppAcl,
+    int priority,
+    const std::optional<std::string>& tableName) const {
+  auto prevAcl = prevAcls.find(*acl.name());
+  if (prevAcl == prevAcls.end() || !(*prevAcl->second.entry == acl) ||
+      prevAcl->second.isCoppAcl != isCoppAcl) {
+    return nullptr;
+  }
+  if (action) {
+    // redirect nexthops are resolved against the FIB, not config
+    if (!prevAcl->second.action || !(*prevAcl->second.action == *action) ||
+        action->redirectToNextHop().has_value()) {
+      return nullptr;
+    }
+  } else if (prevAcl->second.action) {
+    return nullptr;
+  }
+  std::shared_ptr<AclEntry> origAcl;
+  if (tableName.has_value()) {
+    if (auto origAcls = orig_->getAclsForTable(aclStage, tableName.value())) {
+      origAcl = origAcls->getEntryIf(*acl.name());
+    }
+  } else {
+    origAcl = orig_->getAcls()->getEntryIf(*acl.name());
+  }
+  // priority depends on the position of the entry in config
+  if (!origAcl || origAcl->getPriority() != priority) {
+    return nullptr;
+  }
+  return origAcl;
+}
+
 std::shared_ptr<AclEntry> ThriftConfigApplier::updateAcl(
     cfg::AclStage aclStage,
     const cfg::AclEntry& acl,
@@ -4318,9 +4622,11 @@ shared_ptr<SwitchState> applyThriftConfig(
     const cfg::SwitchConfig* config,
     const Platform* platform,
     RoutingInformationBase* rib,
-    AclNexthopHandler* aclNexthopHandler) {
+    AclNexthopHandler* aclNexthopHandler,
+    const cfg::SwitchConfig* prevConfig) {
   cfg::SwitchConfig emptyConfig;
-  return ThriftConfigApplier(state, config, platform, rib, aclNexthopHandler)
+  return ThriftConfigApplier(
+             state, config, platform, rib, aclNexthopHandler, prevConfig)
       .run();
 }
 shared_ptr<SwitchState> applyThriftConfig(
@@ -4328,10 +4634,16 @@ shared_ptr<SwitchState> applyThriftConfig(
     const cfg::SwitchConfig* config,
     const Platform* platform,
     RouteUpdateWrapper* routeUpdater,
-    AclNexthopHandler* aclNexthopHandler) {
+    AclNexthopHandler* aclNexthopHandler,
+    const cfg::SwitchConfig* prevConfig) {
   cfg::SwitchConfig emptyConfig;
   return ThriftConfigApplier(
-             state, config, platform, routeUpdater, aclNexthopHandler)
+             state,
+             config,
+             platform,
+             routeUpdater,
+             aclNexthopHandler,
+             prevConfig)
       .run();
 }
 
@@ -30,18 +30,24 @@ class AclNexthopHandler;
  *
  * Returns a new SwitchState object with the resulting state, or null if
  * the config file results in no changes.
+ *
+ * prevConfig, if given, must be the config that produced state. Config
+ * sections that are identical in prevConfig and config, and whose state only
+ * depends on those sections, are then not re-evaluated.
  */
 std::shared_ptr<SwitchState> applyThriftConfig(
     const std::shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
     const Platform* platform,
     RoutingInformationBase* rib = nullptr,
-    AclNexthopHandler* aclNexthopHandler = nullptr);
+    AclNexthopHandler* aclNexthopHandler = nullptr,
+    const cfg::SwitchConfig* prevConfig = nullptr);
 
 std::shared_ptr<SwitchState> applyThriftConfig(
     const std::shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
     const Platform* platform,
     RouteUpdateWrapper* routeUpdater,
-    AclNexthopHandler* aclNexthopHandler = nullptr);
+    AclNexthopHandler* aclNexthopHandler = nullptr,
+    const cfg::SwitchConfig* prevConfig = nullptr);
 } // namespace facebook::fboss
@@ -10,6 +10,8 @@
 #include "fboss/fsdb/common/Flags.h"
 #include "fboss/thrift_cow/nodes/Serializer.h"
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
 
 DEFINE_bool(dsf_subscriber_skip_hw_writes, false, "Skip writing to HW");
@@ -25,6 +27,229 @@ using ThriftMapTypeClass = apache::thrift::type_class::map<
     apache::thrift::type_class::structure>;
 using SysPortMapThriftType = std::map<int64_t, state::SystemPortFields>;
 using InterfaceMapThriftType = std::map<int32_t, state::InterfaceFields>;
+using PathIter = std::vector<std::string>::const_iterator;
+
+namespace {
+
+bool isPathPrefix(
+    const std::vector<std::string>& prefix,
+    const std::vector<std::string>& path) {
+  return prefix.size() <= path.size() &&
+      std::equal(prefix.begin(), prefix.end(), path.begin());
+}
+
+// Local neighbor entry on one DSF node is remote neighbor entry on
+// every other DSF node. Thus, for neighbor entry received from other
+// DSF nodes, set isLocal = False before programming it.
+template <typename NbrTableT>
+void makeRemoteNeighbors(const std::shared_ptr<NbrTableT>& nbrTable) {
+  for (const auto& nbrEntry : *nbrTable) {
+    nbrEntry.second->setIsLocal(false);
+  }
+}
+
+std::shared_ptr<SystemPort> makeRemote(
+    const std::shared_ptr<SystemPort>& sysPort,
+    PathIter /*begin*/,
+    PathIter /*end*/) {
+  return sysPort;
+}
+
+/*
+ * Fix up neighbors that were (re)written by a change to path [begin, end)
+ * within the rif. These have all been cloned or deserialized by the change,
+ * so are safe to modify in place.
+ */
+std::shared_ptr<Interface> makeRemote(
+    const std::shared_ptr<Interface>& rif,
+    PathIter begin,
+    PathIter end) {
+  if (begin == end) {
+    makeRemoteNeighbors(rif->getArpTable());
+    makeRemoteNeighbors(rif->getNdpTable());
+    return rif;
+  }
+  auto fixupTable = [&](const auto& nbrTable) {
+    if (std::next(begin) == end) {
+      makeRemoteNeighbors(nbrTable);
+    } else if (auto nbrEntry = nbrTable->getNodeIf(*std::next(begin))) {
+      nbrEntry->setIsLocal(false);
+    }
+  };
+  if (*begin == "arpTable") {
+    fixupTable(rif->getArpTable());
+  } else if (*begin == "ndpTable") {
+    fixupTable(rif->getNdpTable());
+  }
+  return rif;
+}
+
+/*
+ * Entries of a remote map as they were before a DSF node's deltas were
+ * applied, recorded the first time each key is touched. A node failing
+ * midway is rolled back by restoring just these, without copying the map.
+ */
+template <typename MapT>
+class RemoteEntriesUndo {
+ public:
+  void record(MapT* remoteMap, typename MapT::KeyType key) {
+    if (oldEntries_.find(key) != oldEntries_.end()) {
+      return;
+    }
+    auto oldEntry = remoteMap->getNodeIf(key);
+    if (oldEntry) {
+      // Entries written by other nodes earlier in the same update are
+      // still mutable, publish so that changes from here on copy them.
+      oldEntry->publish();
+    }
+    oldEntries_.emplace(key, std::move(oldEntry));
+  }
+
+  void rollback(MapT* remoteMap) const {
+    for (const auto& [key, oldEntry] : oldEntries_) {
+      remoteMap->removeNodeIf(key);
+      if (oldEntry) {
+        remoteMap->addNode(oldEntry);
+      }
+    }
+  }
+
+  bool empty() const {
+    return oldEntries_.empty();
+  }
+
+ private:
+  std::map<typename MapT::KeyType, std::shared_ptr<typename MapT::Node>>
+      oldEntries_;
+};
+
+/*
+ * Replace all entries learnt from a DSF node with newMap. Only entries
+ * whose contents changed are written to the remote map.
+ */
+template <typename DeltaT, typename MapT>
+bool applyFullMap(
+    const std::shared_ptr<MapT>& origMap,
+    const std::shared_ptr<MapT>& newMap,
+    MapT* remoteMap,
+    RemoteEntriesUndo<MapT>* undo) {
+  bool changed{false};
+  for (const auto& idAndNode : *newMap) {
+    makeRemote(idAndNode.second, PathIter(), PathIter());
+  }
+  DeltaT delta(origMap.get(), newMap.get());
+  DeltaFunctions::forEachChanged(
+      delta,
+      [&](const auto& oldNode, const auto& newNode) {
+        // Compare contents as we reconstructed map from deserialized FSDB
+        // state. So can't just rely on pointer comparison here.
+        if (*oldNode != *newNode) {
+          undo->record(remoteMap, newNode->getID());
+          remoteMap->updateNode(newNode);
+          changed = true;
+        }
+      },
+      [&](const auto& newNode) {
+        undo->record(remoteMap, newNode->getID());
+        remoteMap->addNode(newNode);
+        changed = true;
+      },
+      [&](const auto& rmNode) {
+        undo->record(remoteMap, rmNode->getID());
+        remoteMap->removeNode(rmNode);
+        changed = true;
+      });
+  return changed;
+}
+
+/*
+ * Apply a change to a single entry, or to a field nested anywhere within
+ * it, given the path [begin, end) starting at the entry key. Entries are
+ * modified copy-on-write, so only the nodes along the path get cloned.
+ */
+template <typename MapT>
+void applyEntryDelta(
+    MapT* remoteMap,
+    PathIter begin,
+    PathIter end,
+    const fsdb::OperDeltaUnit& unit,
+    fsdb::OperProtocol protocol,
+    RemoteEntriesUndo<MapT>* undo) {
+  using NodeT = typename MapT::Node;
+  auto key = folly::to<typename MapT::KeyType>(*begin);
+  undo->record(remoteMap, key);
+  auto oldNode = remoteMap->getNodeIf(key);
+  auto fieldBegin = std::next(begin);
+  if (fieldBegin == end) {
+    if (!unit.newState()) {
+      remoteMap->removeNodeIf(key);
+      return;
+    }
+    auto newNode = makeRemote(
+        std::make_shared<NodeT>(thrift_cow::deserialize<
+                                apache::thrift::type_class::structure,
+                                typename NodeT::ThriftType>(
+            protocol, *unit.newState())),
+        end,
+        end);
+    if (oldNode) {
+      remoteMap->updateNode(newNode);
+    } else {
+      remoteMap->addNode(newNode);
+    }
+    return;
+  }
+  if (!oldNode) {
+    throw FbossError(
+        "Got update for fields of unknown entry: ",
+        folly::join("/", begin, end));
+  }
+  std::shared_ptr<typename NodeT::Self> newNode = oldNode;
+  auto result = unit.newState()
+      ? NodeT::Self::modifyPath(&newNode, fieldBegin, end)
+      : NodeT::Self::removePath(&newNode, fieldBegin, end);
+  if (result == thrift_cow::ThriftTraverseResult::OK && unit.newState()) {
+    result = newNode->visitPath(fieldBegin, end, [&](auto& node) {
+      node.fromEncoded(protocol, *unit.newState());
+    });
+  }
+  if (result != thrift_cow::ThriftTraverseResult::OK) {
+    throw FbossError(
+        "Failed to apply update to: ", folly::join("/", begin, end));
+  }
+  remoteMap->updateNode(
+      makeRemote(std::static_pointer_cast<NodeT>(newNode), fieldBegin, end));
+}
+
+std::string getLoopbackIp(const std::shared_ptr<DsfNode>& node) {
+  auto network = folly::IPAddress::createNetwork(
+      (*node->getLoopbackIps()->cbegin())->toThrift(),
+      -1 /*default CIDR*/,
+      false /*apply mask*/);
+  return network.first.str();
+}
+
+fsdb::FsdbStreamClient::ServerOptions getServerOptions(
+    const std::shared_ptr<DsfNode>& node,
+    const std::shared_ptr<SwitchState>& state) {
+  auto mySwitchId = state->getSwitchSettings()->getSwitchId();
+  CHECK(mySwitchId) << " Dsf node config requires local switch ID to be set";
+  auto selfDsfNode = state->getDsfNodes()->getNodeIf(*mySwitchId);
+  CHECK(selfDsfNode);
+  CHECK(selfDsfNode->getLoopbackIpsSorted().size() != 0);
+
+  // Subscribe to FSDB of DSF node in the cluster with:
+  //  dstIP = inband IP of that DSF node
+  //  dstPort = FSDB port
+  //  srcIP = self inband IP
+  auto serverOptions = fsdb::FsdbStreamClient::ServerOptions(
+      getLoopbackIp(node),
+      FLAGS_fsdbPort,
+      (*selfDsfNode->getLoopbackIpsSorted().begin()).first.str());
+
+  return serverOptions;
+}
+} // namespace
 
 DsfSubscriber::DsfSubscriber(SwSwitch* sw) : sw_(sw) {
   sw_->registerStateObserver(this, "DSFSubscriber");
@@ -35,89 +260,55 @@ DsfSubscriber::~DsfSubscriber() {
 }
 
 void DsfSubscriber::scheduleUpdate(
-    const std::shared_ptr<SystemPortMap>& newSysPorts,
-    const std::shared_ptr<InterfaceMap>& newRifs,
     const std::string& nodeName,
-    SwitchID nodeSwitchId) {
+    SwitchID nodeSwitchId,
+    std::vector<fsdb::OperDelta>&& deltas) {
   XLOG(DBG2) << " For , switchId: " << static_cast<int64_t>(nodeSwitchId)
-             << " got,"
-             << " updated # of sys ports: "
-             << (newSysPorts ? newSysPorts->size() : 0)
-             << " updated # of rifs: " << (newRifs ? newRifs->size() : 0);
+             << " got " << deltas.size() << " deltas";
+  {
+    auto pendingUpdates = pendingUpdates_.wlock();
+    auto& nodeDeltas = pendingUpdates->nodeDeltas[nodeSwitchId];
+    nodeDeltas.nodeName = nodeName;
+    nodeDeltas.deltas.insert(
+        nodeDeltas.deltas.end(),
+        std::make_move_iterator(deltas.begin()),
+        std::make_move_iterator(deltas.end()));
+    if (pendingUpdates->updateScheduled) {
+      // Will be picked up by the already scheduled update
+      return;
+    }
+    pendingUpdates->updateScheduled = true;
+  }
   sw_->updateState(
-      folly::sformat("Update state for node: {}", nodeName),
-      [this, newSysPorts, newRifs, nodeSwitchId, nodeName](
-          const std::shared_ptr<SwitchState>& in) {
-        if (nodeSwitchId == SwitchID(*in->getSwitchSettings()->getSwitchId())) {
-          throw FbossError(
-              " Got updates for my switch ID, from: ",
-              nodeName,
-              " id: ",
-              nodeSwitchId);
+      "Update state for DSF nodes",
+      [this](const std::shared_ptr<SwitchState>& in) {
+        std::map<SwitchID, NodeDeltas> nodeDeltas;
+        {
+          auto pendingUpdates = pendingUpdates_.wlock();
+          nodeDeltas.swap(pendingUpdates->nodeDeltas);
+          pendingUpdates->updateScheduled = false;
         }
         bool changed{false};
         auto out = in->clone();
-
-        auto makeRemoteSysPort = [&](const auto& node) { return node; };
-        auto makeRemoteRif = [&](const auto& node) {
-          auto clonedNode = node->clone();
-
-          if (node->isPublished()) {
-            clonedNode->setArpTable(node->getArpTable()->toThrift());
-            clonedNode->setNdpTable(node->getNdpTable()->toThrift());
-          }
-
-          // Local neighbor entry on one DSF node is remote neighbor entry on
-          // every other DSF node. Thus, for neighbor entry received from other
-          // DSF nodes, set isLocal = False before programming it.
-          for (const auto& arpEntry : *clonedNode->getArpTable()) {
-            arpEntry.second->setIsLocal(false);
+        std::vector<SwitchID> failedNodes;
+        for (const auto& [nodeSwitchId, update] : nodeDeltas) {
+          if (nodeSwitchId ==
+              SwitchID(*in->getSwitchSettings()->getSwitchId())) {
+            XLOG(ERR) << " Got updates for my switch ID, from: "
+                      << update.nodeName << " id: " << nodeSwitchId;
+            continue;
           }
-          for (const auto& ndpEntry : *clonedNode->getNdpTable()) {
-            ndpEntry.second->setIsLocal(false);
+          try {
+            changed |= applyDeltas(
+                update.nodeName, nodeSwitchId, update.deltas, &out);
+          } catch (const std::exception& ex) {
+            XLOG(ERR) << " Failed to apply deltas from: " << update.nodeName
+                      << ", resyncing its full state: " << ex.what();
+            failedNodes.push_back(nodeSwitchId);
           }
-
-          return clonedNode;
-        };
-
-        auto processDelta =
-            [&](auto& delta, auto& mapToUpdate, auto& makeRemote) {
-              DeltaFunctions::forEachChanged(
-                  delta,
-                  [&](const auto& oldNode, const auto& newNode) {
-                    if (*oldNode != *newNode) {
-                      // Compare contents as we reconstructed
-                      // map from deserialized FSDB
-                      // subscriptions. So can't just rely on
-                      // pointer comparison here.
-                      auto clonedNode = makeRemote(newNode);
-                      mapToUpdate->updateNode(clonedNode);
-                      changed = true;
-                    }
-                  },
-                  [&](const auto& newNode) {
-                    auto clonedNode = makeRemote(newNode);
-                    mapToUpdate->addNode(clonedNode);
-                    changed = true;
-                  },
-                  [&](const auto& rmNode) {
-                    mapToUpdate->removeNode(rmNode);
-                    changed = true;
-                  });
-            };
-
-        if (newSysPorts) {
-          auto origSysPorts = out->getSystemPorts(nodeSwitchId);
-          thrift_cow::ThriftMapDelta<SystemPortMap> delta(
-              origSysPorts.get(), newSysPorts.get());
-          auto remoteSysPorts = out->getRemoteSystemPorts()->modify(&out);
-          processDelta(delta, remoteSysPorts, makeRemoteSysPort);
         }
-        if (newRifs) {
-          auto origRifs = out->getInterfaces(nodeSwitchId);
-          InterfaceMapDelta delta(origRifs.get(), newRifs.get());
-          auto remoteRifs = out->getRemoteInterfaces()->modify(&out);
-          processDelta(delta, remoteRifs, makeRemoteRif);
+        for (auto nodeSwitchId : failedNodes) {
+          resyncNode(nodeSwitchId, in);
         }
         if (FLAGS_dsf_subscriber_cache_updated_state) {
           cachedState_ = out;
@@ -129,6 +320,91 @@ void DsfSubscriber::scheduleUpdate(
       });
 }
 
+bool DsfSubscriber::applyDeltas(
+    const std::string& nodeName,
+    SwitchID nodeSwitchId,
+    const std::vector<fsdb::OperDelta>& deltas,
+    std::shared_ptr<SwitchState>* state) const {
+  auto& out = *state;
+  bool changed{false};
+  const auto sysPortsPath = getSystemPortsPath();
+  const auto rifsPath = getInterfacesPath();
+  RemoteEntriesUndo<SystemPortMap> sysPortsUndo;
+  RemoteEntriesUndo<InterfaceMap> rifsUndo;
+  try {
+    for (const auto& delta : deltas) {
+      auto protocol = *delta.protocol();
+      for (const auto& unit : *delta.changes()) {
+        const auto& path = *unit.path()->raw();
+        if (isPathPrefix(sysPortsPath, path)) {
+          auto remoteSysPorts = out->getRemoteSystemPorts()->modify(&out);
+          auto begin = path.begin() + sysPortsPath.size();
+          if (begin != path.end()) {
+            applyEntryDelta(
+                remoteSysPorts,
+                begin,
+                path.end(),
+                unit,
+                protocol,
+                &sysPortsUndo);
+            changed = true;
+            continue;
+          }
+          XLOG(DBG2) << " Got sys port update from : " << nodeName;
+          auto newSysPorts = std::make_shared<SystemPortMap>();
+          if (unit.newState()) {
+            newSysPorts->fromThrift(
+                thrift_cow::
+                    deserialize<ThriftMapTypeClass, SysPortMapThriftType>(
+                        protocol, *unit.newState()));
+          }
+          changed |= applyFullMap<thrift_cow::ThriftMapDelta<SystemPortMap>>(
+              out->getSystemPorts(nodeSwitchId),
+              newSysPorts,
+              remoteSysPorts,
+              &sysPortsUndo);
+        } else if (isPathPrefix(rifsPath, path)) {
+          auto remoteRifs = out->getRemoteInterfaces()->modify(&out);
+          auto begin = path.begin() + rifsPath.size();
+          if (begin != path.end()) {
+            applyEntryDelta(
+                remoteRifs, begin, path.end(), unit, protocol, &rifsUndo);
+            changed = true;
+            continue;
+          }
+          XLOG(DBG2) << " Got rif update from : " << nodeName;
+          auto newRifs = std::make_shared<InterfaceMap>();
+          if (unit.newState()) {
+            newRifs->fromThrift(
+                thrift_cow::
+                    deserialize<ThriftMapTypeClass, InterfaceMapThriftType>(
+                        protocol, *unit.newState()));
+          }
+          changed |= applyFullMap<InterfaceMapDelta>(
+              out->getInterfaces(nodeSwitchId), newRifs, remoteRifs, &rifsUndo);
+        } else {
+          throw FbossError(
+              " Got unexpected state update for : ",
+              folly::join("/", path),
+              " from node: ",
+              nodeName);
+        }
+      }
+    }
+  } catch (const std::exception&) {
+    // Undo whatever this node changed, leaving other nodes' changes in the
+    // same update in place.
+    if (!sysPortsUndo.empty()) {
+      sysPortsUndo.rollback(out->getRemoteSystemPorts()->modify(&out));
+    }
+    if (!rifsUndo.empty()) {
+      rifsUndo.rollback(out->getRemoteInterfaces()->modify(&out));
+    }
+    throw;
+  }
+  return changed;
+}
+
 void DsfSubscriber::stateUpdated(const StateDelta& stateDelta) {
   const auto& oldSwitchSettings = stateDelta.oldState()->getSwitchSettings();
   const auto& newSwitchSettings = stateDelta.newState()->getSwitchSettings();
@@ -155,81 +431,13 @@ void DsfSubscriber::stateUpdated(const StateDelta& stateDelta) {
   auto isInterfaceNode = [](const std::shared_ptr<DsfNode>& node) {
     return node->getType() == cfg::DsfNodeType::INTERFACE_NODE;
   };
-  auto getLoopbackIp = [](const std::shared_ptr<DsfNode>& node) {
-    auto network = folly::IPAddress::createNetwork(
-        (*node->getLoopbackIps()->cbegin())->toThrift(),
-        -1 /*default CIDR*/,
-        false /*apply mask*/);
-    return network.first.str();
-  };
-
-  auto getServerOptions = [mySwitchId, getLoopbackIp](
-                              const std::shared_ptr<DsfNode>& node,
-                              const auto& state) {
-    auto selfDsfNode = state->getDsfNodes()->getNodeIf(*mySwitchId);
-    CHECK(selfDsfNode);
-    CHECK(selfDsfNode->getLoopbackIpsSorted().size() != 0);
-
-    // Subscribe to FSDB of DSF node in the cluster with:
-    //  dstIP = inband IP of that DSF node
-    //  dstPort = FSDB port
-    //  srcIP = self inband IP
-    auto serverOptions = fsdb::FsdbStreamClient::ServerOptions(
-        getLoopbackIp(node),
-        FLAGS_fsdbPort,
-        (*selfDsfNode->getLoopbackIpsSorted().begin()).first.str());
-
-    return serverOptions;
-  };
-
   auto addDsfNode = [&](const std::shared_ptr<DsfNode>& node) {
     // No need to setup subscriptions to (local) yourself
     // Only IN nodes have control plane, so ignore non IN DSF nodes
     if (isLocal(node) || !isInterfaceNode(node)) {
       return;
     }
-    auto nodeName = node->getName();
-    auto nodeSwitchId = node->getSwitchId();
-    XLOG(DBG2) << " Setting up DSF subscriptions to : " << nodeName;
-    fsdbPubSubMgr_->addStatePathSubscription(
-        {getSystemPortsPath(), getInterfacesPath()},
-        [nodeName](auto /*oldState*/, auto newState) {
-          XLOG(DBG2) << (newState == fsdb::FsdbStreamClient::State::CONNECTED
-                             ? "Connected to:"
-                             : "Disconnected from: ")
-                     << nodeName;
-        },
-        [this, nodeName, nodeSwitchId](fsdb::OperSubPathUnit&& operStateUnit) {
-          std::shared_ptr<SystemPortMap> newSysPorts;
-          std::shared_ptr<InterfaceMap> newRifs;
-          for (const auto& change : *operStateUnit.changes()) {
-            if (change.path()->path() == getSystemPortsPath()) {
-              XLOG(DBG2) << " Got sys port update from : " << nodeName;
-              newSysPorts = std::make_shared<SystemPortMap>();
-              newSysPorts->fromThrift(
-                  thrift_cow::
-                      deserialize<ThriftMapTypeClass, SysPortMapThriftType>(
-                          fsdb::OperProtocol::BINARY,
-                          *change.state()->contents()));
-            } else if (change.path()->path() == getInterfacesPath()) {
-              XLOG(DBG2) << " Got rif update from : " << nodeName;
-              newRifs = std::make_shared<InterfaceMap>();
-              newRifs->fromThrift(
-                  thrift_cow::
-                      deserialize<ThriftMapTypeClass, InterfaceMapThriftType>(
-                          fsdb::OperProtocol::BINARY,
-                          *change.state()->contents()));
-            } else {
-              throw FbossError(
-                  " Got unexpected state update for : ",
-                  folly::join("/", *change.path()->path()),
-                  " from node: ",
-                  nodeName);
-            }
-          }
-          scheduleUpdate(newSysPorts, newRifs, nodeName, nodeSwitchId);
-        },
-        getServerOptions(node, stateDelta.newState()));
+    subscribeToNode(node, stateDelta.newState());
   };
   auto rmDsfNode = [&](const std::shared_ptr<DsfNode>& node) {
     // No need to setup subscriptions to (local) yourself
@@ -237,9 +445,7 @@ void DsfSubscriber::stateUpdated(const StateDelta& stateDelta) {
     if (isLocal(node) || !isInterfaceNode(node)) {
       return;
     }
-    XLOG(DBG2) << " Removing DSF subscriptions to : " << node->getName();
-    fsdbPubSubMgr_->removeStatePathSubscription(
-        {getSystemPortsPath(), getInterfacesPath()}, getLoopbackIp(node));
+    unsubscribeFromNode(node);
   };
   DeltaFunctions::forEachChanged(
       stateDelta.getDsfNodesDelta(),
@@ -251,6 +457,54 @@ void DsfSubscriber::stateUpdated(const StateDelta& stateDelta) {
       rmDsfNode);
 }
 
+void DsfSubscriber::subscribeToNode(
+    const std::shared_ptr<DsfNode>& node,
+    const std::shared_ptr<SwitchState>& state) {
+  auto nodeName = node->getName();
+  auto nodeSwitchId = node->getSwitchId();
+  XLOG(DBG2) << " Setting up DSF subscriptions to : " << nodeName;
+  fsdbPubSubMgr_->addStateDeltaSubscription(
+      {getSystemPortsPath(), getInterfacesPath()},
+      [nodeName](auto /*oldState*/, auto newState) {
+        XLOG(DBG2) << (newState == fsdb::FsdbStreamClient::State::CONNECTED
+                           ? "Connected to:"
+                           : "Disconnected from: ")
+                   << nodeName;
+      },
+      [this, nodeName, nodeSwitchId](fsdb::OperSubDeltaUnit&& operDeltaUnit) {
+        std::vector<fsdb::OperDelta> deltas;
+        for (auto& change : *operDeltaUnit.changes()) {
+          deltas.push_back(std::move(*change.delta()));
+        }
+        scheduleUpdate(nodeName, nodeSwitchId, std::move(deltas));
+      },
+      getServerOptions(node, state));
+}
+
+void DsfSubscriber::unsubscribeFromNode(const std::shared_ptr<DsfNode>& node) {
+  XLOG(DBG2) << " Removing DSF subscriptions to : " << node->getName();
+  fsdbPubSubMgr_->removeStateDeltaSubscription(
+      {getSystemPortsPath(), getInterfacesPath()}, getLoopbackIp(node));
+}
+
+void DsfSubscriber::resyncNode(
+    SwitchID nodeSwitchId,
+    const std::shared_ptr<SwitchState>& state) {
+  auto node = state->getDsfNodes()->getDsfNodeIf(nodeSwitchId);
+  if (!fsdbPubSubMgr_ || !node ||
+      node->getType() != cfg::DsfNodeType::INTERFACE_NODE) {
+    XLOG(ERR) << " Not subscribed to DSF node: " << nodeSwitchId
+              << ", cannot resync it";
+    return;
+  }
+  // Delta subscriptions never resend full state on their own, so start
+  // over with a new subscription, whose initial sync is the full state.
+  unsubscribeFromNode(node);
+  // Deltas queued from the old subscription are superseded by that sync
+  pendingUpdates_.wlock()->nodeDeltas.erase(nodeSwitchId);
+  subscribeToNode(node, state);
+}
+
 void DsfSubscriber::stop() {
   sw_->unregisterStateObserver(this);
   fsdbPubSubMgr_.reset();
@@ -3,18 +3,23 @@
 #pragma once
 
 #include "fboss/agent/StateObserver.h"
+#include "fboss/agent/types.h"
+#include "fboss/fsdb/if/gen-cpp2/fsdb_oper_types.h"
 
+#include <folly/Synchronized.h>
 #include <gtest/gtest.h>
+#include <map>
 #include <memory>
+#include <string>
+#include <vector>
 
 DECLARE_bool(dsf_subscriber_skip_hw_writes);
 DECLARE_bool(dsf_subscriber_cache_updated_state);
 
 namespace facebook::fboss {
+class DsfNode;
 class SwSwitch;
 class SwitchState;
-class InterfaceMap;
-class SystemPortMap;
 namespace fsdb {
 class FsdbPubSubManager;
 }
@@ -34,19 +39,56 @@ class DsfSubscriber : public StateObserver {
   }
 
  private:
+  /*
+   * Queue FSDB deltas received from a DSF node. Deltas queued from all
+   * nodes until the next state update runs are applied in that single
+   * update, so a burst of changes across the fabric costs one state
+   * update rather than one per node. Each node's deltas are applied on
+   * their own: if any of them fails, all of that node's changes in the
+   * update are rolled back and the node is resynced, see resyncNode().
+   */
   void scheduleUpdate(
-      const std::shared_ptr<SystemPortMap>& newSysPorts,
-      const std::shared_ptr<InterfaceMap>& newRifs,
       const std::string& nodeName,
-      SwitchID nodeSwitchId);
+      SwitchID nodeSwitchId,
+      std::vector<fsdb::OperDelta>&& deltas);
+  // Returns true if remote system ports or rifs changed. If a delta fails
+  // to apply, the entries changed by the node are restored and it throws.
+  bool applyDeltas(
+      const std::string& nodeName,
+      SwitchID nodeSwitchId,
+      const std::vector<fsdb::OperDelta>& deltas,
+      std::shared_ptr<SwitchState>* state) const;
+  void subscribeToNode(
+      const std::shared_ptr<DsfNode>& node,
+      const std::shared_ptr<SwitchState>& state);
+  void unsubscribeFromNode(const std::shared_ptr<DsfNode>& node);
+  /*
+   * Resubscribe to a node whose deltas failed to apply, dropping its queued
+   * deltas, so that FSDB sends its full state again.
+   */
+  void resyncNode(
+      SwitchID nodeSwitchId,
+      const std::shared_ptr<SwitchState>& state);
   // Paths
   static std::vector<std::string> getSystemPortsPath();
   static std::vector<std::string> getInterfacesPath();
   SwSwitch* sw_;
   std::unique_ptr<fsdb::FsdbPubSubManager> fsdbPubSubMgr_;
   std::shared_ptr<SwitchState> cachedState_;
+  struct NodeDeltas {
+    std::string nodeName;
+    std::vector<fsdb::OperDelta> deltas;
+  };
+  struct PendingUpdates {
+    std::map<SwitchID, NodeDeltas> nodeDeltas;
+    bool updateScheduled{false};
+  };
+  folly::Synchronized<PendingUpdates> pendingUpdates_;
   FRIEND_TEST(DsfSubscriberTest, scheduleUpdate);
   FRIEND_TEST(DsfSubscriberTest, setupNeighbors);
+  FRIEND_TEST(DsfSubscriberTest, deltaUpdates);
+  FRIEND_TEST(DsfSubscriberTest, multiNodeScale);
+  FRIEND_TEST(DsfSubscriberTest, failedNodeRolledBack);
 };
 
 } // namespace facebook::fboss
@@ -4,27 +4,96 @@
 
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/hw/switch_asics/HwAsic.h"
+#include "fboss/agent/state/DeltaFunctions.h"
 #include "fboss/agent/state/Interface.h"
+#include "fboss/agent/state/StateDelta.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/state/Vlan.h"
 
+#include <folly/lang/Bits.h>
+
+#include <algorithm>
+
 namespace facebook::fboss {
-class HwAsic;
-class SwitchState;
+
+namespace {
+constexpr size_t kBitsPerWord = 64;
+} // namespace
 
 int64_t EncapIndexAllocator::getNextAvailableEncapIdx(
     const std::shared_ptr<SwitchState>& state,
     const HwAsic& asic) {
+  auto baseState = syncedState_;
+  RefCountChanges changes;
+  auto rebuilt = syncImpl(state, asic, &changes);
+  auto idx = findFirstFree();
+  if (!state->isPublished()) {
+    // The caller may still modify an unpublished state in place, so it
+    // can't be the base for the next delta. Go back to the last published
+    // state, or rebuild on the next allocation if there is none.
+    if (rebuilt) {
+      syncedState_.reset();
+    } else {
+      for (auto itr = changes.rbegin(); itr != changes.rend(); ++itr) {
+        updateRefCount(itr->first, -itr->second);
+      }
+      syncedState_ = std::move(baseState);
+    }
+  }
+  if (!idx) {
+    throw FbossError(
+        "No more unallocated indices for: ", asic.getAsicTypeStr());
+  }
+  return *idx;
+}
+
+void EncapIndexAllocator::sync(
+    const std::shared_ptr<SwitchState>& state,
+    const HwAsic& asic) {
+  if (!state->isPublished()) {
+    throw FbossError("Encap indices can only be synced to a published state");
+  }
+  syncImpl(state, asic, nullptr);
+}
+
+bool EncapIndexAllocator::syncImpl(
+    const std::shared_ptr<SwitchState>& state,
+    const HwAsic& asic,
+    RefCountChanges* changes) {
   if (!asic.isSupported(HwAsic::Feature::RESERVED_ENCAP_INDEX_RANGE)) {
     throw FbossError(
         "Encap index allocation not supported on: ", asic.getAsicTypeStr());
   }
-  std::unordered_set<int64_t> allocatedIndices;
+  auto start = *asic.getReservedEncapIndexRange().minimum() +
+      kEncapIdxReservedForLoopbacks;
+  auto end = *asic.getReservedEncapIndexRange().maximum();
+  if (syncedState_ && start == rangeStart_ && end == rangeEnd_) {
+    if (state != syncedState_) {
+      processDelta(StateDelta(syncedState_, state), changes);
+      syncedState_ = state;
+    }
+    return false;
+  }
+  rangeStart_ = start;
+  rangeEnd_ = end;
+  rebuild(state);
+  syncedState_ = state;
+  return true;
+}
 
-  auto extractIndices = [&allocatedIndices](const auto& nbrTable) {
+void EncapIndexAllocator::rebuild(const std::shared_ptr<SwitchState>& state) {
+  refCounts_.clear();
+  allocated_.assign(
+      rangeEnd_ < rangeStart_
+          ? 0
+          : (rangeEnd_ - rangeStart_) / kBitsPerWord + 1,
+      0);
+  firstFreeWordHint_ = 0;
+
+  auto extractIndices = [this](const auto& nbrTable) {
     for (auto itr = nbrTable->cbegin(); itr != nbrTable->cend(); ++itr) {
       if (itr->second->getEncapIndex()) {
-        allocatedIndices.insert(*itr->second->getEncapIndex());
+        updateRefCount(*itr->second->getEncapIndex(), 1);
       }
     }
   };
@@ -42,14 +111,76 @@ int64_t EncapIndexAllocator::getNextAvailableEncapIdx(
         extractIndices(idAndIntf.second->getArpTable());
         extractIndices(idAndIntf.second->getNdpTable());
       });
-  auto start = *asic.getReservedEncapIndexRange().minimum() +
-      kEncapIdxReservedForLoopbacks;
-  while (start <= *asic.getReservedEncapIndexRange().maximum()) {
-    if (allocatedIndices.find(start) == allocatedIndices.end()) {
-      return start;
+}
+
+void EncapIndexAllocator::processDelta(
+    const StateDelta& delta,
+    RefCountChanges* changes) {
+  auto update = [this, changes](const auto& nbr, int change) {
+    if (nbr->getEncapIndex()) {
+      updateRefCount(*nbr->getEncapIndex(), change);
+      if (changes) {
+        changes->emplace_back(*nbr->getEncapIndex(), change);
+      }
+    }
+  };
+  auto processNbrDelta = [&update](const auto& nbrDelta) {
+    DeltaFunctions::forEachChanged(
+        nbrDelta,
+        [&](const auto& oldNbr, const auto& newNbr) {
+          update(oldNbr, -1);
+          update(newNbr, 1);
+        },
+        [&](const auto& newNbr) { update(newNbr, 1); },
+        [&](const auto& oldNbr) { update(oldNbr, -1); });
+  };
+  for (const auto& vlanDelta : delta.getVlansDelta()) {
+    processNbrDelta(vlanDelta.getArpDelta());
+    processNbrDelta(vlanDelta.getNdpDelta());
+  }
+  for (const auto& intfDelta : delta.getIntfsDelta()) {
+    processNbrDelta(intfDelta.getArpEntriesDelta());
+    processNbrDelta(intfDelta.getNdpEntriesDelta());
+  }
+}
+
+void EncapIndexAllocator::updateRefCount(int64_t idx, int change) {
+  auto inRange = idx >= rangeStart_ && idx <= rangeEnd_;
+  auto word = inRange ? (idx - rangeStart_) / kBitsPerWord : 0;
+  auto bit = inRange ? 1ULL << ((idx - rangeStart_) % kBitsPerWord) : 0;
+  if (change > 0) {
+    if (refCounts_[idx]++ == 0 && inRange) {
+      allocated_[word] |= bit;
+    }
+    return;
+  }
+  auto itr = refCounts_.find(idx);
+  if (itr == refCounts_.end()) {
+    return;
+  }
+  if (--itr->second == 0) {
+    refCounts_.erase(itr);
+    if (inRange) {
+      allocated_[word] &= ~bit;
+      firstFreeWordHint_ = std::min<size_t>(firstFreeWordHint_, word);
+    }
+  }
+}
+
+std::optional<int64_t> EncapIndexAllocator::findFirstFree() {
+  for (auto word = firstFreeWordHint_; word < allocated_.size(); ++word) {
+    if (~allocated_[word]) {
+      firstFreeWordHint_ = word;
+      auto offset =
+          word * kBitsPerWord + folly::findFirstSet(~allocated_[word]) - 1;
+      auto idx = rangeStart_ + static_cast<int64_t>(offset);
+      if (idx > rangeEnd_) {
+        break;
+      }
+      return idx;
     }
-    start++;
   }
-  throw FbossError("No more unallocated indices for: ", asic.getAsicTypeStr());
+  firstFreeWordHint_ = allocated_.size();
+  return std::nullopt;
 }
 } // namespace facebook::fboss
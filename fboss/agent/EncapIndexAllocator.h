@@ -2,17 +2,66 @@
 
 #pragma once
 
+#include <folly/container/F14Map.h>
+
 #include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
 
 namespace facebook::fboss {
 class HwAsic;
+class StateDelta;
 class SwitchState;
 
+/*
+ * Allocates neighbor encap indices out of the ASIC reserved range.
+ *
+ * Indices in use are tracked in a bitmap that is kept in sync with the
+ * neighbor tables of the last published state seen, by applying the
+ * StateDelta from it. An allocation thus only looks at neighbor tables
+ * that changed since the previous one, instead of every neighbor in the
+ * switch state. The bitmap is built from scratch on first use (e.g. from
+ * the warm boot state) or if the reserved range changes.
+ *
+ * Not thread safe, meant to be used from the state update thread.
+ */
 class EncapIndexAllocator {
  public:
   static constexpr int kEncapIdxReservedForLoopbacks = 100;
-  static int64_t getNextAvailableEncapIdx(
+
+  // Lowest index in the reserved range not used by any neighbor in state
+  int64_t getNextAvailableEncapIdx(
       const std::shared_ptr<SwitchState>& state,
       const HwAsic& asic);
+
+  /*
+   * Syncs allocated indices with a published state, so that allocations
+   * for states derived from it only need to process the changes.
+   */
+  void sync(const std::shared_ptr<SwitchState>& state, const HwAsic& asic);
+
+ private:
+  using RefCountChanges = std::vector<std::pair<int64_t, int>>;
+
+  // Returns true if indices had to be rebuilt from scratch
+  bool syncImpl(
+      const std::shared_ptr<SwitchState>& state,
+      const HwAsic& asic,
+      RefCountChanges* changes);
+  void rebuild(const std::shared_ptr<SwitchState>& state);
+  void processDelta(const StateDelta& delta, RefCountChanges* changes);
+  void updateRefCount(int64_t idx, int change);
+  std::optional<int64_t> findFirstFree();
+
+  int64_t rangeStart_{0};
+  int64_t rangeEnd_{-1};
+  std::shared_ptr<SwitchState> syncedState_;
+  // Neighbors using each index, entries may transiently share one
+  folly::F14FastMap<int64_t, uint32_t> refCounts_;
+  // Bit per index in [rangeStart_, rangeEnd_], set if in use
+  std::vector<uint64_t> allocated_;
+  // No free index in the words before this one
+  size_t firstFreeWordHint_{0};
 };
 } // namespace facebook::fboss
@@ -59,12 +59,20 @@ void HwSwitch::switchRunStateChanged(SwitchRunState newState) {
   }
 }
 
-void HwSwitch::updateStats(SwitchStats* switchStats) {
+void HwSwitch::updateStats(SwitchStats* switchStats, bool updateSnapshot) {
   updateStatsImpl(switchStats);
+  auto portStats = getPortStats();
   // send to normalizer
   auto normalizer = Normalizer::getInstance();
   if (normalizer) {
-    normalizer->processStats(getPortStats());
+    normalizer->processStats(portStats);
+  }
+  if (updateSnapshot) {
+    auto snapshot = std::make_shared<HwStatsSnapshot>();
+    snapshot->version = getStatsSnapshot()->version + 1;
+    snapshot->portStats = std::move(portStats);
+    snapshot->sysPortStats = getSysPortStats();
+    *statsSnapshot_.wlock() = std::move(snapshot);
   }
 }
 
@@ -20,6 +20,7 @@
 #include "fboss/agent/types.h"
 
 #include <folly/IPAddress.h>
+#include <folly/Synchronized.h>
 #include <folly/ThreadLocal.h>
 #include <optional>
 
@@ -61,6 +62,17 @@ void checkUnsupportedDelta(const Delta& delta, Mgr& mgr) {
       [&](const auto& oldNode) { mgr.processRemoved(oldNode); });
 }
 
+/*
+ * Hardware stats gathered by a HwSwitch::updateStats() pass that updates the
+ * snapshot.
+ */
+struct HwStatsSnapshot {
+  // Incremented on every snapshot update, 0 before the first one
+  uint64_t version{0};
+  folly::F14FastMap<std::string, HwPortStats> portStats;
+  std::map<std::string, HwSysPortStats> sysPortStats;
+};
+
 /*
  * HwSwitch contains the hardware-specific switching logic.
  *
@@ -137,7 +149,8 @@ class HwSwitch {
       uint32_t featuresDesired =
           (FeaturesDesired::PACKET_RX_DESIRED |
            FeaturesDesired::LINKSCAN_DESIRED))
-      : featuresDesired_(featuresDesired) {}
+      : featuresDesired_(featuresDesired),
+        statsSnapshot_(std::make_shared<const HwStatsSnapshot>()) {}
   virtual ~HwSwitch() {}
 
   virtual Platform* getPlatform() const = 0;
@@ -254,11 +267,28 @@ class HwSwitch {
 
   /*
    * Allows hardware-specific code to record switch statistics.
+   *
+   * updateSnapshot also publishes the port and system port stats of this
+   * pass as a new stats snapshot, callers that will not read it can skip
+   * gathering them.
    */
-  void updateStats(SwitchStats* switchStats);
+  void updateStats(SwitchStats* switchStats, bool updateSnapshot = true);
 
   virtual folly::F14FastMap<std::string, HwPortStats> getPortStats() const = 0;
 
+  /*
+   * Stats collected by the last updateStats() pass that updated the
+   * snapshot.
+   *
+   * A new immutable snapshot is published once per pass and shared by all
+   * readers, instead of every consumer copying the stats out of the
+   * hardware layer again.  Readers keep the snapshot they got for as long
+   * as they hold on to it.
+   */
+  std::shared_ptr<const HwStatsSnapshot> getStatsSnapshot() const {
+    return *statsSnapshot_.rlock();
+  }
+
   virtual void fetchL2Table(std::vector<L2EntryThrift>* l2Table) const = 0;
 
   virtual std::map<PortID, phy::PhyInfo> updateAllPhyInfo() = 0;
@@ -414,6 +444,7 @@ class HwSwitch {
   mutable folly::ThreadLocalPtr<HwSwitchStats> hwSwitchStats_;
   cfg::SwitchType switchType_{cfg::SwitchType::NPU};
   std::optional<int64_t> switchId_;
+  folly::Synchronized<std::shared_ptr<const HwStatsSnapshot>> statsSnapshot_;
 };
 
 } // namespace facebook::fboss
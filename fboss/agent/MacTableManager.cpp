@@ -12,8 +12,11 @@
 #include "fboss/agent/L2Entry.h"
 #include "fboss/agent/MacTableUtils.h"
 #include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/state/SwitchState.h"
 
+#include <folly/logging/xlog.h>
+
 namespace facebook::fboss {
 
 MacTableManager::MacTableManager(SwSwitch* sw) : sw_(sw) {}
@@ -21,14 +24,70 @@ MacTableManager::MacTableManager(SwSwitch* sw) : sw_(sw) {}
 void MacTableManager::handleL2LearningUpdate(
     L2Entry l2Entry,
     L2EntryUpdateType l2EntryUpdateType) {
-  auto updateMacTableFn =
-      [l2Entry, l2EntryUpdateType](const std::shared_ptr<SwitchState>& state) {
-        return MacTableUtils::updateMacTable(state, l2Entry, l2EntryUpdateType);
-      };
+  sw_->stats()->l2LearningEvent();
+  {
+    auto pendingBatches = pendingBatches_.lock();
+    auto key = std::make_pair(l2Entry.getVlanID(), l2Entry.getMac());
+    bool newBatch = pendingBatches->empty();
+    if (!newBatch) {
+      const auto& openBatch = pendingBatches->back();
+      auto idx = openBatch.updateIdx.find(key);
+      if (idx != openBatch.updateIdx.end()) {
+        const auto& [queuedEntry, queuedUpdateType] =
+            openBatch.updates[idx->second];
+        if (queuedUpdateType == l2EntryUpdateType &&
+            queuedEntry.getPort() == l2Entry.getPort() &&
+            queuedEntry.getClassID() == l2Entry.getClassID()) {
+          // same event is already queued for this MAC
+          sw_->stats()->l2LearningEventDeduped();
+          return;
+        }
+        newBatch = true;
+      }
+    }
+    if (!newBatch) {
+      auto& openBatch = pendingBatches->back();
+      openBatch.updateIdx[key] = openBatch.updates.size();
+      openBatch.updates.emplace_back(std::move(l2Entry), l2EntryUpdateType);
+      return;
+    }
+    auto& openBatch = pendingBatches->emplace_back();
+    openBatch.updateIdx[key] = 0;
+    openBatch.updates.emplace_back(std::move(l2Entry), l2EntryUpdateType);
+  }
+
+  // State updates run in the order they are scheduled, so each one applies
+  // the oldest pending batch.
+  auto updateMacTableFn = [this](const std::shared_ptr<SwitchState>& state) {
+    std::vector<std::pair<L2Entry, L2EntryUpdateType>> updates;
+    {
+      auto pendingBatches = pendingBatches_.lock();
+      CHECK(!pendingBatches->empty());
+      updates = std::move(pendingBatches->front().updates);
+      pendingBatches->pop_front();
+    }
+    sw_->stats()->l2LearningBatch(updates.size());
+    return applyL2LearningUpdates(state, updates);
+  };
 
   sw_->updateStateNoCoalescing(
-      folly::to<std::string>("Programming : ", l2Entry.str()),
-      std::move(updateMacTableFn));
+      "Programming L2 learning updates", std::move(updateMacTableFn));
+}
+
+std::shared_ptr<SwitchState> MacTableManager::applyL2LearningUpdates(
+    const std::shared_ptr<SwitchState>& state,
+    const std::vector<std::pair<L2Entry, L2EntryUpdateType>>& updates) {
+  // MacTableUtils::updateMacTable only clones the VLAN and its MacTable the
+  // first time it modifies them, subsequent updates in the batch modify the
+  // same unpublished copies.
+  auto newState = state;
+  for (const auto& [l2Entry, l2EntryUpdateType] : updates) {
+    XLOG(DBG2) << "Programming : " << l2Entry.str() << " "
+               << l2EntryUpdateTypeStr(l2EntryUpdateType);
+    newState =
+        MacTableUtils::updateMacTable(newState, l2Entry, l2EntryUpdateType);
+  }
+  return newState;
 }
 
 } // namespace facebook::fboss
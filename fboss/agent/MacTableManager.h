@@ -11,10 +11,31 @@
 
 #include "fboss/agent/L2Entry.h"
 
+#include <folly/Synchronized.h>
+
+#include <deque>
+#include <map>
+#include <mutex>
+#include <vector>
+
 namespace facebook::fboss {
 
 class SwSwitch;
+class SwitchState;
 
+/*
+ * L2 learning events are not applied one state update each. Events received
+ * while a learning update is queued on the update thread are appended to the
+ * open batch, and the whole batch is applied in one state update (one
+ * MacTable copy per VLAN) once the update thread gets to it.
+ *
+ * A batch holds at most one event per MAC. An event identical to the one
+ * already queued for that MAC (e.g. repeated learns on the same port) is
+ * dropped. Any other event for that MAC (learn after age, MAC move) closes
+ * the batch and opens a new one, so that e.g. an age followed by a learn is
+ * still seen as a remove followed by an add. SW learning relies on that to
+ * move an entry out of the pending state.
+ */
 class MacTableManager {
  public:
   explicit MacTableManager(SwSwitch* sw);
@@ -23,12 +44,25 @@ class MacTableManager {
       L2Entry l2Entry,
       L2EntryUpdateType l2EntryUpdateType);
 
+  static std::shared_ptr<SwitchState> applyL2LearningUpdates(
+      const std::shared_ptr<SwitchState>& state,
+      const std::vector<std::pair<L2Entry, L2EntryUpdateType>>& updates);
+
  private:
+  struct L2UpdateBatch {
+    std::vector<std::pair<L2Entry, L2EntryUpdateType>> updates;
+    // index in updates of the event queued for a MAC
+    std::map<std::pair<VlanID, folly::MacAddress>, size_t> updateIdx;
+  };
+
   // Forbidden copy constructor and assignment operator
   MacTableManager(MacTableManager const&) = delete;
   MacTableManager& operator=(MacTableManager const&) = delete;
 
   SwSwitch* sw_{nullptr};
+  // Batches waiting for their state update to run, the last one is open for
+  // new events. Each batch has exactly one state update scheduled.
+  folly::Synchronized<std::deque<L2UpdateBatch>, std::mutex> pendingBatches_;
 };
 
 } // namespace facebook::fboss
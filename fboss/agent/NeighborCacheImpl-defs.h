@@ -107,7 +107,8 @@ NeighborCacheImpl<NTable>::getUpdateFnToProgramEntryForNpu(Entry* entry) {
     auto asic = sw_->getPlatform()->getAsic();
     if (asic->isSupported(HwAsic::Feature::RESERVED_ENCAP_INDEX_RANGE)) {
       fields.encapIndex =
-          EncapIndexAllocator::getNextAvailableEncapIdx(state, *asic);
+          sw_->getEncapIndexAllocator()->getNextAvailableEncapIdx(
+              state, *asic);
     }
 
     if (!node) {
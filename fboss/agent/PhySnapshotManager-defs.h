@@ -20,7 +20,7 @@ void PhySnapshotManager<intervalSeconds>::updatePhyInfoLocked(
       portID, std::set<std::string>({phyInfo.get_name()}));
   auto iter = result.first;
   auto& value = iter->second;
-  value.addSnapshot(snapshot);
+  value.addSnapshot(std::move(snapshot));
 }
 
 template <size_t intervalSeconds>
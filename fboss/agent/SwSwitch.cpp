@@ -14,6 +14,7 @@
 #include "fboss/agent/ApplyThriftConfig.h"
 #include "fboss/agent/ArpHandler.h"
 #include "fboss/agent/Constants.h"
+#include "fboss/agent/EncapIndexAllocator.h"
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/FbossHwUpdateError.h"
 #include "fboss/agent/FibHelpers.h"
@@ -76,6 +77,7 @@
 #include "fboss/lib/phy/gen-cpp2/phy_types.h"
 #include "fboss/qsfp_service/lib/QsfpCache.h"
 
+#include <fb303/ExportedStatMapImpl.h>
 #include <fb303/ServiceData.h>
 #include <folly/Demangle.h>
 #include <folly/FileUtil.h>
@@ -218,7 +220,9 @@ SwSwitch::SwSwitch(std::unique_ptr<Platform> platform)
           new PhySnapshotManager<kIphySnapshotIntervalSeconds>()),
       aclNexthopHandler_(new AclNexthopHandler(this)),
       teFlowNextHopHandler_(new TeFlowNexthopHandler(this)),
-      dsfSubscriber_(new DsfSubscriber(this)) {
+      dsfSubscriber_(new DsfSubscriber(this)),
+      encapIndexAllocator_(new EncapIndexAllocator()),
+      teFlowStatsCache_(std::make_unique<TeFlowStatsCache>()) {
   // Create the platform-specific state directories if they
   // don't exist already.
   utilCreateDir(platform_->getVolatileStateDir());
@@ -453,25 +457,33 @@ void SwSwitch::updateLldpStats() {
 }
 
 void SwSwitch::updateStats() {
+  auto now = std::chrono::steady_clock::now();
+  bool publishToFsdb = FLAGS_publish_stats_to_fsdb &&
+      (!publishedStatsToFsdbAt_ ||
+       std::chrono::duration_cast<std::chrono::seconds>(
+           now - *publishedStatsToFsdbAt_)
+               .count() > FLAGS_fsdbStatsStreamIntervalSeconds);
   SCOPE_EXIT {
-    if (FLAGS_publish_stats_to_fsdb) {
-      auto now = std::chrono::steady_clock::now();
-      if (!publishedStatsToFsdbAt_ ||
-          std::chrono::duration_cast<std::chrono::seconds>(
-              now - *publishedStatsToFsdbAt_)
-                  .count() > FLAGS_fsdbStatsStreamIntervalSeconds) {
-        AgentStats agentStats;
-        agentStats.hwPortStats() = getHw()->getPortStats();
-        agentStats.sysPortStats() = getHw()->getSysPortStats();
-
-        agentStats.hwAsicErrors() =
-            getHw()->getSwitchStats()->getHwAsicErrors();
-        agentStats.teFlowStats() = getTeFlowStats();
-        stats()->fillAgentStats(agentStats);
-        agentStats.bufferPoolStats() = getBufferPoolStats();
-        fsdbSyncer_->statsUpdated(std::move(agentStats));
-        publishedStatsToFsdbAt_ = now;
+    if (publishToFsdb) {
+      if (!fsdbAgentStats_) {
+        fsdbAgentStats_ = std::make_unique<AgentStats>();
       }
+      auto& agentStats = *fsdbAgentStats_;
+      auto hwStats = getHw()->getStatsSnapshot();
+      // Port stats are only copied again once the hw stats pass produced
+      // new ones, otherwise the ones last published are sent again.
+      if (hwStats->version != publishedHwStatsVersion_) {
+        agentStats.hwPortStats() = hwStats->portStats;
+        agentStats.sysPortStats() = hwStats->sysPortStats;
+        publishedHwStatsVersion_ = hwStats->version;
+      }
+
+      agentStats.hwAsicErrors() = getHw()->getSwitchStats()->getHwAsicErrors();
+      agentStats.teFlowStats() = getTeFlowStats();
+      stats()->fillAgentStats(agentStats);
+      agentStats.bufferPoolStats() = getBufferPoolStats();
+      fsdbSyncer_->statsUpdated(agentStats);
+      publishedStatsToFsdbAt_ = now;
     }
   };
   updateRouteStats();
@@ -479,16 +491,16 @@ void SwSwitch::updateStats() {
   updateLldpStats();
   updateTeFlowStats();
   try {
-    getHw()->updateStats(stats());
+    getHw()->updateStats(stats(), publishToFsdb);
   } catch (const std::exception& ex) {
     stats()->updateStatsException();
     XLOG(ERR) << "Error running updateStats: " << folly::exceptionStr(ex);
   }
   // Determine if collect phy info
-  auto now =
+  auto phyInfoNow =
       std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-  if (now - phyInfoUpdateTime_ >= FLAGS_update_phy_info_interval_s) {
-    phyInfoUpdateTime_ = now;
+  if (phyInfoNow - phyInfoUpdateTime_ >= FLAGS_update_phy_info_interval_s) {
+    phyInfoUpdateTime_ = phyInfoNow;
     try {
       phySnapshotManager_->updatePhyInfos(getHw()->updateAllPhyInfo());
     } catch (const std::exception& ex) {
@@ -498,25 +510,45 @@ void SwSwitch::updateStats() {
   }
 }
 
+struct SwSwitch::TeFlowStatsCache {
+  std::mutex lock;
+  // TE flow table the stats were looked up for
+  std::shared_ptr<TeFlowTable> teFlowTable;
+  // Counter ID and the fb303 stat holding its byte count
+  std::vector<std::pair<std::string, fb303::ExportedStatMapImpl::StatPtr>>
+      stats;
+};
+
 TeFlowStats SwSwitch::getTeFlowStats() {
   TeFlowStats teFlowStats;
   std::map<std::string, HwTeFlowStats> hwTeFlowStats;
-  auto statMap = facebook::fb303::fbData->getStatMap();
-  for (const auto& [flowStr, flowEntry] :
-       std::as_const(*getState()->getTeFlowTable())) {
-    std::ignore = flowStr;
-    if (const auto& counter = flowEntry->getCounterID()) {
-      auto statName = folly::to<std::string>(counter->toThrift(), ".bytes");
-      // returns default stat if statName does not exists
-      auto statPtr = statMap->getStatPtrNoExport(statName);
-      auto lockedStatPtr = statPtr->lock();
-      auto numLevels = lockedStatPtr->numLevels();
-      // Cumulative (ALLTIME) counters are at (numLevels - 1)
-      HwTeFlowStats flowStat;
-      flowStat.bytes() = lockedStatPtr->sum(numLevels - 1);
-      hwTeFlowStats.emplace(counter->toThrift(), std::move(flowStat));
+  std::lock_guard<std::mutex> g(teFlowStatsCache_->lock);
+  auto& cache = *teFlowStatsCache_;
+  auto teFlowTable = getState()->getTeFlowTable();
+  if (cache.teFlowTable != teFlowTable) {
+    // Counter IDs only change along with the TE flow table, so the stats
+    // are only looked up by name again when it does.
+    cache.teFlowTable = teFlowTable;
+    cache.stats.clear();
+    auto statMap = facebook::fb303::fbData->getStatMap();
+    for (const auto& [flowStr, flowEntry] : std::as_const(*teFlowTable)) {
+      std::ignore = flowStr;
+      if (const auto& counter = flowEntry->getCounterID()) {
+        auto statName = folly::to<std::string>(counter->toThrift(), ".bytes");
+        // returns default stat if statName does not exists
+        cache.stats.emplace_back(
+            counter->toThrift(), statMap->getStatPtrNoExport(statName));
+      }
     }
   }
+  for (const auto& [counterID, statPtr] : cache.stats) {
+    auto lockedStatPtr = statPtr->lock();
+    auto numLevels = lockedStatPtr->numLevels();
+    // Cumulative (ALLTIME) counters are at (numLevels - 1)
+    HwTeFlowStats flowStat;
+    flowStat.bytes() = lockedStatPtr->sum(numLevels - 1);
+    hwTeFlowStats.emplace(counterID, std::move(flowStat));
+  }
   auto now = duration_cast<seconds>(system_clock::now().time_since_epoch());
   teFlowStats.timestamp() = now.count();
   teFlowStats.hwTeFlowStats() = std::move(hwTeFlowStats);
@@ -1831,18 +1863,24 @@ void SwSwitch::applyConfig(
           XLOG(WARN) << "Current platform doesn't have QsfpCache. "
                      << "No need to build TransceiverMap";
         }
+        // Only skip unchanged config sections once state is known to have
+        // been built from oldConfig (e.g. not on the first apply after
+        // warmboot).
+        auto prevConfig = curConfigStr_.empty() ? nullptr : &oldConfig;
         auto newState = rib_ ? applyThriftConfig(
                                    originalState,
                                    &newConfig,
                                    getPlatform(),
                                    &routeUpdater,
-                                   aclNexthopHandler_.get())
+                                   aclNexthopHandler_.get(),
+                                   prevConfig)
                              : applyThriftConfig(
                                    originalState,
                                    &newConfig,
                                    getPlatform(),
                                    (RoutingInformationBase*)nullptr,
-                                   aclNexthopHandler_.get());
+                                   aclNexthopHandler_.get(),
+                                   prevConfig);
 
         if (newState && !isValidStateUpdate(StateDelta(state, newState))) {
           throw FbossError("Invalid config passed in, skipping");
@@ -40,6 +40,7 @@
 
 namespace facebook::fboss {
 
+class AgentStats;
 class ArpHandler;
 class InterfaceStats;
 class IPv4Handler;
@@ -79,6 +80,7 @@ class Interface;
 class FsdbSyncer;
 class TeFlowNexthopHandler;
 class DsfSubscriber;
+class EncapIndexAllocator;
 
 enum class SwitchFlags : int {
   DEFAULT = 0,
@@ -650,6 +652,10 @@ class SwSwitch : public HwSwitch::Callback {
     return lookupClassRouteUpdater_.get();
   }
 
+  EncapIndexAllocator* getEncapIndexAllocator() {
+    return encapIndexAllocator_.get();
+  }
+
   /*
    * RIB and switch state need to be kept in sync,
    * so only expose const/non write access to rib
@@ -1010,10 +1016,20 @@ class SwSwitch : public HwSwitch::Callback {
   std::unique_ptr<FsdbSyncer> fsdbSyncer_;
   std::unique_ptr<TeFlowNexthopHandler> teFlowNextHopHandler_;
   std::unique_ptr<DsfSubscriber> dsfSubscriber_;
+  std::unique_ptr<EncapIndexAllocator> encapIndexAllocator_;
 
   folly::Synchronized<ConfigAppliedInfo> configAppliedInfo_;
   std::optional<std::chrono::time_point<std::chrono::steady_clock>>
       publishedStatsToFsdbAt_;
+  // Version of the HwStatsSnapshot last published to FSDB
+  uint64_t publishedHwStatsVersion_{0};
+  // Stats last published to FSDB, port stats are kept until the
+  // HwStatsSnapshot advances
+  std::unique_ptr<AgentStats> fsdbAgentStats_;
+
+  // fb303 stats backing the TE flow counters, see getTeFlowStats()
+  struct TeFlowStatsCache;
+  std::unique_ptr<TeFlowStatsCache> teFlowStatsCache_;
 };
 
 } // namespace facebook::fboss
@@ -175,6 +175,26 @@ SwitchStats::SwitchStats(ThreadLocalStatsMap* map)
           50,
           100),
       linkStateChange_(map, kCounterPrefix + "link_state.flap", SUM),
+      l2LearningEvents_(map, kCounterPrefix + "l2_learning.events", SUM, RATE),
+      l2LearningEventsDeduped_(
+          map,
+          kCounterPrefix + "l2_learning.events_deduped",
+          SUM,
+          RATE),
+      l2LearningBatches_(
+          map,
+          kCounterPrefix + "l2_learning.batches",
+          SUM,
+          RATE),
+      l2LearningBatchSize_(
+          map,
+          kCounterPrefix + "l2_learning.batch_size",
+          100,
+          0,
+          10000,
+          AVG,
+          50,
+          100),
       pcapDistFailure_(map, kCounterPrefix + "pcap_dist_failure.error"),
       updateStatsExceptions_(
           map,
@@ -302,6 +302,19 @@ class SwitchStats : public boost::noncopyable {
     linkStateChange_.addValue(1);
   }
 
+  void l2LearningEvent() {
+    l2LearningEvents_.addValue(1);
+  }
+
+  void l2LearningEventDeduped() {
+    l2LearningEventsDeduped_.addValue(1);
+  }
+
+  void l2LearningBatch(uint64_t events) {
+    l2LearningBatches_.addValue(1);
+    l2LearningBatchSize_.addValue(events);
+  }
+
   void pcapDistFailure() {
     pcapDistFailure_.incrementValue(1);
   }
@@ -539,6 +552,16 @@ class SwitchStats : public boost::noncopyable {
 
   InterfaceStatsMap intfIDToStats_;
 
+  // Number of L2 learn/age events received from the HwSwitch
+  TLTimeseries l2LearningEvents_;
+  // Number of L2 learning events dropped since an identical event for the
+  // same MAC was already queued
+  TLTimeseries l2LearningEventsDeduped_;
+  // Number of state updates applying L2 learning events
+  TLTimeseries l2LearningBatches_;
+  // Number of L2 learning events applied per state update
+  TLHistogram l2LearningBatchSize_;
+
   // Number of packets dropped by the PCAP distribution service
   TLCounter pcapDistFailure_;
 
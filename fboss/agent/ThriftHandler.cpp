@@ -1861,7 +1861,11 @@ void ThriftHandler::startPktCapture(unique_ptr<CaptureInfo> info) {
   ensureConfigured(__func__);
   auto* mgr = sw_->getCaptureMgr();
   auto capture = make_unique<PktCapture>(
-      *info->name(), *info->maxPackets(), *info->direction(), *info->filter());
+      *info->name(),
+      *info->maxPackets(),
+      *info->direction(),
+      *info->filter(),
+      info->snaplen().value_or(0));
   mgr->startCapture(std::move(capture));
 }
 
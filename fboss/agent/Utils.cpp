@@ -19,17 +19,21 @@
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/state/Vlan.h"
 
+#include <folly/ExceptionString.h>
 #include <folly/FileUtil.h>
 #include <folly/Subprocess.h>
 #include <folly/dynamic.h>
+#include <folly/experimental/bser/Bser.h>
 #include <folly/json.h>
 #include <folly/logging/xlog.h>
+#include <folly/system/MemoryMapping.h>
 
 #include <boost/filesystem/operations.hpp>
 #include <thrift/lib/cpp/util/EnumUtils.h>
 
 #include <re2/re2.h>
 #include <chrono>
+#include <cstring>
 #include <iostream>
 
 using folly::IPAddressV4;
@@ -175,6 +179,55 @@ bool dumpStateToFile(const std::string& filename, const folly::dynamic& json) {
   return folly::writeFile(folly::toPrettyJson(json), filename.c_str());
 }
 
+namespace {
+// Binary state file header: magic followed by a little endian version
+constexpr folly::StringPiece kBinaryStateMagic{"FBWB"};
+constexpr uint32_t kBinaryStateVersion = 1;
+constexpr size_t kBinaryStateHeaderSize =
+    kBinaryStateMagic.size() + sizeof(uint32_t);
+} // namespace
+
+bool dumpBinaryStateToFile(
+    const std::string& filename,
+    const folly::dynamic& state) {
+  std::string out(kBinaryStateMagic.begin(), kBinaryStateMagic.end());
+  auto version = folly::Endian::little(kBinaryStateVersion);
+  out.append(reinterpret_cast<const char*>(&version), sizeof(version));
+  auto bser = folly::bser::toBser(state, folly::bser::serialization_opts());
+  out.append(bser.data(), bser.size());
+  return folly::writeFile(out, filename.c_str());
+}
+
+std::optional<folly::dynamic> readBinaryStateFromFile(
+    const std::string& filename) {
+  if (!boost::filesystem::exists(filename)) {
+    return std::nullopt;
+  }
+  try {
+    folly::MemoryMapping mapping(filename.c_str());
+    auto data = mapping.range();
+    if (data.size() < kBinaryStateHeaderSize ||
+        std::memcmp(
+            data.data(), kBinaryStateMagic.data(), kBinaryStateMagic.size())) {
+      XLOG(ERR) << "Not a binary state file: " << filename;
+      return std::nullopt;
+    }
+    auto version = folly::Endian::little(
+        folly::loadUnaligned<uint32_t>(data.data() + kBinaryStateMagic.size()));
+    if (version > kBinaryStateVersion) {
+      XLOG(ERR) << "Unsupported binary state version " << version
+                << " (max supported " << kBinaryStateVersion
+                << ") in: " << filename;
+      return std::nullopt;
+    }
+    return folly::bser::parseBser(data.subpiece(kBinaryStateHeaderSize));
+  } catch (const std::exception& ex) {
+    XLOG(ERR) << "Failed to read binary state from " << filename << ": "
+              << folly::exceptionStr(ex);
+  }
+  return std::nullopt;
+}
+
 bool isValidThriftStateFile(
     const std::string& follyStateFileName,
     const std::string& thriftStateFileName) {
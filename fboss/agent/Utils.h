@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include <optional>
 #include <string>
 #include <type_traits> // To use 'std::integral_constant'.
 
@@ -121,6 +122,23 @@ void incNiceValue(const uint32_t increment);
  */
 bool dumpStateToFile(const std::string& filename, const folly::dynamic& json);
 
+/*
+ * Serialize folly dynamic to a compact, versioned binary format (BSER
+ * preceded by a small header) and write to file. Much smaller and faster to
+ * parse than pretty printed JSON.
+ */
+bool dumpBinaryStateToFile(
+    const std::string& filename,
+    const folly::dynamic& state);
+
+/*
+ * Read folly dynamic written by dumpBinaryStateToFile. Returns std::nullopt
+ * if the file is missing, corrupt or written in an unsupported version, in
+ * which case callers should fall back to the JSON state.
+ */
+std::optional<folly::dynamic> readBinaryStateFromFile(
+    const std::string& filename);
+
 /*
  * Whether thrift state is valid for sw switch state recovery
  */
@@ -14,6 +14,7 @@
 #include <folly/Exception.h>
 #include <folly/FileUtil.h>
 
+#include <algorithm>
 #include <chrono>
 
 using folly::IOBuf;
@@ -22,9 +23,14 @@ using folly::writevFull;
 using std::chrono::microseconds;
 using std::chrono::seconds;
 
+namespace {
+// Snaplen advertised in the global header when packets are not truncated
+constexpr uint32_t kMaxSnaplen = 0xffff;
+} // namespace
+
 namespace facebook::fboss {
 
-PcapFile::PktHeader::PktHeader(const PcapPkt& pkt) {
+PcapFile::PktHeader::PktHeader(const PcapPkt& pkt, uint32_t snaplen) {
   auto ts = pkt.timestamp().time_since_epoch();
   seconds tsSec = std::chrono::duration_cast<seconds>(ts);
   microseconds tsUsec = std::chrono::duration_cast<microseconds>(ts);
@@ -32,14 +38,18 @@ PcapFile::PktHeader::PktHeader(const PcapPkt& pkt) {
 
   timeSec = tsSec.count();
   timeUsec = (tsUsec - tsSec).count();
-  includedLen = len;
+  includedLen = (snaplen > 0 && len > snaplen) ? snaplen : len;
   origLen = len;
 }
 
 PcapFile::PcapFile() {}
 
-PcapFile::PcapFile(folly::StringPiece path, bool overwriteExisting)
-    : file_(path.str().c_str(), openFlags(overwriteExisting), 0644) {}
+PcapFile::PcapFile(
+    folly::StringPiece path,
+    bool overwriteExisting,
+    uint32_t snaplen)
+    : file_(path.str().c_str(), openFlags(overwriteExisting), 0644),
+      snaplen_(snaplen) {}
 
 PcapFile::~PcapFile() {}
 
@@ -62,7 +72,7 @@ void PcapFile::writeGlobalHeader() {
   hdr.versionMinor = 4;
   hdr.tzOffset = 0;
   hdr.sigfigs = 0;
-  hdr.snaplen = 0xffff;
+  hdr.snaplen = snaplen_ > 0 ? snaplen_ : kMaxSnaplen;
   // Link type 1 is ethernet.  Other possible types we might want to use
   // include 113 for linux "cooked" capture format.
   hdr.linkType = 1;
@@ -82,10 +92,25 @@ void PcapFile::writePackets(const std::vector<PcapPkt>& pkts) {
 
   // Build iovecs for all of the packet headers and data
   for (const auto& pkt : pkts) {
-    hdrs.emplace_back(pkt);
+    hdrs.emplace_back(pkt, snaplen_);
     PktHeader* curHdr = &hdrs.back();
     iov.push_back({(void*)curHdr, sizeof(PktHeader)});
-    pkt.buf()->appendToIov(&iov);
+    if (curHdr->includedLen == curHdr->origLen) {
+      pkt.buf()->appendToIov(&iov);
+      continue;
+    }
+    // Only point at the first includedLen bytes of a truncated packet
+    size_t remaining = curHdr->includedLen;
+    for (auto range : *pkt.buf()) {
+      if (remaining == 0) {
+        break;
+      }
+      auto len = std::min(range.size(), remaining);
+      if (len > 0) {
+        iov.push_back({(void*)range.data(), len});
+      }
+      remaining -= len;
+    }
   }
 
   int ret = writevFull(file_.fd(), iov.data(), iov.size());
@@ -25,95 +25,113 @@ namespace facebook::fboss {
 PcapQueue::PcapQueue(uint32_t pktCapacity, uint64_t bytesCapacity)
     : pktCapacity_(
           pktCapacity == 0 ? FLAGS_fboss_pcap_queue_depth : pktCapacity),
-      bytesCapacity_(bytesCapacity) {
-  queue_.reserve(pktCapacity_);
-}
+      bytesCapacity_(bytesCapacity),
+      queue_(pktCapacity_) {}
 
 PcapQueue::~PcapQueue() {}
 
 template <typename PktType>
 void PcapQueue::addPktInternal(const PktType* pkt) {
-  // Check to see if this would exceed the queue capacity.
-  if (queue_.size() >= pktCapacity_) {
-    pktsDropped_ += 1;
+  if (finished_.load(std::memory_order_acquire)) {
+    pktsDropped_.fetch_add(1, std::memory_order_relaxed);
     return;
   }
-  auto newBytes = bytesInQueue_ + pkt->buf()->computeChainDataLength();
-  if (bytesCapacity_ > 0 && newBytes >= bytesCapacity_) {
-    pktsDropped_ += 1;
+  // Check to see if this would exceed the queue capacity.  The check is
+  // only a hint, but saves building a packet that would be dropped anyway.
+  if (queue_.isFull()) {
+    pktsDropped_.fetch_add(1, std::memory_order_relaxed);
     return;
   }
-
-  queue_.emplace_back(pkt);
-}
-
-void PcapQueue::addPkt(const RxPacket* pkt) {
-  {
-    std::lock_guard<std::mutex> guard(mutex_);
-    addPktInternal(pkt);
+  auto len = pkt->buf()->computeChainDataLength();
+  if (bytesCapacity_ > 0 &&
+      bytesInQueue_.fetch_add(len, std::memory_order_relaxed) + len >=
+          bytesCapacity_) {
+    bytesInQueue_.fetch_sub(len, std::memory_order_relaxed);
+    pktsDropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  // Build the packet before claiming a slot, constructing it in the slot
+  // could throw while the slot is held.
+  PcapPkt pcapPkt(pkt);
+  if (!queue_.write(std::move(pcapPkt))) {
+    if (bytesCapacity_ > 0) {
+      bytesInQueue_.fetch_sub(len, std::memory_order_relaxed);
+    }
+    pktsDropped_.fetch_add(1, std::memory_order_relaxed);
   }
-  cv_.notify_one();
 }
 
-void PcapQueue::addPktLocked(const RxPacket* pkt) {
+void PcapQueue::addPkt(const RxPacket* pkt) {
   addPktInternal(pkt);
-  // It is preferred not to be holding the lock when we signal cv_,
-  // but it is okay to call it with the lock held anyway.  (Having the lock
-  // held will just prevent the reader thread from being able to acquire it
-  // immediately when the reader wakes.)
-  cv_.notify_one();
 }
 
 void PcapQueue::addPkt(const TxPacket* pkt) {
-  {
-    std::lock_guard<std::mutex> guard(mutex_);
-    addPktInternal(pkt);
-  }
-  cv_.notify_one();
-}
-
-void PcapQueue::addPktLocked(const TxPacket* pkt) {
   addPktInternal(pkt);
-  // It is preferred not to be holding the lock when we signal cv_,
-  // but it is okay to call it with the lock held anyway.  (Having the lock
-  // held will just prevent the reader thread from being able to acquire it
-  // immediately when the reader wakes.)
-  cv_.notify_one();
 }
 
 void PcapQueue::finish() {
-  std::lock_guard<std::mutex> guard(mutex_);
-  finished_ = true;
-  cv_.notify_all();
+  if (finished_.exchange(true, std::memory_order_acq_rel)) {
+    return;
+  }
+  // Waits for the reader to make room if the queue is full. The reader
+  // keeps reading until it gets the marker, even after failing to process
+  // packets, see dropUntilFinished().
+  queue_.blockingWrite();
 }
 
 bool PcapQueue::isFinished() const {
-  std::lock_guard<std::mutex> guard(mutex_);
-  return finished_;
+  return finished_.load(std::memory_order_acquire);
 }
 
 uint64_t PcapQueue::numDropped() const {
-  std::lock_guard<std::mutex> guard(mutex_);
-  return pktsDropped_;
+  return pktsDropped_.load(std::memory_order_relaxed);
 }
 
 bool PcapQueue::wait(std::vector<PcapPkt>* swapQueue) {
   swapQueue->clear();
   swapQueue->reserve(pktCapacity_);
-
-  std::unique_lock<std::mutex> guard(mutex_);
-  while (queue_.empty() && !finished_) {
-    cv_.wait(guard);
-  }
-  if (queue_.empty()) {
-    DCHECK(finished_);
-    queue_.shrink_to_fit();
+  if (drained_) {
+    dropQueued();
     return false;
   }
 
-  swapQueue->swap(queue_);
-  bytesInQueue_ = 0;
-  return true;
+  PcapPkt pkt;
+  queue_.blockingRead(pkt);
+  do {
+    if (!pkt.initialized()) {
+      drained_ = true;
+      // Packets that raced with finish() and were queued behind the marker
+      dropQueued();
+      break;
+    }
+    if (bytesCapacity_ > 0) {
+      bytesInQueue_.fetch_sub(
+          pkt.buf()->computeChainDataLength(), std::memory_order_relaxed);
+    }
+    swapQueue->push_back(std::move(pkt));
+  } while (swapQueue->size() < pktCapacity_ && queue_.read(pkt));
+  return !swapQueue->empty();
+}
+
+void PcapQueue::dropUntilFinished() {
+  std::vector<PcapPkt> pkts;
+  while (wait(&pkts)) {
+    pktsDropped_.fetch_add(pkts.size(), std::memory_order_relaxed);
+  }
+}
+
+void PcapQueue::dropQueued() {
+  PcapPkt pkt;
+  while (queue_.read(pkt)) {
+    if (!pkt.initialized()) {
+      continue;
+    }
+    if (bytesCapacity_ > 0) {
+      bytesInQueue_.fetch_sub(
+          pkt.buf()->computeChainDataLength(), std::memory_order_relaxed);
+    }
+    pktsDropped_.fetch_add(1, std::memory_order_relaxed);
+  }
 }
 
 } // namespace facebook::fboss
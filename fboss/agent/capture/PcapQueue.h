@@ -9,21 +9,28 @@
  */
 #pragma once
 
-#include <condition_variable>
-#include <mutex>
+#include "fboss/agent/capture/PcapPkt.h"
+
+#include <folly/MPMCQueue.h>
+
+#include <atomic>
 #include <vector>
 
 namespace facebook::fboss {
 
 class RxPacket;
 class TxPacket;
-class PcapPkt;
 
 /*
  * PcapQueue stores a queue of PcapPkt objects, for transferring packets
  * from an asynchronous capture thread to a blocking thread that will process
  * the packets.  (For instance, writing them to disk using blocking I/O.)
  *
+ * The queue is a bounded ring with all slots allocated up front.  Adding a
+ * packet never takes a lock or allocates a slot, so any number of RX/TX
+ * threads can capture concurrently without slowing each other down.  When
+ * the ring is full the packet is dropped and counted.
+ *
  * There can only be a single reader.
  */
 class PcapQueue {
@@ -32,31 +39,21 @@ class PcapQueue {
   virtual ~PcapQueue();
 
   uint32_t getPktCapacity() const {
-    // pktCapacity_ is const, so no need for locking
     return pktCapacity_;
   }
 
-  /*
-   * Get the mutex protecting this PcapQueue.
-   *
-   * This is exposed to allow callers to also protect their own data
-   * with the same mutex if desired.  Callers should call addPktLocked()
-   * instead of addPkt() when they are already holding the PcapQueue mutex.
-   */
-  std::mutex& mutex() const {
-    return mutex_;
-  }
-
   void addPkt(const RxPacket* pkt);
-  void addPktLocked(const RxPacket* pkt);
   void addPkt(const TxPacket* pkt);
-  void addPktLocked(const TxPacket* pkt);
 
   /*
    * finish() signals that no more packets will be added to the queue.
    *
    * This causes wait() to return false in the reader thread once the packets
-   * currently in the queue have been read.
+   * currently in the queue have been read.  Packets added after finish() are
+   * dropped.
+   *
+   * Blocks until there is room for the marker in the queue, so the reader
+   * must keep reading until wait() returns false.
    */
   void finish();
   bool isFinished() const;
@@ -73,12 +70,21 @@ class PcapQueue {
   /*
    * Wait for new packets from the queue.
    *
+   * Moves up to getPktCapacity() packets into swapQueue, so they can be
+   * written out in a single batch.
+   *
    * Note: for best performance, the writer should re-use the same vector
    * for multiple wait() calls.  On subsequent calls the queue will already
    * have the desired capacity, and will not need to reallocate memory.
    */
   bool wait(std::vector<PcapPkt>* swapQueue);
 
+  /*
+   * Read and drop packets until finish() is called, for a reader that can
+   * no longer process them, so that finish() does not block forever.
+   */
+  void dropUntilFinished();
+
  private:
   // Forbidden copy constructor and assignment operator
   PcapQueue(PcapQueue const&) = delete;
@@ -86,16 +92,18 @@ class PcapQueue {
 
   template <typename PktType>
   void addPktInternal(const PktType* pkt);
+  // Drop the packets currently queued, reader only
+  void dropQueued();
 
-  mutable std::mutex mutex_;
-  std::condition_variable cv_;
-
-  bool finished_{false};
   const uint32_t pktCapacity_{0};
-  uint64_t bytesCapacity_{0};
-  uint64_t bytesInQueue_{0};
-  uint64_t pktsDropped_{0};
-  std::vector<PcapPkt> queue_;
+  const uint64_t bytesCapacity_{0};
+  std::atomic<bool> finished_{false};
+  std::atomic<uint64_t> bytesInQueue_{0};
+  std::atomic<uint64_t> pktsDropped_{0};
+  // An uninitialized PcapPkt is queued by finish() to wake up the reader
+  folly::MPMCQueue<PcapPkt> queue_;
+  // Only accessed by the reader, set once the finish() marker was read
+  bool drained_{false};
 };
 
 } // namespace facebook::fboss
@@ -40,8 +40,11 @@ PcapWriter::~PcapWriter() {
   }
 }
 
-void PcapWriter::start(folly::StringPiece path, bool overwriteExisting) {
-  file_ = PcapFile(path, overwriteExisting);
+void PcapWriter::start(
+    folly::StringPiece path,
+    bool overwriteExisting,
+    uint32_t snaplen) {
+  file_ = PcapFile(path, overwriteExisting, snaplen);
   thread_ = std::thread(&PcapWriter::threadMain, this);
 }
 
@@ -66,6 +69,8 @@ void PcapWriter::threadMain() {
   } catch (const std::exception& ex) {
     XLOG(ERR) << "error writing to pcap file: " << folly::exceptionStr(ex);
     ex_ = std::current_exception();
+    // Keep emptying the queue, finish() waits for room in it
+    queue_.dropUntilFinished();
   }
 }
 
@@ -31,38 +31,33 @@ class PcapWriter {
       uint32_t maxBufferedPkts = 0);
   virtual ~PcapWriter();
 
-  void start(folly::StringPiece path, bool overwriteExisting = false);
-
   /*
-   * Get the mutex protecting this PcapWriter.
-   *
-   * This is exposed to allow callers to also protect their own data
-   * with the same mutex if desired.  Callers should call addPktLocked()
-   * instead of addPkt() when they are already holding the PcapWriter mutex.
+   * Packets longer than snaplen bytes are truncated in the pcap file, a
+   * snaplen of 0 writes whole packets.
    */
-  std::mutex& mutex() const {
-    return queue_.mutex();
-  }
+  void start(
+      folly::StringPiece path,
+      bool overwriteExisting = false,
+      uint32_t snaplen = 0);
 
+  /*
+   * Queue a packet to be written.  This does not block and can be called
+   * from any number of threads at once.
+   */
   void addPkt(const RxPacket* pkt) {
     queue_.addPkt(pkt);
   }
-  void addPktLocked(const RxPacket* pkt) {
-    queue_.addPktLocked(pkt);
-  }
   void addPkt(const TxPacket* pkt) {
     queue_.addPkt(pkt);
   }
-  void addPktLocked(const TxPacket* pkt) {
-    queue_.addPktLocked(pkt);
-  }
   void finish();
 
   /*
    * Return the number of packets dropped.
    *
    * Packets will be dropped if the writer thread cannot write packets
-   * to disk as fast as they are being added.
+   * to disk as fast as they are being added, once writing fails, or when
+   * added after finish().
    */
   uint64_t numDropped() const {
     return queue_.numDropped();
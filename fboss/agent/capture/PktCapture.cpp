@@ -27,39 +27,55 @@ PktCapture::PktCapture(
     folly::StringPiece name,
     uint64_t maxPackets,
     CaptureDirection direction,
-    const CaptureFilter& captureFilter)
+    const CaptureFilter& captureFilter,
+    uint32_t snaplen)
     : name_(name.str()),
       maxPackets_(maxPackets),
       direction_(direction),
-      packetFilter_(captureFilter) {}
+      packetFilter_(captureFilter),
+      snaplen_(snaplen) {}
 
 void PktCapture::start(StringPiece path) {
   XLOG(DBG2) << "starting packet capture " << toString();
-  writer_.start(path, true);
+  writer_.start(path, true, snaplen_);
 }
 
 void PktCapture::stop() {
   writer_.finish();
   XLOG(DBG2) << "Stopped packet capture " << toString(true);
+  if (auto dropped = numDropped()) {
+    XLOG(WARN) << "Packet capture \"" << name_ << "\" dropped " << dropped
+               << " packets";
+  }
+}
+
+bool PktCapture::reservePacket() {
+  // Check and count in one step, so that concurrent callers can never
+  // capture more than maxPackets_ between them.
+  return numPacketsReserved_.fetch_add(1) < maxPackets_;
 }
 
 bool PktCapture::packetReceived(const RxPacket* pkt) {
-  std::lock_guard<std::mutex> guard(writer_.mutex());
   if (direction_ != CaptureDirection::CAPTURE_ONLY_TX &&
       true == packetFilter_.passes(pkt)) {
+    if (!reservePacket()) {
+      return false;
+    }
     ++numPacketsReceived_;
-    writer_.addPktLocked(pkt);
+    writer_.addPkt(pkt);
   }
-  return (numPacketsSent_ + numPacketsReceived_) < maxPackets_;
+  return numPacketsReserved_ < maxPackets_;
 }
 
 bool PktCapture::packetSent(const TxPacket* pkt) {
-  std::lock_guard<std::mutex> guard(writer_.mutex());
   if (direction_ != CaptureDirection::CAPTURE_ONLY_RX) {
+    if (!reservePacket()) {
+      return false;
+    }
     ++numPacketsSent_;
-    writer_.addPktLocked(pkt);
+    writer_.addPkt(pkt);
   }
-  return (numPacketsSent_ + numPacketsReceived_) < maxPackets_;
+  return numPacketsReserved_ < maxPackets_;
 }
 
 std::string PktCapture::toString(bool withStats) const {
@@ -71,13 +87,13 @@ std::string PktCapture::toString(bool withStats) const {
                                                                   : "TX only"));
   if (withStats) {
     ss << ", Packet received:" << numPacketsReceived_
-       << ", Packet sent:" << numPacketsSent_;
+       << ", Packet sent:" << numPacketsSent_
+       << ", Packet dropped:" << numDropped();
   }
   return ss.str();
 }
 
-int PktCapture::getCaptureCount() {
-  std::lock_guard<std::mutex> guard(writer_.mutex());
+int PktCapture::getCaptureCount() const {
   return (numPacketsSent_ + numPacketsReceived_);
 }
 } // namespace facebook::fboss
@@ -14,6 +14,7 @@
 
 #include <boost/container/flat_set.hpp>
 #include <folly/Range.h>
+#include <atomic>
 #include <string>
 #include "fboss/agent/RxPacket.h"
 #include "fboss/agent/TxPacket.h"
@@ -42,7 +43,7 @@ class PacketFilter {
   explicit PacketFilter(const CaptureFilter& captureFilter)
       : rxPacketFilter_(captureFilter.get_rxCaptureFilter()) {}
 
-  bool passes(const RxPacket* pkt) {
+  bool passes(const RxPacket* pkt) const {
     return rxPacketFilter_.passes(pkt);
   }
 
@@ -63,7 +64,8 @@ class PktCapture {
       folly::StringPiece name,
       uint64_t maxPackets,
       CaptureDirection direction,
-      const CaptureFilter& captureFilter);
+      const CaptureFilter& captureFilter,
+      uint32_t snaplen = 0);
 
   const std::string& name() const {
     return name_;
@@ -72,9 +74,22 @@ class PktCapture {
   void start(folly::StringPiece path);
   void stop();
 
+  /*
+   * Capture a packet.  Returns false once maxPackets have been captured.
+   *
+   * These do not block, and are safe to call from several threads at once.
+   */
   bool packetReceived(const RxPacket* pkt);
   bool packetSent(const TxPacket* pkt);
-  int getCaptureCount();
+  int getCaptureCount() const;
+
+  /*
+   * Number of captured packets that were dropped because the writer could
+   * not keep up.
+   */
+  uint64_t numDropped() const {
+    return writer_.numDropped();
+  }
 
   std::string toString(bool withStats = false) const;
 
@@ -83,15 +98,19 @@ class PktCapture {
   PktCapture(PktCapture const&) = delete;
   PktCapture& operator=(PktCapture const&) = delete;
 
+  // Claims one of the maxPackets_ capture slots, false once all are taken
+  bool reservePacket();
+
   const std::string name_;
 
-  // Note: the rest of the state in this class is protcted by
-  // the PcapWriter's mutex.
   PcapWriter writer_;
   uint64_t maxPackets_{0};
-  uint64_t numPacketsReceived_{0};
-  uint64_t numPacketsSent_{0};
+  std::atomic<uint64_t> numPacketsReceived_{0};
+  std::atomic<uint64_t> numPacketsSent_{0};
+  // Packets that passed the filter, including ones past maxPackets_
+  std::atomic<uint64_t> numPacketsReserved_{0};
   CaptureDirection direction_{CaptureDirection::CAPTURE_TX_RX};
   PacketFilter packetFilter_;
+  uint32_t snaplen_{0};
 };
 } // namespace facebook::fboss
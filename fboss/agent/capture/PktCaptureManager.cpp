@@ -16,6 +16,11 @@
 #include <folly/String.h>
 #include <folly/logging/xlog.h>
 
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
 using folly::StringPiece;
 using std::string;
 using std::unique_ptr;
@@ -56,7 +61,7 @@ void PktCaptureManager::startCapture(unique_ptr<PktCapture> capture) {
   auto path =
       folly::to<std::string>(captureDir_, "/", capture->name(), ".pcap");
 
-  std::lock_guard<std::mutex> g(mutex_);
+  std::lock_guard<folly::SharedMutex> g(mutex_);
 
   const auto& name = capture->name();
   if (activeCaptures_.find(name) != activeCaptures_.end()) {
@@ -69,7 +74,7 @@ void PktCaptureManager::startCapture(unique_ptr<PktCapture> capture) {
 }
 
 void PktCaptureManager::stopCapture(StringPiece name) {
-  std::lock_guard<std::mutex> g(mutex_);
+  std::lock_guard<folly::SharedMutex> g(mutex_);
 
   auto nameStr = name.str();
   auto it = activeCaptures_.find(nameStr);
@@ -83,7 +88,7 @@ void PktCaptureManager::stopCapture(StringPiece name) {
 }
 
 unique_ptr<PktCapture> PktCaptureManager::forgetCapture(StringPiece name) {
-  std::lock_guard<std::mutex> g(mutex_);
+  std::lock_guard<folly::SharedMutex> g(mutex_);
   auto nameStr = name.str();
   auto activeIt = activeCaptures_.find(nameStr);
   if (activeIt != activeCaptures_.end()) {
@@ -105,50 +110,62 @@ unique_ptr<PktCapture> PktCaptureManager::forgetCapture(StringPiece name) {
 }
 
 void PktCaptureManager::stopAllCaptures() {
-  std::lock_guard<std::mutex> g(mutex_);
+  std::lock_guard<folly::SharedMutex> g(mutex_);
 
   // FIXME
 }
 
 void PktCaptureManager::forgetAllCaptures() {
-  std::lock_guard<std::mutex> g(mutex_);
+  std::lock_guard<folly::SharedMutex> g(mutex_);
 
   // FIXME
 }
 
 template <typename Fn>
 void PktCaptureManager::invokeCaptures(const Fn& fn) {
-  std::lock_guard<std::mutex> g(mutex_);
-
-  for (auto it = activeCaptures_.begin(); it != activeCaptures_.end();
-       /* increment in loop */) {
-    // Increment the iterator now, in case this capture deactivates itself and
-    // we need to remove it from the active captures.
-    auto thisIt = it;
-    ++it;
-    PktCapture* capture = thisIt->second.get();
-    bool stillActive = false;
-    try {
-      stillActive = fn(capture);
-    } catch (const std::exception& ex) {
-      XLOG(ERR) << "error when processing packet for capture "
-                << capture->name() << " : " << folly::exceptionStr(ex);
-      stillActive = false;
-    }
-
-    if (!stillActive) {
-      XLOG(DBG2) << "auto-stopping packet capture \"" << capture->name()
-                 << "\"";
+  // Packets are handed to the captures under a shared lock, so RX and TX
+  // threads can capture at the same time.  Captures that are done are moved
+  // to the inactive list under the exclusive lock afterwards.
+  // Only compared against, the capture may have been forgotten and freed by
+  // the time the exclusive lock is held.
+  std::vector<std::pair<std::string, const PktCapture*>> finished;
+  {
+    std::shared_lock<folly::SharedMutex> g(mutex_);
+    for (const auto& nameAndCapture : activeCaptures_) {
+      PktCapture* capture = nameAndCapture.second.get();
+      bool stillActive = false;
       try {
-        inactiveCaptures_[capture->name()] = std::move(thisIt->second);
+        stillActive = fn(capture);
       } catch (const std::exception& ex) {
-        XLOG(ERR) << "error adding capture " << capture->name()
-                  << " to the inactive list";
-        // Can't do much else here.  Just continue and forget the capture.
+        XLOG(ERR) << "error when processing packet for capture "
+                  << capture->name() << " : " << folly::exceptionStr(ex);
+        stillActive = false;
+      }
+      if (!stillActive) {
+        finished.emplace_back(nameAndCapture.first, capture);
       }
-      activeCaptures_.erase(thisIt);
     }
   }
+  if (finished.empty()) {
+    return;
+  }
+
+  std::lock_guard<folly::SharedMutex> g(mutex_);
+  for (const auto& [name, capture] : finished) {
+    auto it = activeCaptures_.find(name);
+    if (it == activeCaptures_.end() || it->second.get() != capture) {
+      // Already deactivated by another thread in the meantime
+      continue;
+    }
+    XLOG(DBG2) << "auto-stopping packet capture \"" << name << "\"";
+    try {
+      inactiveCaptures_[name] = std::move(it->second);
+    } catch (const std::exception& ex) {
+      XLOG(ERR) << "error adding capture " << name << " to the inactive list";
+      // Can't do much else here.  Just continue and forget the capture.
+    }
+    activeCaptures_.erase(it);
+  }
 
   bool running = !activeCaptures_.empty();
   capturesRunning_.store(running, std::memory_order_release);
@@ -177,7 +194,7 @@ void PktCaptureManager::checkCaptureName(folly::StringPiece name) {
 // routine as used in tests to verify if the pkt capture buffer
 // limit has been reached
 int PktCaptureManager::getCaptureCount(StringPiece name) {
-  std::lock_guard<std::mutex> g(mutex_);
+  std::shared_lock<folly::SharedMutex> g(mutex_);
   auto nameStr = name.str();
   auto it = activeCaptures_.find(nameStr);
   if (it == activeCaptures_.end()) {
@@ -10,11 +10,11 @@
 #pragma once
 
 #include <folly/Range.h>
+#include <folly/SharedMutex.h>
 
 #include <atomic>
 #include <map>
 #include <memory>
-#include <mutex>
 #include <string>
 #include "fboss/agent/PacketObserver.h"
 
@@ -80,7 +80,9 @@ class PktCaptureManager : public PacketObserverIf {
 
   std::atomic<bool> capturesRunning_{false};
 
-  std::mutex mutex_;
+  // Held shared while packets are being captured, and exclusively to
+  // change the set of captures
+  folly::SharedMutex mutex_;
   std::string captureDir_;
   std::map<std::string, std::unique_ptr<PktCapture>> activeCaptures_;
   std::map<std::string, std::unique_ptr<PktCapture>> inactiveCaptures_;
@@ -22,8 +22,12 @@
 #include "fboss/agent/test/TestUtils.h"
 
 #include <folly/Memory.h>
+#include <folly/experimental/TestUtil.h>
 #include <gtest/gtest.h>
 
+#include <thread>
+#include <vector>
+
 using namespace facebook::fboss;
 using folly::StringPiece;
 using std::make_shared;
@@ -269,3 +273,35 @@ TEST(CaptureTest, FullCapture) {
   //
   // EXPECT_BUF_EQ(updatedIpPktData, pcapPkts.at(4).data);
 }
+
+TEST(CaptureTest, MaxPacketsFromConcurrentCallers) {
+  constexpr auto kMaxPackets = 100;
+  constexpr auto kThreads = 4;
+  folly::test::TemporaryDirectory tmpDir;
+  PktCapture capture("test", kMaxPackets, CaptureDirection::CAPTURE_TX_RX);
+  capture.start((tmpDir.path() / "test.pcap").string());
+
+  auto pktData = PktUtil::parseHexData(
+      // dst mac, src mac
+      "02 00 01 00 00 01  02 00 02 01 02 03"
+      // 802.1q, VLAN 1, IPv4
+      "81 00 00 01  08 00");
+  MockRxPacket pkt(pktData.clone());
+  pkt.setSrcPort(PortID(1));
+  pkt.setSrcVlan(VlanID(1));
+
+  // Every thread alone would fill the capture
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&capture, &pkt]() {
+      for (auto j = 0; j < kMaxPackets; ++j) {
+        capture.packetReceived(&pkt);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  capture.stop();
+  EXPECT_EQ(capture.getCaptureCount(), kMaxPackets);
+}
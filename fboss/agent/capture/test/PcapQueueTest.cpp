@@ -71,3 +71,40 @@ TEST(PcapQueueTest, SimpleAdd) {
   ByteRange waitedPktData = waitedPktBufClone->coalesce();
   EXPECT_EQ(expectedPktData, waitedPktData);
 }
+
+TEST(PcapQueueTest, ConcurrentAddDrops) {
+  constexpr int kThreads = 4;
+  constexpr int kPktsPerThread = 100;
+  PcapQueue queue(16);
+
+  auto pkt = MockRxPacket::fromHex(
+      // dst mac, src mac, ethertype
+      "02 00 01 00 00 01  02 00 02 01 02 03  08 00");
+  pkt->padToLength(68);
+  pkt->setSrcPort(PortID(1));
+
+  // Nothing reads from the queue yet, so everything past its capacity
+  // is dropped.
+  std::vector<std::thread> producers;
+  for (int i = 0; i < kThreads; ++i) {
+    producers.emplace_back([&]() {
+      for (int n = 0; n < kPktsPerThread; ++n) {
+        queue.addPkt(pkt.get());
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  EXPECT_EQ(kThreads * kPktsPerThread - 16, queue.numDropped());
+
+  std::vector<PcapPkt> waitedPkts;
+  std::thread waiter([&]() { pktWaitThread(&queue, &waitedPkts); });
+  queue.finish();
+  waiter.join();
+  EXPECT_EQ(16, waitedPkts.size());
+
+  // Packets added after finish() are dropped
+  queue.addPkt(pkt.get());
+  EXPECT_EQ(kThreads * kPktsPerThread - 15, queue.numDropped());
+}
@@ -101,3 +101,36 @@ TEST(PcapWriterTest, Drop) {
     EXPECT_EQ(68, pktInfo.hdr.caplen);
   }
 }
+
+TEST(PcapWriterTest, Snaplen) {
+  char tmpPath[] = "fbossPcapTest.XXXXXX";
+  int tmpFD = mkstemp(tmpPath);
+  folly::checkUnixError(tmpFD, "failed to create temporary file");
+  SCOPE_EXIT {
+    close(tmpFD);
+    unlink(tmpPath);
+  };
+
+  PcapWriter writer;
+  writer.start(tmpPath, true, 32 /* snaplen */);
+  addPackets(&writer, 10);
+  writer.finish();
+  EXPECT_EQ(0, writer.numDropped());
+
+  auto pcapPkts = readPcapFile(tmpPath);
+  EXPECT_EQ(10, pcapPkts.size());
+  for (const auto& pktInfo : pcapPkts) {
+    EXPECT_EQ(68, pktInfo.hdr.len);
+    EXPECT_EQ(32, pktInfo.hdr.caplen);
+    EXPECT_EQ(32, pktInfo.data.size());
+  }
+}
+
+TEST(PcapWriterTest, WriteErrorDoesNotBlockFinish) {
+  // Writes to /dev/full fail, leaving the writer thread with nothing to
+  // write to while more packets than the queue holds are added
+  PcapWriter writer("/dev/full", true, 2);
+  addPackets(&writer, 100);
+  EXPECT_THROW(writer.finish(), std::exception);
+  EXPECT_EQ(100, writer.numDropped());
+}
@@ -14,11 +14,14 @@
 #include "fboss/agent/SysError.h"
 #include "fboss/agent/Utils.h"
 
+#include <boost/filesystem/operations.hpp>
 #include <folly/FileUtil.h>
 #include <folly/json.h>
 #include <folly/logging/xlog.h>
+#include <chrono>
 #include <optional>
 #include <tuple>
+#include <utility>
 #include "fboss/lib/CommonFileUtils.h"
 
 DEFINE_bool(can_warm_boot, true, "Enable/disable warm boot functionality");
@@ -34,6 +37,15 @@ DEFINE_bool(
     dump_thrift_state,
     true,
     "Whether to dump thrift state during warmboot exit");
+DEFINE_string(
+    binary_switch_state_file,
+    "binary_switch_state",
+    "File for dumping switch state in compact binary format on exit");
+DEFINE_bool(
+    dump_json_switch_state,
+    true,
+    "Whether to also dump switch state JSON during warmboot exit. Only "
+    "needed to warm boot into versions that can't read the binary state");
 
 namespace {
 constexpr auto wbFlagPrefix = "can_warm_boot_";
@@ -91,6 +103,11 @@ std::string HwSwitchWarmBootHelper::warmBootThriftSwitchStateFile() const {
       warmBootDir_, "/", FLAGS_thrift_switch_state_file);
 }
 
+std::string HwSwitchWarmBootHelper::warmBootBinarySwitchStateFile() const {
+  return folly::to<std::string>(
+      warmBootDir_, "/", FLAGS_binary_switch_state_file);
+}
+
 std::string HwSwitchWarmBootHelper::warmBootFlag() const {
   return folly::to<std::string>(warmBootDir_, "/", wbFlagPrefix, switchId_);
 }
@@ -137,8 +154,20 @@ bool HwSwitchWarmBootHelper::checkAndClearWarmBootFlags() {
 bool HwSwitchWarmBootHelper::storeWarmBootState(
     const folly::dynamic& follySwitchState,
     const state::WarmbootState& thriftSwitchState) {
-  warmBootStateWritten_ =
-      dumpStateToFile(warmBootFollySwitchStateFile(), follySwitchState);
+  warmBootStateWritten_ = true;
+  if (FLAGS_dump_json_switch_state) {
+    warmBootStateWritten_ &=
+        dumpStateToFile(warmBootFollySwitchStateFile(), follySwitchState);
+  } else {
+    // Don't leave JSON state from an earlier exit behind, startup would fall
+    // back to it if the binary state can't be read, as would a version that
+    // only reads JSON.
+    removeFile(warmBootFollySwitchStateFile());
+  }
+  // Binary state is dumped after JSON state, so on startup it is only used
+  // if it is at least as new as the JSON state
+  warmBootStateWritten_ &=
+      dumpBinaryStateToFile(warmBootBinarySwitchStateFile(), follySwitchState);
   if (FLAGS_dump_thrift_state) {
     warmBootStateWritten_ &= dumpBinaryThriftToFile(
         warmBootThriftSwitchStateFile(), thriftSwitchState);
@@ -148,20 +177,45 @@ bool HwSwitchWarmBootHelper::storeWarmBootState(
 
 std::tuple<folly::dynamic, std::optional<state::WarmbootState>>
 HwSwitchWarmBootHelper::getWarmBootState() const {
-  std::string warmBootJson;
-  auto ret =
-      folly::readFile(warmBootFollySwitchStateFile().c_str(), warmBootJson);
-  sysCheckError(
-      ret,
-      "Unable to read switch state from : ",
-      warmBootFollySwitchStateFile());
+  auto [follyState, follyStateFile] = getFollyWarmBootState();
   state::WarmbootState thriftState;
-  if (isValidThriftStateFile(
-          warmBootFollySwitchStateFile(), warmBootThriftSwitchStateFile()) &&
+  if (isValidThriftStateFile(follyStateFile, warmBootThriftSwitchStateFile()) &&
       readThriftFromBinaryFile(warmBootThriftSwitchStateFile(), thriftState)) {
-    return std::make_tuple(folly::parseJson(warmBootJson), thriftState);
+    return std::make_tuple(std::move(follyState), thriftState);
+  }
+  return std::make_tuple(std::move(follyState), std::nullopt);
+}
+
+std::pair<folly::dynamic, std::string>
+HwSwitchWarmBootHelper::getFollyWarmBootState() const {
+  auto begin = std::chrono::steady_clock::now();
+  auto logReadTime = [begin](const std::string& file) {
+    XLOG(DBG2) << "Read warm boot state from " << file << " in "
+               << std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::steady_clock::now() - begin)
+                      .count()
+               << "ms";
+  };
+  auto binaryFile = warmBootBinarySwitchStateFile();
+  auto jsonFile = warmBootFollySwitchStateFile();
+  // JSON state newer than the binary state was written by a version which
+  // doesn't dump binary state, e.g. after a downgrade and upgrade.
+  if (boost::filesystem::exists(binaryFile) &&
+      (!boost::filesystem::exists(jsonFile) ||
+       boost::filesystem::last_write_time(binaryFile) >=
+           boost::filesystem::last_write_time(jsonFile))) {
+    if (auto state = readBinaryStateFromFile(binaryFile)) {
+      logReadTime(binaryFile);
+      return std::make_pair(std::move(*state), binaryFile);
+    }
+    XLOG(WARN) << "Falling back to JSON warm boot state";
   }
-  return std::make_tuple(folly::parseJson(warmBootJson), std::nullopt);
+  std::string warmBootJson;
+  auto ret = folly::readFile(jsonFile.c_str(), warmBootJson);
+  sysCheckError(ret, "Unable to read switch state from : ", jsonFile);
+  auto state = folly::parseJson(warmBootJson);
+  logReadTime(jsonFile);
+  return std::make_pair(std::move(state), jsonFile);
 }
 
 void HwSwitchWarmBootHelper::setupWarmBootFile() {
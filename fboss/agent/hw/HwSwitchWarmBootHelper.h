@@ -11,6 +11,7 @@
 
 #include <folly/dynamic.h>
 #include <string>
+#include <utility>
 #include "fboss/agent/gen-cpp2/switch_state_types.h"
 
 namespace facebook::fboss {
@@ -71,6 +72,13 @@ class HwSwitchWarmBootHelper {
   std::string forceColdBootOnceFlag() const;
   std::string warmBootFollySwitchStateFile() const;
   std::string warmBootThriftSwitchStateFile() const;
+  std::string warmBootBinarySwitchStateFile() const;
+
+  /*
+   * Read the folly switch state, from the binary state file if it is
+   * usable, else from the JSON one. Also returns the file it was read from.
+   */
+  std::pair<folly::dynamic, std::string> getFollyWarmBootState() const;
 
   void setupWarmBootFile();
   /*
@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/hw/StateDeltaScheduler.h"
+
+#include "fboss/agent/FbossError.h"
+
+#include <folly/futures/Future.h>
+#include <folly/futures/SharedPromise.h>
+#include <folly/logging/xlog.h>
+
+namespace facebook::fboss {
+
+StateDeltaScheduler::SectionId StateDeltaScheduler::addSection(
+    std::string name,
+    std::function<void()> program,
+    std::vector<SectionId> dependencies) {
+  for (auto dependency : dependencies) {
+    if (dependency >= sections_.size()) {
+      throw FbossError(
+          "State delta section ", name, " depends on a later section");
+    }
+  }
+  sections_.push_back(
+      {std::move(name), std::move(program), std::move(dependencies)});
+  return sections_.size() - 1;
+}
+
+void StateDeltaScheduler::run() {
+  if (!executor_) {
+    for (const auto& section : sections_) {
+      section.program();
+    }
+    return;
+  }
+  runConcurrently();
+}
+
+void StateDeltaScheduler::runConcurrently() {
+  std::vector<folly::SharedPromise<folly::Unit>> done(sections_.size());
+  std::vector<folly::Future<folly::Unit>> programmed;
+  programmed.reserve(sections_.size());
+  for (SectionId id = 0; id < sections_.size(); ++id) {
+    std::vector<folly::SemiFuture<folly::Unit>> dependencies;
+    for (auto dependency : sections_[id].dependencies) {
+      dependencies.push_back(done[dependency].getSemiFuture());
+    }
+    programmed.push_back(
+        folly::collect(std::move(dependencies))
+            .via(executor_)
+            .thenTry([this, id, &done](
+                         folly::Try<std::vector<folly::Unit>>&& deps) {
+              try {
+                // Rethrows the error of a failed dependency
+                deps.value();
+                sections_[id].program();
+              } catch (...) {
+                done[id].setException(
+                    folly::exception_wrapper(std::current_exception()));
+                throw;
+              }
+              done[id].setValue();
+            }));
+  }
+  // Wait for every section before looking at errors, sections must not be
+  // left running when the caller e.g. rolls back
+  auto results = folly::collectAll(std::move(programmed)).get();
+  for (SectionId id = 0; id < results.size(); ++id) {
+    if (results[id].hasException()) {
+      XLOG(ERR) << "Failed to program state delta section "
+                << sections_[id].name << ": "
+                << results[id].exception().what();
+      results[id].exception().throw_exception();
+    }
+  }
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/Executor.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * Runs the sections of a StateDelta a HwSwitch programs, each once the
+ * sections it depends on are done.
+ *
+ * Without an executor, sections run inline in the order they were added,
+ * stopping at the first error, i.e. as a plain sequence of calls would.
+ * With one, every section whose dependencies are done is scheduled on it,
+ * so independent sections run concurrently. Sections can then run in any
+ * order that respects dependencies and must do their own locking. A failed
+ * section fails the sections depending on it, the others still run.
+ *
+ * A section may only depend on sections added before it, so dependencies
+ * cannot form cycles.
+ */
+class StateDeltaScheduler {
+ public:
+  using SectionId = size_t;
+
+  explicit StateDeltaScheduler(folly::Executor* executor = nullptr)
+      : executor_(executor) {}
+
+  SectionId addSection(
+      std::string name,
+      std::function<void()> program,
+      std::vector<SectionId> dependencies = {});
+
+  /*
+   * Runs all sections and returns once none is running, rethrowing the
+   * error of the first failed section, if any.
+   */
+  void run();
+
+ private:
+  struct Section {
+    std::string name;
+    std::function<void()> program;
+    std::vector<SectionId> dependencies;
+  };
+
+  void runConcurrently();
+
+  folly::Executor* executor_;
+  std::vector<Section> sections_;
+};
+
+} // namespace facebook::fboss
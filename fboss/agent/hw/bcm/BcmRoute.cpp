@@ -16,6 +16,7 @@ extern "C" {
 #include <folly/IPAddress.h>
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
+#include <folly/hash/Hash.h>
 #include <folly/logging/xlog.h>
 #include "fboss/agent/Constants.h"
 #include "fboss/agent/hw/bcm/BcmError.h"
@@ -467,18 +468,12 @@ BcmHostRoute::~BcmHostRoute() {
   addedInHW_ = false;
 }
 
-bool BcmRouteTable::Key::operator<(const Key& k2) const {
-  if (vrf < k2.vrf) {
-    return true;
-  } else if (vrf > k2.vrf) {
-    return false;
-  }
-  if (mask < k2.mask) {
-    return true;
-  } else if (mask > k2.mask) {
-    return false;
-  }
-  return network < k2.network;
+bool BcmRouteTable::Key::operator==(const Key& k2) const {
+  return vrf == k2.vrf && mask == k2.mask && network == k2.network;
+}
+
+size_t BcmRouteTable::KeyHash::operator()(const Key& key) const {
+  return folly::hash::hash_combine(key.vrf, key.mask, key.network);
 }
 
 BcmRouteTable::BcmRouteTable(BcmSwitch* hw) : hw_(hw) {}
@@ -15,6 +15,7 @@ extern "C" {
 }
 
 #include <folly/IPAddress.h>
+#include <folly/container/F14Map.h>
 #include <folly/dynamic.h>
 #include "fboss/agent/hw/bcm/BcmHost.h"
 #include "fboss/agent/hw/bcm/BcmRouteCounter.h"
@@ -145,13 +146,16 @@ class BcmRouteTable : public BcmHostTableIf {
     folly::IPAddress network;
     uint8_t mask;
     bcm_vrf_t vrf;
-    bool operator<(const Key& k2) const;
+    bool operator==(const Key& k2) const;
+  };
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
   };
 
   BcmSwitch* hw_;
 
   // routes programmed from addRoute()
-  std::map<Key, std::unique_ptr<BcmRoute>> fib_;
+  folly::F14FastMap<Key, std::unique_ptr<BcmRoute>, KeyHash> fib_;
   // host routes programmed from programHostRoutes*()
   FlatRefMap<BcmHostKey, BcmHostRoute> hostRoutes_;
 };
@@ -3459,6 +3459,14 @@ void BcmSwitch::processChangedAcl(
     const std::shared_ptr<AclEntry>& newAcl) {
   // Unfortunately, we cannot modify a field entry due to BCM limitation
   XLOG(DBG3) << "processChangedAcl, ACL=" << oldAcl->getID();
+  if (oldAcl->getPriority() != newAcl->getPriority() &&
+      !aclTable_->getAclIf(newAcl->getPriority())) {
+    // Moving to a free priority. Add at the new priority before removing
+    // the old entry, so matching traffic never goes without one.
+    processAddedAcl(newAcl);
+    processRemovedAcl(oldAcl);
+    return;
+  }
   processRemovedAcl(oldAcl);
   processAddedAcl(newAcl);
 }
@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/L2Entry.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/hw/test/ConfigFactory.h"
+#include "fboss/agent/hw/test/HwTestPacketUtils.h"
+#include "fboss/agent/state/MacTable.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/state/Vlan.h"
+#include "fboss/agent/state/VlanMap.h"
+
+#include <folly/Benchmark.h>
+#include <folly/MacAddress.h>
+
+#include "fboss/agent/benchmarks/AgentBenchmarks.h"
+
+namespace facebook::fboss {
+
+namespace {
+constexpr int kNumMacs = 50000;
+
+size_t macTableSize(SwSwitch* sw, VlanID vlan) {
+  return sw->getState()->getVlans()->getVlan(vlan)->getMacTable()->size();
+}
+} // namespace
+
+/*
+ * Replay a burst of kNumMacs SW learning callbacks (as a server rack reboot
+ * would generate) and measure how long it takes for all of them to land in
+ * the MAC table.
+ */
+BENCHMARK(HwL2LearningBurst) {
+  folly::BenchmarkSuspender suspender;
+  AgentEnsembleSwitchConfigFn initialConfigFn =
+      [](HwSwitch* hwSwitch, const std::vector<PortID>& ports) {
+        auto config = utility::oneL3IntfConfig(hwSwitch, ports[0]);
+        config.switchSettings()->l2LearningMode() =
+            cfg::L2LearningMode::SOFTWARE;
+        return config;
+      };
+  auto ensemble = createAgentEnsemble(initialConfigFn);
+  auto sw = ensemble->getSw();
+  auto port = PortDescriptor(ensemble->masterLogicalPortIds()[0]);
+  auto vlan = *utility::firstVlanID(ensemble->getProgrammedState());
+
+  std::vector<L2Entry> l2Entries;
+  l2Entries.reserve(kNumMacs);
+  for (uint64_t i = 0; i < kNumMacs; ++i) {
+    l2Entries.emplace_back(
+        folly::MacAddress::fromHBO(0x020000000000 + i),
+        vlan,
+        port,
+        L2Entry::L2EntryType::L2_ENTRY_TYPE_VALIDATED);
+  }
+  auto startSize = macTableSize(sw, vlan);
+
+  suspender.dismiss();
+  for (const auto& l2Entry : l2Entries) {
+    sw->l2LearningUpdateReceived(
+        l2Entry, L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD);
+  }
+  while (macTableSize(sw, vlan) < startSize + kNumMacs) {
+    usleep(100);
+  }
+  suspender.rehire();
+}
+
+} // namespace facebook::fboss
@@ -19,6 +19,17 @@
 #include <folly/Benchmark.h>
 #include <folly/IPAddress.h>
 #include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
+
+#include <chrono>
+#include <limits>
+
+DEFINE_int32(
+    stats_collection_num_ports,
+    48,
+    "Number of ports to collect stats for, 0 for all master logical ports. "
+    "Combine with --sai_stats_collection_threads to compare serial and "
+    "parallel stats collection on high port count (e.g. VOQ) switches.");
 
 namespace facebook::fboss {
 
@@ -45,10 +56,12 @@ RouteNextHopSet makeNextHops(std::vector<std::string> ipsAsStrings) {
 BENCHMARK(HwStatsCollection) {
   folly::BenchmarkSuspender suspender;
   std::unique_ptr<AgentEnsemble> ensemble{};
-  // maximum 48 master logical ports (taken from wedge400) to get
-  // consistent performance results across platforms with different
+  // By default, maximum 48 master logical ports (taken from wedge400) to
+  // get consistent performance results across platforms with different
   // number of ports but same ASIC, e.g. wedge400 and minipack
-  int numPortsToCollectStats = 48;
+  int numPortsToCollectStats = FLAGS_stats_collection_num_ports > 0
+      ? FLAGS_stats_collection_num_ports
+      : std::numeric_limits<int>::max();
   // route counters in hardware is currently limited to 255.
   // this is due to the fact that in some platforms, route class id
   // (8 bits) is overloaded to support counter id.
@@ -85,10 +98,15 @@ BENCHMARK(HwStatsCollection) {
   updater.program();
   SwitchStats dummy;
   suspender.dismiss();
+  auto begin = std::chrono::steady_clock::now();
   for (auto i = 0; i < 10'000; ++i) {
     hwSwitch->updateStats(&dummy);
   }
   suspender.rehire();
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - begin);
+  XLOG(INFO) << "Collected stats for " << ports.size() << " ports in "
+             << elapsed.count() / 10'000 << "us per pass";
 }
 
 } // namespace facebook::fboss
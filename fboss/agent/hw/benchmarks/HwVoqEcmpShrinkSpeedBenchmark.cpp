@@ -0,0 +1,164 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/EncapIndexAllocator.h"
+#include "fboss/agent/SwitchStats.h"
+#include "fboss/agent/hw/switch_asics/HwAsic.h"
+#include "fboss/agent/hw/test/ConfigFactory.h"
+#include "fboss/agent/hw/test/HwTestEcmpUtils.h"
+#include "fboss/agent/hw/test/HwTestPortUtils.h"
+#include "fboss/agent/state/Interface.h"
+#include "fboss/agent/state/InterfaceMap.h"
+#include "fboss/agent/state/SystemPort.h"
+#include "fboss/agent/state/SystemPortMap.h"
+#include "fboss/agent/test/EcmpSetupHelper.h"
+#include "fboss/lib/FunctionCallTimeReporter.h"
+
+#include <folly/Benchmark.h>
+#include <folly/IPAddress.h>
+
+#include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
+#include "fboss/agent/benchmarks/AgentBenchmarks.h"
+
+namespace facebook::fboss {
+
+using utility::getEcmpSizeInHw;
+
+namespace {
+constexpr int64_t kRemoteSwitchId = 2;
+constexpr int kNumRemoteSysPorts = 32;
+constexpr int kNumNeighborsPerRemoteRif = 128;
+
+/*
+ * Add remote system ports and rifs, with kNumNeighborsPerRemoteRif
+ * neighbors each, so that link down handling has to find the affected
+ * neighbors amongst a large neighbor table.
+ */
+std::shared_ptr<SwitchState> addRemoteNeighbors(
+    const std::shared_ptr<SwitchState>& in,
+    const HwAsic& asic,
+    const cfg::DsfNode& remoteNode) {
+  auto out = in->clone();
+  auto localPort = out->getSystemPorts()->cbegin()->second;
+  auto remoteSysPorts = out->getRemoteSystemPorts()->modify(&out);
+  auto remoteRifs = out->getRemoteInterfaces()->modify(&out);
+  std::optional<int64_t> encapIdx;
+  if (asic.isSupported(HwAsic::Feature::RESERVED_ENCAP_INDEX_RANGE)) {
+    encapIdx = *asic.getReservedEncapIndexRange().minimum() +
+        EncapIndexAllocator::kEncapIdxReservedForLoopbacks;
+  }
+  auto firstSysPortId = *remoteNode.systemPortRange()->minimum() + 1;
+  for (auto i = 0; i < kNumRemoteSysPorts; ++i) {
+    SystemPortID sysPortId(firstSysPortId + i);
+    auto remoteSysPort = std::make_shared<SystemPort>(sysPortId);
+    remoteSysPort->setSwitchId(SwitchID(kRemoteSwitchId));
+    remoteSysPort->setNumVoqs(localPort->getNumVoqs());
+    remoteSysPort->setCoreIndex(localPort->getCoreIndex());
+    remoteSysPort->setCorePortIndex(localPort->getCorePortIndex());
+    remoteSysPort->setSpeedMbps(localPort->getSpeedMbps());
+    remoteSysPort->setEnabled(true);
+    remoteSysPorts->addSystemPort(remoteSysPort);
+
+    InterfaceID intfId(static_cast<int>(sysPortId));
+    auto subnet = folly::IPAddressV6(folly::sformat("{:x}::", 0x1000 + i));
+    auto remoteRif = std::make_shared<Interface>(
+        intfId,
+        RouterID(0),
+        std::optional<VlanID>(std::nullopt),
+        folly::StringPiece("RemoteIntf"),
+        folly::MacAddress("c6:ca:2b:2a:b1:b6"),
+        9000,
+        false,
+        false,
+        cfg::InterfaceType::SYSTEM_PORT);
+    auto intfIp = subnet.toByteArray();
+    intfIp[15] = 1;
+    remoteRif->setAddresses({{folly::IPAddressV6(intfIp), 64}});
+    state::NeighborEntries ndpTable;
+    for (auto j = 0; j < kNumNeighborsPerRemoteRif; ++j) {
+      auto nbrIp = subnet.toByteArray();
+      nbrIp[14] = (j + 2) >> 8;
+      nbrIp[15] = (j + 2) & 0xff;
+      state::NeighborEntryFields ndp;
+      ndp.mac() = "02:03:04:05:06:07";
+      ndp.ipaddress() = folly::IPAddressV6(nbrIp).str();
+      ndp.portId() = PortDescriptor(sysPortId).toThrift();
+      ndp.interfaceId() = static_cast<int>(intfId);
+      ndp.state() = state::NeighborState::Reachable;
+      if (encapIdx) {
+        ndp.encapIndex() = (*encapIdx)++;
+      }
+      ndp.isLocal() = false;
+      ndpTable.insert({*ndp.ipaddress(), ndp});
+    }
+    remoteRif->setNdpTable(ndpTable);
+    remoteRifs->addInterface(remoteRif);
+  }
+  return out;
+}
+} // namespace
+
+BENCHMARK(HwVoqEcmpGroupShrink) {
+  folly::BenchmarkSuspender suspender;
+  constexpr int kEcmpWidth = 4;
+  AgentEnsembleSwitchConfigFn initialConfigFn =
+      [](HwSwitch* hwSwitch, const std::vector<PortID>& ports) {
+        auto config = utility::onePortPerInterfaceConfig(hwSwitch, ports);
+        auto remoteNode = utility::dsfNodeConfig(
+            *hwSwitch->getPlatform()->getAsic(), kRemoteSwitchId);
+        config.dsfNodes()->insert({*remoteNode.switchId(), remoteNode});
+        return config;
+      };
+  auto ensemble = createAgentEnsemble(initialConfigFn);
+  auto hwSwitch = ensemble->getHw();
+  CHECK(hwSwitch->getSwitchType() == cfg::SwitchType::VOQ)
+      << "VOQ ecmp shrink benchmark needs a VOQ switch";
+  const auto& asic = *hwSwitch->getPlatform()->getAsic();
+  ensemble->applyNewState(addRemoteNeighbors(
+      ensemble->getSw()->getState(),
+      asic,
+      utility::dsfNodeConfig(asic, kRemoteSwitchId)));
+
+  auto ecmpHelper = utility::EcmpSetupAnyNPorts6(ensemble->getSw()->getState());
+  ensemble->applyNewState(
+      ecmpHelper.resolveNextHops(ensemble->getSw()->getState(), kEcmpWidth));
+  ecmpHelper.programRoutes(
+      std::make_unique<SwSwitchRouteUpdateWrapper>(
+          ensemble->getSw(), ensemble->getSw()->getRib()),
+      kEcmpWidth);
+  auto prefix = folly::CIDRNetwork(folly::IPAddress("::"), 0);
+  CHECK_EQ(
+      kEcmpWidth,
+      getEcmpSizeInHw(hwSwitch, prefix, ecmpHelper.getRouterId(), kEcmpWidth));
+  // Warm up the stats cache
+  SwitchStats dummy{};
+  ensemble->getHw()->updateStats(&dummy);
+
+  // Same as HwEcmpGroupShrink, but with kNumRemoteSysPorts *
+  // kNumNeighborsPerRemoteRif remote neighbors programmed, none of which
+  // are on the port being brought down.
+  utility::setPortLoopbackMode(
+      hwSwitch,
+      ecmpHelper.nhop(0).portDesc.phyPortID(),
+      cfg::PortLoopbackMode::NONE);
+  {
+    ScopedCallTimer timeIt;
+    suspender.dismiss();
+    // Busy loop to see how soon after port down do we shrink ECMP group
+    while (getEcmpSizeInHw(
+               hwSwitch, prefix, ecmpHelper.getRouterId(), kEcmpWidth) !=
+           kEcmpWidth - 1) {
+      usleep(1);
+    }
+    suspender.rehire();
+  }
+}
+
+} // namespace facebook::fboss
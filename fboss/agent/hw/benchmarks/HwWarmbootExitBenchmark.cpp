@@ -29,6 +29,10 @@
 
 namespace facebook::fboss {
 
+/*
+ * Time warm boot exit at route scale. Run with
+ * --dump_json_switch_state=false to only write the binary switch state.
+ */
 void runBenchmark() {
   AgentEnsembleSwitchConfigFn initialConfig =
       [](HwSwitch* hwSwitch, const std::vector<PortID>& ports) {
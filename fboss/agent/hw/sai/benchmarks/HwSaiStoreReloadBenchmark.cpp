@@ -0,0 +1,68 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/Platform.h"
+#include "fboss/agent/hw/sai/store/SaiStore.h"
+#include "fboss/agent/hw/sai/switch/SaiSwitch.h"
+#include "fboss/agent/hw/test/ConfigFactory.h"
+#include "fboss/agent/test/RouteScaleGenerators.h"
+
+#include "fboss/agent/benchmarks/AgentBenchmarks.h"
+
+#include <folly/Benchmark.h>
+#include <folly/dynamic.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+
+namespace facebook::fboss {
+
+/*
+ * Reload a SaiStore from the adapter keys a warm booting agent would have
+ * saved, after programming FSW scale routes. This is the part of warm boot
+ * init that reads every object back from the adapter.
+ * Combine with --sai_store_reload_threads to compare serial and parallel
+ * reload.
+ */
+BENCHMARK(HwSaiStoreReload) {
+  folly::BenchmarkSuspender suspender;
+  AgentEnsembleSwitchConfigFn initialConfig =
+      [](HwSwitch* hwSwitch, const std::vector<PortID>& ports) {
+        return utility::onePortPerInterfaceConfig(hwSwitch, ports);
+      };
+  auto ensemble = createAgentEnsemble(initialConfig);
+  ensemble->programRoutes(
+      RouterID(0),
+      ClientID::BGPD,
+      utility::FSWRouteScaleGenerator(ensemble->getProgrammedState())
+          .getThriftRoutes());
+
+  auto saiSwitch = static_cast<SaiSwitch*>(ensemble->getHw());
+  auto adapterKeys = saiSwitch->getSaiStore()->adapterKeysFollyDynamic();
+  auto adapterKeys2AdapterHostKeys =
+      saiSwitch->getSaiStore()->adapterKeys2AdapterHostKeysFollyDynamic();
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor;
+  if (FLAGS_sai_store_reload_threads > 1) {
+    executor = std::make_unique<folly::CPUThreadPoolExecutor>(
+        FLAGS_sai_store_reload_threads,
+        std::make_shared<folly::NamedThreadFactory>("SaiStoreReload"));
+  }
+  {
+    // Everything reloaded only becomes a warm boot handle, which is released
+    // rather than removed when this store goes away. So the objects
+    // programmed by the ensemble are left untouched.
+    SaiStore reloadedStore(saiSwitch->getSaiSwitchId());
+    suspender.dismiss();
+    reloadedStore.reload(
+        &adapterKeys, &adapterKeys2AdapterHostKeys, executor.get());
+    suspender.rehire();
+  }
+}
+
+} // namespace facebook::fboss
@@ -10,6 +10,9 @@
 
 #include "fboss/agent/hw/sai/store/SaiStore.h"
 
+#include <chrono>
+#include <optional>
+
 namespace facebook::fboss {
 
 SaiStore::SaiStore() {}
@@ -26,19 +29,68 @@ void SaiStore::setSwitchId(sai_object_id_t switchId) {
 
 void SaiStore::reload(
     const folly::dynamic* adapterKeysJson,
-    const folly::dynamic* adapterKeys2AdapterHostKeyJson) {
-  tupleForEach(
-      [adapterKeysJson, adapterKeys2AdapterHostKeyJson](auto& store) {
+    const folly::dynamic* adapterKeys2AdapterHostKeyJson,
+    folly::Executor* executor) {
+  auto reloadStart = std::chrono::steady_clock::now();
+  // Start reading all object types from the adapter before adding any of
+  // them to their stores, so that with an executor the reads of independent
+  // object types overlap.
+  auto fetches = tupleMap(
+      [adapterKeysJson, adapterKeys2AdapterHostKeyJson, executor](
+          auto& store) {
         const folly::dynamic* adapterKeys = adapterKeysJson
             ? adapterKeysJson->get_ptr(store.objectTypeName())
             : nullptr;
         const folly::dynamic* adapterHostKeys = adapterKeys2AdapterHostKeyJson
             ? adapterKeys2AdapterHostKeyJson->get_ptr(store.objectTypeName())
             : nullptr;
-
-        store.reload(adapterKeys, adapterHostKeys);
+        return folly::makeSemiFutureWith([&]() {
+          return store.fetchObjects(adapterKeys, adapterHostKeys, executor);
+        });
+      },
+      stores_);
+  // Objects that were fetched are always added to their store, even if
+  // reloading some other object type failed. Dropping them would remove
+  // them from the adapter.
+  std::optional<folly::exception_wrapper> error;
+  tupleForEach(
+      [&fetches, &error](auto& store) {
+        using FetchedObjects =
+            typename std::decay_t<decltype(store)>::FetchedObjects;
+        auto fetched =
+            std::move(std::get<folly::SemiFuture<FetchedObjects>>(fetches))
+                .getTry();
+        if (fetched.hasException()) {
+          if (!error) {
+            error = fetched.exception();
+          }
+          return;
+        }
+        auto numObjects = fetched->objects.size();
+        auto fetchTime = fetched->fetchTime;
+        auto addStart = std::chrono::steady_clock::now();
+        store.addFetchedObjects(std::move(fetched).value());
+        if (numObjects) {
+          XLOGF(
+              DBG2,
+              "SaiStore reloaded {} {} objects, fetch: {}us add: {}us",
+              numObjects,
+              store.objectTypeName(),
+              fetchTime.count(),
+              std::chrono::duration_cast<std::chrono::microseconds>(
+                  std::chrono::steady_clock::now() - addStart)
+                  .count());
+        }
       },
       stores_);
+  if (error) {
+    error->throw_exception();
+  }
+  XLOG(DBG2) << "SaiStore reload took "
+             << std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - reloadStart)
+                    .count()
+             << "ms";
 }
 
 void SaiStore::release() {
@@ -24,8 +24,12 @@
 #include "fboss/agent/hw/sai/store/Traits.h"
 #include "fboss/lib/RefMap.h"
 
+#include <folly/Executor.h>
 #include <folly/dynamic.h>
+#include <folly/futures/Future.h>
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
 #include <optional>
 #include <sstream>
@@ -139,33 +143,88 @@ class SaiObjectStore {
     return obj;
   }
 
+  /*
+   * Objects read from the adapter by fetchObjects, to be added to the store
+   * by addFetchedObjects.
+   */
+  struct FetchedObjects {
+    std::vector<ObjectType> objects;
+    // Time spent in the adapter reading the objects, summed over chunks
+    std::chrono::microseconds fetchTime{0};
+  };
+
   void reload(
       const folly::dynamic* adapterKeysJson,
       const folly::dynamic* adapterKeys2AdapterHostKey) {
+    addFetchedObjects(
+        fetchObjects(adapterKeysJson, adapterKeys2AdapterHostKey, nullptr)
+            .get());
+  }
+
+  /*
+   * Read the attributes of every object of this type from the adapter.
+   * Without an executor this is done inline. With one, the adapter keys are
+   * split in chunks of kReloadChunkSize which are read concurrently. SAI
+   * calls still serialize on SaiApiLock unless the adapter is thread safe.
+   * The store itself is not touched until addFetchedObjects, so fetches of
+   * different object types may run concurrently too.
+   */
+  folly::SemiFuture<FetchedObjects> fetchObjects(
+      const folly::dynamic* adapterKeysJson,
+      const folly::dynamic* adapterKeys2AdapterHostKey,
+      folly::Executor* executor) {
     if (!switchId_) {
       XLOG(FATAL)
           << "Attempted to reload() on a SaiObjectStore without a switchId";
     }
-    auto keys = getAdapterKeys(adapterKeysJson);
-    if constexpr (SaiObjectHasConditionalAttributes<SaiObjectTraits>::value) {
-      keys.erase(
-          std::remove_if(
-              keys.begin(),
-              keys.end(),
-              [](auto key) {
-                auto conditionAttributes =
-                    SaiApiTable::getInstance()
-                        ->getApi<typename SaiObjectTraits::SaiApiT>()
-                        .getAttribute(
-                            key,
-                            typename SaiObjectTraits::ConditionAttributes{});
-                return conditionAttributes !=
-                    SaiObjectTraits::kConditionAttributes;
-              }),
-          keys.end());
+    auto keys = std::make_shared<
+        const std::vector<typename SaiObjectTraits::AdapterKey>>(
+        getAdapterKeys(adapterKeysJson));
+    if (!executor) {
+      return folly::makeSemiFuture(
+          fetchChunk(*keys, 0, keys->size(), adapterKeys2AdapterHostKey));
+    }
+    std::vector<folly::SemiFuture<FetchedObjects>> chunks;
+    for (size_t begin = 0; begin < keys->size(); begin += kReloadChunkSize) {
+      auto end = std::min(keys->size(), begin + kReloadChunkSize);
+      chunks.push_back(
+          folly::via(
+              executor,
+              [this, keys, begin, end, adapterKeys2AdapterHostKey]() {
+                return fetchChunk(
+                    *keys, begin, end, adapterKeys2AdapterHostKey);
+              })
+              .semi());
     }
-    for (const auto k : keys) {
-      ObjectType obj = getObject(k, adapterKeys2AdapterHostKey);
+    return folly::collectAll(std::move(chunks))
+        .deferValue([](std::vector<folly::Try<FetchedObjects>>&& results) {
+          FetchedObjects fetched;
+          std::optional<folly::exception_wrapper> error;
+          for (auto& result : results) {
+            if (result.hasException()) {
+              if (!error) {
+                error = result.exception();
+              }
+              continue;
+            }
+            fetched.fetchTime += result->fetchTime;
+            for (auto& object : result->objects) {
+              fetched.objects.push_back(std::move(object));
+            }
+          }
+          if (error) {
+            // Don't remove the objects read by the other chunks
+            for (auto& object : fetched.objects) {
+              object.release();
+            }
+            error->throw_exception();
+          }
+          return fetched;
+        });
+  }
+
+  void addFetchedObjects(FetchedObjects&& fetched) {
+    for (auto& obj : fetched.objects) {
       auto adapterHostKey = obj.adapterHostKey();
       XLOGF(DBG5, "SaiStore reloaded {}", obj);
       auto ins = objects_.refOrInsert(adapterHostKey, std::move(obj));
@@ -418,6 +477,45 @@ class SaiObjectStore {
   }
 
  private:
+  static constexpr size_t kReloadChunkSize = 1024;
+
+  FetchedObjects fetchChunk(
+      const std::vector<typename SaiObjectTraits::AdapterKey>& keys,
+      size_t begin,
+      size_t end,
+      const folly::dynamic* adapterKeys2AdapterHostKey) {
+    auto start = std::chrono::steady_clock::now();
+    FetchedObjects fetched;
+    fetched.objects.reserve(end - begin);
+    try {
+      for (auto i = begin; i < end; ++i) {
+        if constexpr (SaiObjectHasConditionalAttributes<
+                          SaiObjectTraits>::value) {
+          auto conditionAttributes =
+              SaiApiTable::getInstance()
+                  ->getApi<typename SaiObjectTraits::SaiApiT>()
+                  .getAttribute(
+                      keys[i],
+                      typename SaiObjectTraits::ConditionAttributes{});
+          if (conditionAttributes != SaiObjectTraits::kConditionAttributes) {
+            continue;
+          }
+        }
+        fetched.objects.push_back(
+            getObject(keys[i], adapterKeys2AdapterHostKey));
+      }
+    } catch (const std::exception&) {
+      // Don't remove the objects already read from the adapter
+      for (auto& object : fetched.objects) {
+        object.release();
+      }
+      throw;
+    }
+    fetched.fetchTime = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    return fetched;
+  }
+
   ObjectType getObject(
       typename ObjectTraits::AdapterKey key,
       const folly::dynamic* adapterKey2AdapterHostKey) {
@@ -534,10 +632,13 @@ class SaiStore {
 
   /*
    * Reload the SaiStore from the current SAI state via SAI api calls.
+   * If an executor is passed, objects are read from the adapter
+   * concurrently, both across object types and in chunks within a type.
    */
   void reload(
       const folly::dynamic* adapterKeys = nullptr,
-      const folly::dynamic* adapterKeys2AdapterHostKey = nullptr);
+      const folly::dynamic* adapterKeys2AdapterHostKey = nullptr,
+      folly::Executor* executor = nullptr);
 
   /*
    *
@@ -15,6 +15,8 @@
 #include "fboss/agent/hw/sai/store/SaiStore.h"
 #include "fboss/agent/hw/sai/store/tests/SaiStoreTest.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
 using namespace facebook::fboss;
 
 TEST_F(SaiStoreTest, loadRoute) {
@@ -235,3 +237,41 @@ TEST_F(SaiStoreTest, toStrV6Route) {
 
   verifyToStr<SaiRouteTraits>();
 }
+
+TEST_F(SaiStoreTest, parallelReloadRoutes) {
+  auto& routeApi = saiApiTable->routeApi();
+  SaiRouteTraits::Attributes::PacketAction packetActionAttribute{
+      SAI_PACKET_ACTION_FORWARD};
+  SaiRouteTraits::Attributes::NextHopId nextHopIdAttribute(5);
+  // Enough routes to be reloaded in several chunks
+  constexpr int kNumRoutes = 3000;
+  std::vector<SaiRouteTraits::RouteEntry> routes;
+  for (int i = 0; i < kNumRoutes; ++i) {
+    auto ip = folly::IPAddressV6("42::").toByteArray();
+    ip[6] = i >> 8;
+    ip[7] = i & 0xff;
+    SaiRouteTraits::RouteEntry r(
+        0, 0, folly::CIDRNetwork(folly::IPAddressV6(ip), 64));
+    SaiRouteTraits::Attributes::Metadata metadata(i);
+    routeApi.create<SaiRouteTraits>(
+        r,
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+        { packetActionAttribute, nextHopIdAttribute, metadata, std::nullopt }
+#else
+        { packetActionAttribute, nextHopIdAttribute, metadata }
+#endif
+    );
+    routes.push_back(r);
+  }
+
+  folly::CPUThreadPoolExecutor executor(4);
+  saiStore->setSwitchId(0);
+  saiStore->reload(nullptr, nullptr, &executor);
+  auto& store = saiStore->get<SaiRouteTraits>();
+  EXPECT_EQ(store.size(), kNumRoutes);
+  for (int i = 0; i < kNumRoutes; ++i) {
+    auto got = store.get(routes[i]);
+    ASSERT_NE(got, nullptr);
+    EXPECT_EQ(GET_OPT_ATTR(Route, Metadata, got->attributes()), uint32_t(i));
+  }
+}
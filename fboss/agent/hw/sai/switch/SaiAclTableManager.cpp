@@ -1047,6 +1047,24 @@ void SaiAclTableManager::changedAclEntry(
    * Thus, remove and re-add.
    */
   XLOG(DBG2) << "changing acl entry " << oldAclEntry->getID();
+  /*
+   * When moving to a free priority, add at the new priority before removing
+   * the old entry so that matching traffic never goes without one. Not for
+   * entries with counters, since removing the old entry would stop
+   * collecting stats of the counter the new one shares.
+   */
+  auto aclTableHandle = getAclTableHandle(aclTableName);
+  auto oldAction = oldAclEntry->getAclAction();
+  auto newAction = newAclEntry->getAclAction();
+  if (aclTableHandle &&
+      oldAclEntry->getPriority() != newAclEntry->getPriority() &&
+      !getAclEntryHandle(aclTableHandle, newAclEntry->getPriority()) &&
+      !(oldAction && oldAction->cref<switch_state_tags::trafficCounter>()) &&
+      !(newAction && newAction->cref<switch_state_tags::trafficCounter>())) {
+    addAclEntry(newAclEntry, aclTableName);
+    removeAclEntry(oldAclEntry, aclTableName);
+    return;
+  }
   removeAclEntry(oldAclEntry, aclTableName);
   addAclEntry(newAclEntry, aclTableName);
 }
@@ -141,6 +141,9 @@ void SaiNeighborManager::addNeighbor(
       swEntry->getIsLocal(),
       saiRouterIntf->type());
 
+  if (saiRouterIntf->type() == cfg::InterfaceType::SYSTEM_PORT) {
+    portToNeighbors_[saiPortDesc].emplace(subscriberKey);
+  }
   neighbors_.emplace(subscriberKey, std::move(neighbor));
   XLOG(DBG2) << "Add Neighbor: create neighbor" << swEntry->str();
 }
@@ -154,15 +157,27 @@ void SaiNeighborManager::removeNeighbor(
   }
   XLOG(DBG2) << "removeNeighbor " << swEntry->getIP();
   auto subscriberKey = saiEntryFromSwEntry(swEntry);
-  if (neighbors_.find(subscriberKey) == neighbors_.end()) {
+  auto itr = neighbors_.find(subscriberKey);
+  if (itr == neighbors_.end()) {
     throw FbossError(
         "Attempted to remove non-existent neighbor: ", swEntry->getIP());
   }
-  neighbors_.erase(subscriberKey);
+  if (itr->second->getRifType() == cfg::InterfaceType::SYSTEM_PORT) {
+    auto portToNeighborsItr =
+        portToNeighbors_.find(itr->second->getSaiPortDesc());
+    if (portToNeighborsItr != portToNeighbors_.end()) {
+      portToNeighborsItr->second.erase(subscriberKey);
+      if (portToNeighborsItr->second.empty()) {
+        portToNeighbors_.erase(portToNeighborsItr);
+      }
+    }
+  }
+  neighbors_.erase(itr);
   XLOG(DBG2) << "Remove Neighbor: " << swEntry->str();
 }
 
 void SaiNeighborManager::clear() {
+  portToNeighbors_.clear();
   neighbors_.clear();
 }
 
@@ -391,13 +406,16 @@ void PortRifNeighbor::handleLinkDown() {
 
 void SaiNeighborManager::handleLinkDown(const SaiPortDescriptor& port) {
   CHECK(platform_->getAsic()->getSwitchType() == cfg::SwitchType::VOQ);
-  for (auto& [nbrEntry, neighbor] : neighbors_) {
-    if (neighbor->getRifType() != cfg::InterfaceType::SYSTEM_PORT) {
-      continue;
-    }
-    if (neighbor->getSaiPortDesc() == port) {
-      neighbor->handleLinkDown();
-    }
+  auto portToNeighborsItr = portToNeighbors_.find(port);
+  if (portToNeighborsItr == portToNeighbors_.end()) {
+    return;
+  }
+  for (const auto& nbrEntry : portToNeighborsItr->second) {
+    auto itr = neighbors_.find(nbrEntry);
+    CHECK(itr != neighbors_.end())
+        << "no neighbor found for entry in portToNeighbors_ mapping: "
+        << nbrEntry.toString();
+    itr->second->handleLinkDown();
   }
 }
 
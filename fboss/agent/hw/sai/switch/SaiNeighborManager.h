@@ -19,6 +19,7 @@
 #include "fboss/agent/types.h"
 
 #include "folly/container/F14Map.h"
+#include "folly/container/F14Set.h"
 
 #include <fmt/format.h>
 #include <memory>
@@ -220,6 +221,11 @@ class SaiNeighborManager {
       SaiNeighborTraits::NeighborEntry,
       std::unique_ptr<SaiNeighborEntry>>
       neighbors_;
+  // System port rif neighbors by port, for handling link down
+  folly::F14FastMap<
+      SaiPortDescriptor,
+      folly::F14FastSet<SaiNeighborTraits::NeighborEntry>>
+      portToNeighbors_;
 };
 
 } // namespace facebook::fboss
@@ -1208,7 +1208,14 @@ void SaiPortManager::updateStats(PortID portId, bool updateWatermarks) {
   managerTable_->macsecManager().updateStats(portId, curPortStats);
   managerTable_->bufferManager().updateIngressPriorityGroupStats(
       portId, *curPortStats.portName_(), updateWatermarks);
-  portStats_[portId]->updateStats(curPortStats, now);
+  portStatItr->second->updateStats(curPortStats, now);
+}
+
+void SaiPortManager::prepareUpdateStats(PortID portId) {
+  if (handles_.find(portId) == handles_.end()) {
+    return;
+  }
+  supportedStats(portId);
 }
 
 const std::vector<sai_stat_id_t>& SaiPortManager::supportedStats(PortID port) {
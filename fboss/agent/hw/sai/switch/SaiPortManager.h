@@ -169,6 +169,9 @@ class SaiPortManager {
       cfg::SwitchType switchType) const;
 
   void updateStats(PortID portID, bool updateWatermarks = false);
+  // Fills in the per port state updateStats would otherwise create on
+  // first use, so that updateStats can then run for several ports at once.
+  void prepareUpdateStats(PortID portID);
 
   void clearStats(PortID portID);
 
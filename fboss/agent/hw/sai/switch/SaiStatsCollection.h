@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#pragma once
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/futures/Future.h>
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * Update stats of each object in objectIds under the switch lock.
+ *
+ * Serially, the lock is taken for every object, as before. With an
+ * executor, objects are updated in batches of one object per stats
+ * collection thread: the lock is taken once for a batch and the objects of
+ * the batch are updated concurrently, so programming is still held off for
+ * no longer than a single object update while a full pass takes a fraction
+ * of the time. The updates passed in must be independent of each other,
+ * i.e. only touch their own SAI objects and counters. prepareFn is run for
+ * every object of a batch before any update of the batch is dispatched, to
+ * create the shared state updateFn would otherwise create lazily.
+ */
+template <typename ObjectId>
+void updateObjectStats(
+    std::mutex& saiSwitchMutex,
+    folly::CPUThreadPoolExecutor* executor,
+    const std::vector<ObjectId>& objectIds,
+    const std::function<void(ObjectId)>& updateFn,
+    const std::function<void(ObjectId)>& prepareFn = nullptr) {
+  if (!executor) {
+    for (auto objectId : objectIds) {
+      std::lock_guard<std::mutex> locked(saiSwitchMutex);
+      updateFn(objectId);
+    }
+    return;
+  }
+  auto batchSize = executor->numThreads();
+  for (size_t start = 0; start < objectIds.size(); start += batchSize) {
+    auto end = std::min(objectIds.size(), start + batchSize);
+    std::lock_guard<std::mutex> locked(saiSwitchMutex);
+    if (prepareFn) {
+      for (auto i = start; i < end; ++i) {
+        prepareFn(objectIds[i]);
+      }
+    }
+    std::vector<folly::Future<folly::Unit>> updates;
+    for (auto i = start; i < end; ++i) {
+      updates.push_back(folly::via(executor, [&updateFn, &objectIds, i]() {
+        updateFn(objectIds[i]);
+      }));
+    }
+    // Wait for every update of the batch before dropping the lock, even
+    // if one of them failed.
+    for (auto& update : folly::collectAll(std::move(updates)).get()) {
+      update.value();
+    }
+  }
+}
+
+} // namespace facebook::fboss
@@ -63,6 +63,7 @@
 #include "fboss/agent/state/SwitchState.h"
 
 #include "fboss/agent/hw/HwSwitchWarmBootHelper.h"
+#include "fboss/agent/hw/StateDeltaScheduler.h"
 #include "fboss/agent/hw/UnsupportedFeatureManager.h"
 #include "fboss/agent/hw/switch_asics/HwAsic.h"
 #include "folly/MacAddress.h"
@@ -70,10 +71,12 @@
 #include "fboss/lib/phy/PhyUtils.h"
 #include "fboss/lib/phy/gen-cpp2/phy_types.h"
 
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 #include <folly/logging/xlog.h>
 
 #include <chrono>
 #include <optional>
+#include <type_traits>
 
 extern "C" {
 #include <sai.h>
@@ -109,6 +112,36 @@ DEFINE_bool(
     false,
     "force recreate acl tables during warmboot.");
 
+DEFINE_int32(
+    sai_stats_collection_threads,
+    1,
+    "Number of threads collecting port, system port and LAG stats. Values "
+    "above 1 read stats of several objects concurrently and require an "
+    "adapter whose stats APIs are thread safe.");
+
+DEFINE_int32(
+    sai_store_reload_threads,
+    1,
+    "Number of threads reading SAI objects from the adapter when reloading "
+    "the SaiStore, e.g. on warm boot. Values above 1 reload object types, "
+    "and chunks of objects within a type, concurrently. This only speeds up "
+    "reload with an adapter whose get attribute APIs are thread safe.");
+
+DEFINE_int32(
+    sai_state_delta_threads,
+    1,
+    "Number of threads programming a state delta. Values above 1 walk "
+    "independent sections of the delta, e.g. routes of different VRFs and "
+    "address families, mirrors and ACLs, concurrently. Every delta entry is "
+    "still programmed under the switch lock, so only walking the deltas "
+    "overlaps. SAI calls stay serial even with a thread safe adapter.");
+
+DEFINE_int32(
+    sai_state_delta_route_chunk_size,
+    4096,
+    "Minimum number of routes per chunk when a route delta is walked in "
+    "concurrent chunks, see --sai_state_delta_threads.");
+
 namespace {
 /*
  * For the devices/SDK we use, the only events we should get (and process)
@@ -713,84 +746,140 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImpl(
         &SaiFdbManager::removeMac);
   }
 
-  auto processV4RoutesDelta = [this, &lockPolicy](
-                                  RouterID rid, const auto& routesDelta) {
-    processDelta(
-        routesDelta,
-        managerTable_->routeManager(),
-        lockPolicy,
-        &SaiRouteManager::changeRoute<folly::IPAddressV4>,
-        &SaiRouteManager::addRoute<folly::IPAddressV4>,
-        &SaiRouteManager::removeRoute<folly::IPAddressV4>,
-        rid);
-  };
-
-  auto processV6RoutesDelta = [this, &lockPolicy](
-                                  RouterID rid, const auto& routesDelta) {
-    processDelta(
-        routesDelta,
-        managerTable_->routeManager(),
-        lockPolicy,
-        &SaiRouteManager::changeRoute<folly::IPAddressV6>,
-        &SaiRouteManager::addRoute<folly::IPAddressV6>,
-        &SaiRouteManager::removeRoute<folly::IPAddressV6>,
-        rid);
-  };
+  /*
+   * Sections below only depend on the ports, interfaces and neighbors
+   * programmed above, and on each other as declared. With fine grained
+   * locking each delta entry is programmed under saiSwitchMutex_, so they
+   * may run concurrently, see --sai_state_delta_threads. That lock
+   * serializes every manager and SAI call, only the delta walks overlap.
+   */
+  folly::Executor* executor = nullptr;
+  if constexpr (std::is_same_v<LockPolicyT, FineGrainedLockPolicy>) {
+    executor = getStateDeltaExecutor();
+  }
+  StateDeltaScheduler scheduler(executor);
 
-  for (const auto& routeDelta : delta.getFibsDelta()) {
+  /*
+   * Route deltas are the largest by far, and route entries independent of
+   * each other, so they are further split into chunks of prefixes. As
+   * above, chunks only overlap walking the delta, not programming routes.
+   */
+  auto maxRouteChunks =
+      executor ? static_cast<size_t>(FLAGS_sai_state_delta_threads) : 1;
+  auto addRouteSections = [&](const auto& routeDelta, auto addr) {
+    using AddrT = decltype(addr);
     auto routerID = routeDelta.getOld() ? routeDelta.getOld()->getID()
                                         : routeDelta.getNew()->getID();
-    processV4RoutesDelta(
-        routerID, routeDelta.getFibDelta<folly::IPAddressV4>());
-    processV6RoutesDelta(
-        routerID, routeDelta.getFibDelta<folly::IPAddressV6>());
+    auto chunks = routeDelta.template getFibDelta<AddrT>().getChunks(
+        maxRouteChunks, FLAGS_sai_state_delta_route_chunk_size);
+    for (size_t i = 0; i < chunks.size(); ++i) {
+      scheduler.addSection(
+          folly::to<std::string>(
+              std::is_same_v<AddrT, folly::IPAddressV4> ? "v4" : "v6",
+              " routes, vrf ",
+              routerID,
+              ", chunk ",
+              i),
+          [this, &lockPolicy, routerID, chunk = std::move(chunks[i])]() {
+            processDelta(
+                chunk,
+                managerTable_->routeManager(),
+                lockPolicy,
+                &SaiRouteManager::changeRoute<AddrT>,
+                &SaiRouteManager::addRoute<AddrT>,
+                &SaiRouteManager::removeRoute<AddrT>,
+                routerID);
+          });
+    }
+  };
+  for (const auto& routeDelta : delta.getFibsDelta()) {
+    addRouteSections(routeDelta, folly::IPAddressV4());
+    addRouteSections(routeDelta, folly::IPAddressV6());
   }
-  {
+  scheduler.addSection("control plane", [this, &delta, &lockPolicy]() {
     auto controlPlaneDelta = delta.getControlPlaneDelta();
     if (*controlPlaneDelta.getOld() != *controlPlaneDelta.getNew()) {
       [[maybe_unused]] const auto& lock = lockPolicy.lock();
       managerTable_->hostifManager().processHostifDelta(controlPlaneDelta);
     }
-  }
+  });
 
   if (platform_->getAsic()->isSupported(HwAsic::Feature::SAI_MPLS_INSEGMENT)) {
-    processDelta(
-        delta.getLabelForwardingInformationBaseDelta(),
-        managerTable_->inSegEntryManager(),
-        lockPolicy,
-        &SaiInSegEntryManager::processChangedInSegEntry,
-        &SaiInSegEntryManager::processAddedInSegEntry,
-        &SaiInSegEntryManager::processRemovedInSegEntry);
+    scheduler.addSection("mpls", [this, &delta, &lockPolicy]() {
+      processDelta(
+          delta.getLabelForwardingInformationBaseDelta(),
+          managerTable_->inSegEntryManager(),
+          lockPolicy,
+          &SaiInSegEntryManager::processChangedInSegEntry,
+          &SaiInSegEntryManager::processAddedInSegEntry,
+          &SaiInSegEntryManager::processRemovedInSegEntry);
+    });
   }
 
-  processDelta(
-      delta.getLoadBalancersDelta(),
-      managerTable_->switchManager(),
-      lockPolicy,
-      &SaiSwitchManager::changeLoadBalancer,
-      &SaiSwitchManager::addOrUpdateLoadBalancer,
-      &SaiSwitchManager::removeLoadBalancer);
+  scheduler.addSection("load balancers", [this, &delta, &lockPolicy]() {
+    processDelta(
+        delta.getLoadBalancersDelta(),
+        managerTable_->switchManager(),
+        lockPolicy,
+        &SaiSwitchManager::changeLoadBalancer,
+        &SaiSwitchManager::addOrUpdateLoadBalancer,
+        &SaiSwitchManager::removeLoadBalancer);
+  });
 
   /*
    * Add/update mirrors before processing ACL, as ACLs with action
    * INGRESS/EGRESS Mirror rely on the Mirror being created.
    */
-  processDelta(
-      delta.getMirrorsDelta(),
-      managerTable_->mirrorManager(),
-      lockPolicy,
-      &SaiMirrorManager::changeMirror,
-      &SaiMirrorManager::addMirror,
-      &SaiMirrorManager::removeMirror);
+  auto mirrors = scheduler.addSection("mirrors", [this, &delta, &lockPolicy]() {
+    processDelta(
+        delta.getMirrorsDelta(),
+        managerTable_->mirrorManager(),
+        lockPolicy,
+        &SaiMirrorManager::changeMirror,
+        &SaiMirrorManager::addMirror,
+        &SaiMirrorManager::removeMirror);
+  });
 
-  processDelta(
-      delta.getIpTunnelsDelta(),
-      managerTable_->tunnelManager(),
-      lockPolicy,
-      &SaiTunnelManager::changeTunnel,
-      &SaiTunnelManager::addTunnel,
-      &SaiTunnelManager::removeTunnel);
+  scheduler.addSection("tunnels", [this, &delta, &lockPolicy]() {
+    processDelta(
+        delta.getIpTunnelsDelta(),
+        managerTable_->tunnelManager(),
+        lockPolicy,
+        &SaiTunnelManager::changeTunnel,
+        &SaiTunnelManager::addTunnel,
+        &SaiTunnelManager::removeTunnel);
+  });
+
+  scheduler.addSection(
+      "acls",
+      [this, &delta, &lockPolicy]() { processAclDelta(delta, lockPolicy); },
+      {mirrors});
+
+  scheduler.run();
+  if (platform_->getAsic()->isSupported(
+          HwAsic::Feature::RESOURCE_USAGE_STATS)) {
+    updateResourceUsage(lockPolicy);
+  }
+
+  // Process link state change delta and update the LED status
+  processLinkStateChangeDelta(delta, lockPolicy);
+
+  return delta.newState();
+}
+
+folly::Executor* SaiSwitch::getStateDeltaExecutor() {
+  if (!stateDeltaExecutor_ && FLAGS_sai_state_delta_threads > 1) {
+    stateDeltaExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        FLAGS_sai_state_delta_threads,
+        std::make_shared<folly::NamedThreadFactory>("SaiStateDelta"));
+  }
+  return stateDeltaExecutor_.get();
+}
 
+template <typename LockPolicyT>
+void SaiSwitch::processAclDelta(
+    const StateDelta& delta,
+    const LockPolicyT& lockPolicy) {
   bool multipleAclTableSupport =
       platform_->getAsic()->isSupported(HwAsic::Feature::MULTIPLE_ACL_TABLES);
 #if defined(TAJO_SDK_VERSION_1_42_1) || defined(TAJO_SDK_VERSION_1_42_8)
@@ -863,6 +952,7 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImpl(
       // qualifiers changed and default acl table doesn't support all of them,
       // remove default acl table and add a new one. table removal should
       // clear acl entries too
+      [[maybe_unused]] const auto& lock = lockPolicy.lock();
       managerTable_->switchManager().resetIngressAcl();
       managerTable_->aclTableManager().removeDefaultAclTable();
       managerTable_->aclTableManager().addDefaultAclTable();
@@ -878,16 +968,6 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImpl(
         &SaiAclTableManager::removeAclEntry,
         kAclTable1);
   }
-
-  if (platform_->getAsic()->isSupported(
-          HwAsic::Feature::RESOURCE_USAGE_STATS)) {
-    updateResourceUsage(lockPolicy);
-  }
-
-  // Process link state change delta and update the LED status
-  processLinkStateChangeDelta(delta, lockPolicy);
-
-  return delta.newState();
 }
 
 template <typename LockPolicyT>
@@ -1826,7 +1906,15 @@ void SaiSwitch::initStoreAndManagersLocked(
     const folly::dynamic* adapterKeys,
     const folly::dynamic* adapterKeys2AdapterHostKeys) {
   saiStore_->setSwitchId(switchId_);
-  saiStore_->reload(adapterKeys, adapterKeys2AdapterHostKeys);
+  if (FLAGS_sai_store_reload_threads > 1) {
+    folly::CPUThreadPoolExecutor reloadExecutor(
+        FLAGS_sai_store_reload_threads,
+        std::make_shared<folly::NamedThreadFactory>("SaiStoreReload"));
+    saiStore_->reload(
+        adapterKeys, adapterKeys2AdapterHostKeys, &reloadExecutor);
+  } else {
+    saiStore_->reload(adapterKeys, adapterKeys2AdapterHostKeys);
+  }
   managerTable_->createSaiTableManagers(
       saiStore_.get(), platform_, concurrentIndices_.get());
   /*
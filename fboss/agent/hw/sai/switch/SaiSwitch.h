@@ -20,6 +20,7 @@
 #include "fboss/agent/platforms/sai/SaiPlatform.h"
 #include "folly/MacAddress.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/io/async/EventBase.h>
 #include "fboss/agent/hw/switch_asics/HwAsic.h"
 
@@ -29,6 +30,10 @@
 
 DECLARE_int32(update_watermark_stats_interval_s);
 DECLARE_bool(force_recreate_acl_tables);
+DECLARE_int32(sai_stats_collection_threads);
+DECLARE_int32(sai_store_reload_threads);
+DECLARE_int32(sai_state_delta_threads);
+DECLARE_int32(sai_state_delta_route_chunk_size);
 
 namespace facebook::fboss {
 
@@ -225,6 +230,10 @@ class SaiSwitch : public HwSwitch {
 
   void updateStatsImpl(SwitchStats* switchStats) override;
   template <typename LockPolicyT>
+  void processAclDelta(const StateDelta& delta, const LockPolicyT& lockPolicy);
+  // nullptr unless state delta sections are programmed concurrently
+  folly::Executor* getStateDeltaExecutor();
+  template <typename LockPolicyT>
   void updateResourceUsage(const LockPolicyT& lockPolicy);
   /*
    * To make SaiSwitch thread-safe, we mirror the public interface with
@@ -509,6 +518,13 @@ class SaiSwitch : public HwSwitch {
   cfg::SwitchType switchType_{cfg::SwitchType::NPU};
 
   std::map<PortID, phy::PhyInfo> lastPhyInfos_;
+
+  // Created on the first stats collection when more than one stats
+  // collection thread is configured, see updateStatsImpl
+  std::unique_ptr<folly::CPUThreadPoolExecutor> statsCollectionExecutor_;
+  // Created on the first state delta when more than one state delta thread
+  // is configured, see stateChangedImpl
+  std::unique_ptr<folly::CPUThreadPoolExecutor> stateDeltaExecutor_;
 };
 
 } // namespace facebook::fboss
@@ -236,7 +236,7 @@ void SaiSystemPortManager::updateStats(
   HwSysPortStats curPortStats{prevPortStats};
   managerTable_->queueManager().updateStats(
       configuredQueues, curPortStats, updateWatermarks);
-  portStats_[portId]->updateStats(curPortStats, now);
+  portStatItr->second->updateStats(curPortStats, now);
 }
 std::shared_ptr<SystemPortMap> SaiSystemPortManager::constructSystemPorts(
     const std::shared_ptr<PortMap>& ports,
@@ -18,8 +18,26 @@
 #include "fboss/agent/hw/sai/switch/SaiHostifManager.h"
 #include "fboss/agent/hw/sai/switch/SaiLagManager.h"
 #include "fboss/agent/hw/sai/switch/SaiPortManager.h"
+#include "fboss/agent/hw/sai/switch/SaiStatsCollection.h"
 #include "fboss/agent/hw/sai/switch/SaiSystemPortManager.h"
 
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+
+#include <functional>
+#include <numeric>
+#include <vector>
+
+namespace {
+template <typename ConcurrentIndex>
+auto getObjectIds(const ConcurrentIndex& index) {
+  std::vector<typename ConcurrentIndex::mapped_type> objectIds;
+  for (auto it = index.begin(); it != index.end(); ++it) {
+    objectIds.push_back(it->second);
+  }
+  return objectIds;
+}
+} // namespace
+
 namespace facebook::fboss {
 void SaiSwitch::updateStatsImpl(SwitchStats* /* switchStats */) {
   auto now =
@@ -29,53 +47,63 @@ void SaiSwitch::updateStatsImpl(SwitchStats* /* switchStats */) {
   if (updateWatermarks) {
     watermarkStatsUpdateTime_ = now;
   }
-
-  auto portsIter = concurrentIndices_->portIds.begin();
-  while (portsIter != concurrentIndices_->portIds.end()) {
-    {
-      std::lock_guard<std::mutex> locked(saiSwitchMutex_);
-      managerTable_->portManager().updateStats(
-          portsIter->second, updateWatermarks);
-    }
-    ++portsIter;
-  }
-  auto sysPortsIter = concurrentIndices_->sysPortIds.begin();
-  while (sysPortsIter != concurrentIndices_->sysPortIds.end()) {
-    {
-      std::lock_guard<std::mutex> locked(saiSwitchMutex_);
-      managerTable_->systemPortManager().updateStats(
-          sysPortsIter->second, updateWatermarks);
-    }
-    ++sysPortsIter;
-  }
-  auto lagsIter = concurrentIndices_->aggregatePortIds.begin();
-  while (lagsIter != concurrentIndices_->aggregatePortIds.end()) {
-    {
-      std::lock_guard<std::mutex> locked(saiSwitchMutex_);
-      managerTable_->lagManager().updateStats(lagsIter->second);
-    }
-    ++lagsIter;
-  }
-  if (platform_->getAsic()->isSupported(HwAsic::Feature::CPU_PORT)) {
-    std::lock_guard<std::mutex> locked(saiSwitchMutex_);
-    managerTable_->hostifManager().updateStats(updateWatermarks);
+  if (!statsCollectionExecutor_ && FLAGS_sai_stats_collection_threads > 1) {
+    statsCollectionExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        FLAGS_sai_stats_collection_threads,
+        std::make_shared<folly::NamedThreadFactory>("SaiStatsCollection"));
   }
+  auto executor = statsCollectionExecutor_.get();
 
-  {
-    std::lock_guard<std::mutex> locked(saiSwitchMutex_);
-    managerTable_->bufferManager().updateStats();
-  }
-  {
-    std::lock_guard<std::mutex> locked(saiSwitchMutex_);
-    HwResourceStatsPublisher().publish(hwResourceStats_);
-  }
-  {
-    std::lock_guard<std::mutex> locked(saiSwitchMutex_);
-    managerTable_->aclTableManager().updateStats();
-  }
-  {
-    std::lock_guard<std::mutex> locked(saiSwitchMutex_);
-    managerTable_->counterManager().updateStats();
+  updateObjectStats<PortID>(
+      saiSwitchMutex_,
+      executor,
+      getObjectIds(concurrentIndices_->portIds),
+      [this, updateWatermarks](PortID portId) {
+        managerTable_->portManager().updateStats(portId, updateWatermarks);
+      },
+      [this](PortID portId) {
+        managerTable_->portManager().prepareUpdateStats(portId);
+      });
+  updateObjectStats<SystemPortID>(
+      saiSwitchMutex_,
+      executor,
+      getObjectIds(concurrentIndices_->sysPortIds),
+      [this, updateWatermarks](SystemPortID portId) {
+        managerTable_->systemPortManager().updateStats(
+            portId, updateWatermarks);
+      });
+  // LAG stats are aggregated from the member port stats, so they are only
+  // updated once all ports are, and reflect a single collection pass.
+  updateObjectStats<AggregatePortID>(
+      saiSwitchMutex_,
+      executor,
+      getObjectIds(concurrentIndices_->aggregatePortIds),
+      [this](AggregatePortID aggPort) {
+        managerTable_->lagManager().updateStats(aggPort);
+      });
+
+  // Switch wide stats of different managers, these are independent of
+  // each other as well.
+  std::vector<std::function<void()>> managerUpdates;
+  if (platform_->getAsic()->isSupported(HwAsic::Feature::CPU_PORT)) {
+    managerUpdates.emplace_back([this, updateWatermarks]() {
+      managerTable_->hostifManager().updateStats(updateWatermarks);
+    });
   }
+  managerUpdates.emplace_back(
+      [this]() { managerTable_->bufferManager().updateStats(); });
+  managerUpdates.emplace_back(
+      [this]() { HwResourceStatsPublisher().publish(hwResourceStats_); });
+  managerUpdates.emplace_back(
+      [this]() { managerTable_->aclTableManager().updateStats(); });
+  managerUpdates.emplace_back(
+      [this]() { managerTable_->counterManager().updateStats(); });
+  std::vector<size_t> managerUpdateIds(managerUpdates.size());
+  std::iota(managerUpdateIds.begin(), managerUpdateIds.end(), 0);
+  updateObjectStats<size_t>(
+      saiSwitchMutex_,
+      executor,
+      managerUpdateIds,
+      [&managerUpdates](size_t idx) { managerUpdates[idx](); });
 }
 } // namespace facebook::fboss
@@ -105,7 +105,7 @@ class NeighborManagerTest : public ManagerTestBase {
 
   std::pair<std::shared_ptr<ArpEntry>, int64_t> resolvePortRifArp(
       std::optional<sai_uint32_t> metadata = std::nullopt) {
-    auto encapIndex = EncapIndexAllocator::getNextAvailableEncapIdx(
+    auto encapIndex = EncapIndexAllocator().getNextAvailableEncapIdx(
         programmedState, *saiPlatform->getAsic());
     auto arpEntry = resolveArp(
         intf0.id, h0, cfg::InterfaceType::SYSTEM_PORT, metadata, encapIndex);
@@ -338,7 +338,7 @@ TEST_F(NeighborManagerTest, resolvePortRifNeighbor) {
       makePendingArpEntry(intf0.id, h0, cfg::InterfaceType::SYSTEM_PORT);
   EXPECT_TRUE(pendingEntry->isPending());
   saiManagerTable->neighborManager().addNeighbor(pendingEntry);
-  auto encapIndex = EncapIndexAllocator::getNextAvailableEncapIdx(
+  auto encapIndex = EncapIndexAllocator().getNextAvailableEncapIdx(
       programmedState, *saiPlatform->getAsic());
   auto arpEntry = resolveArp(
       intf0.id, h0, cfg::InterfaceType::SYSTEM_PORT, std::nullopt, encapIndex);
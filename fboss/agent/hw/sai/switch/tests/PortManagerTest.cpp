@@ -11,6 +11,7 @@
 #include "fboss/agent/hw/StatsConstants.h"
 #include "fboss/agent/hw/sai/store/SaiStore.h"
 #include "fboss/agent/hw/sai/switch/SaiPortManager.h"
+#include "fboss/agent/hw/sai/switch/SaiStatsCollection.h"
 #include "fboss/agent/hw/sai/switch/tests/ManagerTestBase.h"
 #include "fboss/agent/platforms/sai/SaiPlatform.h"
 #include "fboss/agent/platforms/sai/SaiPlatformPort.h"
@@ -18,7 +19,9 @@
 #include "fboss/agent/types.h"
 
 #include <fb303/ServiceData.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 
+#include <mutex>
 #include <string>
 
 #include <gtest/gtest.h>
@@ -338,6 +341,30 @@ TEST_F(PortManagerTest, updateStats) {
   }
 }
 
+TEST_F(PortManagerTest, updateStatsConcurrently) {
+  // None of the ports have their supported stats cached yet, so the first
+  // pass fills them in while other ports of the pass are being updated.
+  auto& portMgr = saiManagerTable->portManager();
+  std::vector<PortID> portIds;
+  for (const auto& testInterface : testInterfaces) {
+    std::shared_ptr<Port> swPort = makePort(testInterface.remoteHosts[0].port);
+    portMgr.addPort(swPort);
+    portIds.push_back(swPort->getID());
+  }
+  std::mutex saiSwitchMutex;
+  folly::CPUThreadPoolExecutor executor(4);
+  updateObjectStats<PortID>(
+      saiSwitchMutex,
+      &executor,
+      portIds,
+      [&portMgr](PortID portId) { portMgr.updateStats(portId); },
+      [&portMgr](PortID portId) { portMgr.prepareUpdateStats(portId); });
+  for (auto portId : portIds) {
+    EXPECT_NE(portMgr.getLastPortStat(portId), nullptr);
+  }
+  EXPECT_EQ(portMgr.getPortStats().size(), portIds.size());
+}
+
 TEST_F(PortManagerTest, portDisableStopsCounterExport) {
   std::shared_ptr<Port> swPort = makePort(p0);
   CHECK(swPort->isEnabled());
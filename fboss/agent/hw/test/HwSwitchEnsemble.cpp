@@ -166,10 +166,13 @@ std::shared_ptr<SwitchState> HwSwitchEnsemble::updateEncapIndices(
   auto newState = in->clone();
   StateDelta delta(programmedState_, in);
   if (getAsic()->isSupported(HwAsic::Feature::RESERVED_ENCAP_INDEX_RANGE)) {
-    auto handleNewNbr = [this, &newState](auto newNbr) {
+    // Allocations below only need to process neighbors updated since in
+    EncapIndexAllocator encapIndexAllocator;
+    encapIndexAllocator.sync(in, *getAsic());
+    auto handleNewNbr = [this, &newState, &encapIndexAllocator](auto newNbr) {
       if (!newNbr->isPending() && !newNbr->getEncapIndex()) {
         auto nbr = newNbr->clone();
-        nbr->setEncapIndex(EncapIndexAllocator::getNextAvailableEncapIdx(
+        nbr->setEncapIndex(encapIndexAllocator.getNextAvailableEncapIdx(
             newState, *getAsic()));
         return nbr;
       }
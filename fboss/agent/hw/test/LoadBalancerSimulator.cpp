@@ -0,0 +1,494 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/test/LoadBalancerSimulator.h"
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/packet/Ethertype.h"
+#include "fboss/agent/packet/IPProto.h"
+
+#include <folly/FileUtil.h>
+#include <folly/io/Cursor.h>
+#include <folly/io/IOBuf.h>
+#include <folly/lang/Bits.h>
+#include <thrift/lib/cpp/util/EnumUtils.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <random>
+
+namespace facebook::fboss::utility {
+namespace {
+// Number of flows hashed together by hashBatch
+constexpr size_t kLanes = 8;
+
+constexpr uint32_t kPcapMagic = 0xa1b2c3d4;
+constexpr uint32_t kPcapNsecMagic = 0xa1b23c4d;
+constexpr uint32_t kLinkTypeEthernet = 1;
+
+uint32_t reflect32(uint32_t value) {
+  uint32_t reflected = 0;
+  for (auto i = 0; i < 32; ++i) {
+    if (value & (1u << i)) {
+      reflected |= 1u << (31 - i);
+    }
+  }
+  return reflected;
+}
+
+/*
+ * Non reflected CRCs keep the register left aligned in 32 bits, so the
+ * same byte step works for 16 and 32 bit widths.
+ */
+template <bool kReflected>
+inline uint32_t
+crcStep(const std::array<uint32_t, 256>& table, uint32_t crc, uint8_t byte) {
+  if constexpr (kReflected) {
+    return (crc >> 8) ^ table[(crc ^ byte) & 0xff];
+  } else {
+    return (crc << 8) ^ table[(crc >> 24) ^ byte];
+  }
+}
+
+double deviationPct(const std::vector<uint64_t>& load) {
+  auto [lowest, highest] = std::minmax_element(load.begin(), load.end());
+  if (!*lowest) {
+    return *highest ? std::numeric_limits<double>::infinity() : 0;
+  }
+  return (static_cast<double>(*highest - *lowest) / *lowest) * 100.0;
+}
+
+/*
+ * 1 - the normalized entropy of the member distribution seen behind each
+ * previous tier member, weighted by the flows that member carries.
+ */
+double polarization(
+    const std::vector<uint64_t>& pairLoad,
+    size_t prevNumMembers,
+    size_t numMembers) {
+  if (numMembers <= 1) {
+    return 0;
+  }
+  double weightedEntropy = 0;
+  uint64_t totalFlows = 0;
+  for (size_t prev = 0; prev < prevNumMembers; ++prev) {
+    auto row = pairLoad.begin() + prev * numMembers;
+    auto rowFlows = std::accumulate(row, row + numMembers, uint64_t{0});
+    if (!rowFlows) {
+      continue;
+    }
+    double entropy = 0;
+    for (auto it = row; it != row + numMembers; ++it) {
+      if (*it) {
+        auto p = static_cast<double>(*it) / rowFlows;
+        entropy -= p * std::log(p);
+      }
+    }
+    weightedEntropy += rowFlows * entropy / std::log(numMembers);
+    totalFlows += rowFlows;
+  }
+  return totalFlows ? 1 - weightedEntropy / totalFlows : 0;
+}
+
+std::optional<HashFlow> parseFlow(folly::io::Cursor cursor) {
+  // Skip destination and source mac
+  cursor.skip(12);
+  auto etherType = cursor.readBE<uint16_t>();
+  while (etherType == static_cast<uint16_t>(ETHERTYPE::ETHERTYPE_VLAN)) {
+    cursor.skip(2);
+    etherType = cursor.readBE<uint16_t>();
+  }
+  HashFlow flow;
+  uint8_t proto;
+  if (etherType == static_cast<uint16_t>(ETHERTYPE::ETHERTYPE_IPV4)) {
+    auto ihl = (cursor.read<uint8_t>() & 0xf) * 4;
+    if (ihl < 20) {
+      return std::nullopt;
+    }
+    cursor.skip(5);
+    auto fragmentOffset = cursor.readBE<uint16_t>() & 0x1fff;
+    cursor.skip(1);
+    proto = cursor.read<uint8_t>();
+    // Only the first fragment carries the transport header
+    if (fragmentOffset) {
+      proto = 0;
+    }
+    cursor.skip(2);
+    cursor.pull(flow.srcIp.data(), 4);
+    cursor.pull(flow.dstIp.data(), 4);
+    cursor.skip(ihl - 20);
+  } else if (etherType == static_cast<uint16_t>(ETHERTYPE::ETHERTYPE_IPV6)) {
+    flow.isV6 = true;
+    flow.flowLabel = cursor.readBE<uint32_t>() & 0xfffff;
+    cursor.skip(2);
+    proto = cursor.read<uint8_t>();
+    cursor.skip(1);
+    cursor.pull(flow.srcIp.data(), 16);
+    cursor.pull(flow.dstIp.data(), 16);
+  } else {
+    return std::nullopt;
+  }
+  if (proto == static_cast<uint8_t>(IP_PROTO::IP_PROTO_TCP) ||
+      proto == static_cast<uint8_t>(IP_PROTO::IP_PROTO_UDP)) {
+    flow.srcPort = cursor.readBE<uint16_t>();
+    flow.dstPort = cursor.readBE<uint16_t>();
+  }
+  return flow;
+}
+} // namespace
+
+HashFlow::HashFlow(
+    const folly::IPAddress& src,
+    const folly::IPAddress& dst,
+    uint16_t srcPort,
+    uint16_t dstPort,
+    uint32_t flowLabel)
+    : flowLabel(flowLabel),
+      srcPort(srcPort),
+      dstPort(dstPort),
+      isV6(src.isV6()) {
+  if (src.isV6() != dst.isV6()) {
+    throw FbossError("Mismatched address families: ", src, ", ", dst);
+  }
+  auto srcBytes = src.bytes();
+  auto dstBytes = dst.bytes();
+  std::memcpy(srcIp.data(), srcBytes, src.byteCount());
+  std::memcpy(dstIp.data(), dstBytes, dst.byteCount());
+}
+
+LoadBalancerSimulator::LoadBalancerSimulator(
+    const cfg::LoadBalancer& config,
+    uint32_t defaultSeed) {
+  const auto& fields = *config.fieldSelection();
+  for (auto field : *fields.ipv4Fields()) {
+    switch (field) {
+      case cfg::IPv4Field::SOURCE_ADDRESS:
+        hashV4Src_ = true;
+        break;
+      case cfg::IPv4Field::DESTINATION_ADDRESS:
+        hashV4Dst_ = true;
+        break;
+    }
+  }
+  for (auto field : *fields.ipv6Fields()) {
+    switch (field) {
+      case cfg::IPv6Field::SOURCE_ADDRESS:
+        hashV6Src_ = true;
+        break;
+      case cfg::IPv6Field::DESTINATION_ADDRESS:
+        hashV6Dst_ = true;
+        break;
+      case cfg::IPv6Field::FLOW_LABEL:
+        hashFlowLabel_ = true;
+        break;
+    }
+  }
+  for (auto field : *fields.transportFields()) {
+    switch (field) {
+      case cfg::TransportField::SOURCE_PORT:
+        hashSrcPort_ = true;
+        break;
+      case cfg::TransportField::DESTINATION_PORT:
+        hashDstPort_ = true;
+        break;
+    }
+  }
+
+  uint32_t poly;
+  switch (*config.algorithm()) {
+    case cfg::HashingAlgorithm::CRC16_CCITT:
+      poly = 0x1021;
+      break;
+    case cfg::HashingAlgorithm::CRC:
+      poly = 0x8005;
+      break;
+    case cfg::HashingAlgorithm::CRC32_LO:
+    case cfg::HashingAlgorithm::CRC32_HI:
+      poly = 0x04c11db7;
+      width_ = 32;
+      break;
+    case cfg::HashingAlgorithm::CRC32_ETHERNET_LO:
+    case cfg::HashingAlgorithm::CRC32_ETHERNET_HI:
+      poly = 0x04c11db7;
+      width_ = 32;
+      reflected_ = true;
+      break;
+    case cfg::HashingAlgorithm::CRC32_KOOPMAN_LO:
+    case cfg::HashingAlgorithm::CRC32_KOOPMAN_HI:
+      poly = 0x741b8cd7;
+      width_ = 32;
+      break;
+    default:
+      throw FbossError(
+          "Unsupported hashing algorithm: ",
+          apache::thrift::util::enumNameSafe(*config.algorithm()));
+  }
+  upperHalf_ = *config.algorithm() == cfg::HashingAlgorithm::CRC32_HI ||
+      *config.algorithm() == cfg::HashingAlgorithm::CRC32_ETHERNET_HI ||
+      *config.algorithm() == cfg::HashingAlgorithm::CRC32_KOOPMAN_HI;
+
+  uint32_t seed = config.seed() ? *config.seed() : defaultSeed;
+  if (reflected_) {
+    auto reflectedPoly = reflect32(poly);
+    for (uint32_t i = 0; i < table_.size(); ++i) {
+      uint32_t entry = i;
+      for (auto bit = 0; bit < 8; ++bit) {
+        entry = (entry & 1) ? (entry >> 1) ^ reflectedPoly : entry >> 1;
+      }
+      table_[i] = entry;
+    }
+    init_ = seed;
+  } else {
+    auto alignedPoly = poly << (32 - width_);
+    for (uint32_t i = 0; i < table_.size(); ++i) {
+      uint32_t entry = i << 24;
+      for (auto bit = 0; bit < 8; ++bit) {
+        entry = (entry & 0x80000000) ? (entry << 1) ^ alignedPoly : entry << 1;
+      }
+      table_[i] = entry;
+    }
+    init_ = width_ == 32 ? seed : (seed & 0xffff) << 16;
+  }
+}
+
+size_t LoadBalancerSimulator::buildKey(const HashFlow& flow, uint8_t* key)
+    const {
+  size_t len = 0;
+  if (flow.isV6) {
+    if (hashV6Src_) {
+      std::memcpy(key + len, flow.srcIp.data(), 16);
+      len += 16;
+    }
+    if (hashV6Dst_) {
+      std::memcpy(key + len, flow.dstIp.data(), 16);
+      len += 16;
+    }
+    if (hashFlowLabel_) {
+      key[len++] = (flow.flowLabel >> 16) & 0xf;
+      key[len++] = (flow.flowLabel >> 8) & 0xff;
+      key[len++] = flow.flowLabel & 0xff;
+    }
+  } else {
+    if (hashV4Src_) {
+      std::memcpy(key + len, flow.srcIp.data(), 4);
+      len += 4;
+    }
+    if (hashV4Dst_) {
+      std::memcpy(key + len, flow.dstIp.data(), 4);
+      len += 4;
+    }
+  }
+  if (hashSrcPort_) {
+    key[len++] = flow.srcPort >> 8;
+    key[len++] = flow.srcPort & 0xff;
+  }
+  if (hashDstPort_) {
+    key[len++] = flow.dstPort >> 8;
+    key[len++] = flow.dstPort & 0xff;
+  }
+  return len;
+}
+
+uint16_t LoadBalancerSimulator::finalize(uint32_t crc) const {
+  if (width_ == 16) {
+    return crc >> 16;
+  }
+  return upperHalf_ ? crc >> 16 : crc & 0xffff;
+}
+
+template <bool kReflected>
+void LoadBalancerSimulator::hashBatch(
+    const HashFlow* flows,
+    size_t count,
+    uint16_t* hashes) const {
+  std::array<std::array<uint8_t, kMaxKeyLen>, kLanes> keys;
+  std::array<size_t, kLanes> lens;
+  std::array<uint32_t, kLanes> crcs;
+  size_t minLen = kMaxKeyLen;
+  for (size_t lane = 0; lane < count; ++lane) {
+    lens[lane] = buildKey(flows[lane], keys[lane].data());
+    minLen = std::min(minLen, lens[lane]);
+    crcs[lane] = init_;
+  }
+  // All lanes step through the common key prefix together
+  for (size_t i = 0; i < minLen; ++i) {
+    for (size_t lane = 0; lane < count; ++lane) {
+      crcs[lane] = crcStep<kReflected>(table_, crcs[lane], keys[lane][i]);
+    }
+  }
+  // Mixed address families leave longer keys to finish on their own
+  for (size_t lane = 0; lane < count; ++lane) {
+    for (size_t i = minLen; i < lens[lane]; ++i) {
+      crcs[lane] = crcStep<kReflected>(table_, crcs[lane], keys[lane][i]);
+    }
+    hashes[lane] = finalize(crcs[lane]);
+  }
+}
+
+uint16_t LoadBalancerSimulator::hash(const HashFlow& flow) const {
+  uint16_t result;
+  if (reflected_) {
+    hashBatch<true>(&flow, 1, &result);
+  } else {
+    hashBatch<false>(&flow, 1, &result);
+  }
+  return result;
+}
+
+uint16_t LoadBalancerSimulator::hashKey(folly::ByteRange key) const {
+  auto crc = init_;
+  for (auto byte : key) {
+    crc = reflected_ ? crcStep<true>(table_, crc, byte)
+                     : crcStep<false>(table_, crc, byte);
+  }
+  return finalize(crc);
+}
+
+void LoadBalancerSimulator::hash(
+    const std::vector<HashFlow>& flows,
+    std::vector<uint16_t>& hashes) const {
+  hashes.resize(flows.size());
+  for (size_t i = 0; i < flows.size(); i += kLanes) {
+    auto count = std::min(kLanes, flows.size() - i);
+    if (reflected_) {
+      hashBatch<true>(flows.data() + i, count, hashes.data() + i);
+    } else {
+      hashBatch<false>(flows.data() + i, count, hashes.data() + i);
+    }
+  }
+}
+
+std::vector<uint64_t> LoadBalancerSimulator::memberLoad(
+    const std::vector<HashFlow>& flows,
+    size_t numMembers) const {
+  if (!numMembers) {
+    throw FbossError("Cannot load balance over 0 members");
+  }
+  std::vector<uint16_t> hashes;
+  hash(flows, hashes);
+  std::vector<uint64_t> load(numMembers);
+  for (auto flowHash : hashes) {
+    load[flowHash % numMembers]++;
+  }
+  return load;
+}
+
+std::vector<TierLoad> simulateTiers(
+    const std::vector<HashFlow>& flows,
+    const std::vector<std::pair<cfg::LoadBalancer, size_t>>& tiers,
+    uint32_t defaultSeed) {
+  std::vector<TierLoad> result;
+  // Member picked by each flow at the previous tier
+  std::vector<uint32_t> prevMembers(flows.size());
+  size_t prevNumMembers = 1;
+  std::vector<uint16_t> hashes;
+  for (const auto& [config, numMembers] : tiers) {
+    if (!numMembers) {
+      throw FbossError("Cannot load balance over 0 members");
+    }
+    LoadBalancerSimulator(config, defaultSeed).hash(flows, hashes);
+    TierLoad tier;
+    tier.memberLoad.resize(numMembers);
+    // Flows per (previous tier member, member) pair
+    std::vector<uint64_t> pairLoad(prevNumMembers * numMembers);
+    for (size_t i = 0; i < flows.size(); ++i) {
+      auto member = hashes[i] % numMembers;
+      tier.memberLoad[member]++;
+      pairLoad[prevMembers[i] * numMembers + member]++;
+      prevMembers[i] = member;
+    }
+    tier.maxDeviationPct = deviationPct(tier.memberLoad);
+    if (!result.empty()) {
+      tier.polarization = polarization(pairLoad, prevNumMembers, numMembers);
+    }
+    prevNumMembers = numMembers;
+    result.push_back(std::move(tier));
+  }
+  return result;
+}
+
+std::vector<HashFlow>
+generateRandomFlows(size_t numFlows, bool isV6, uint32_t seed) {
+  std::mt19937 generator(seed);
+  auto addrLen = isV6 ? 16 : 4;
+  std::vector<HashFlow> flows(numFlows);
+  for (auto& flow : flows) {
+    flow.isV6 = isV6;
+    for (auto i = 0; i < addrLen; i += 4) {
+      auto src = generator();
+      auto dst = generator();
+      std::memcpy(flow.srcIp.data() + i, &src, 4);
+      std::memcpy(flow.dstIp.data() + i, &dst, 4);
+    }
+    if (isV6) {
+      flow.flowLabel = generator() & 0xfffff;
+    }
+    auto ports = generator();
+    flow.srcPort = ports >> 16;
+    flow.dstPort = ports & 0xffff;
+  }
+  return flows;
+}
+
+std::vector<HashFlow> readFlowsFromPcap(const std::string& path) {
+  std::string contents;
+  if (!folly::readFile(path.c_str(), contents)) {
+    throw FbossError("Unable to read pcap file ", path);
+  }
+  auto buf = folly::IOBuf::wrapBuffer(contents.data(), contents.size());
+  folly::io::Cursor cursor(buf.get());
+  // Global header: magic, version, zone, sigfigs, snaplen, link type
+  constexpr size_t kGlobalHeaderLen = 24;
+  constexpr size_t kRecordHeaderLen = 16;
+  if (!cursor.canAdvance(kGlobalHeaderLen)) {
+    throw FbossError("Truncated pcap file ", path);
+  }
+  auto magic = cursor.readLE<uint32_t>();
+  bool littleEndian = magic == kPcapMagic || magic == kPcapNsecMagic;
+  auto swapped = folly::Endian::swap(magic);
+  if (!littleEndian && swapped != kPcapMagic && swapped != kPcapNsecMagic) {
+    throw FbossError("Not a pcap file: ", path);
+  }
+  auto read32 = [&cursor, littleEndian]() {
+    return littleEndian ? cursor.readLE<uint32_t>()
+                        : cursor.readBE<uint32_t>();
+  };
+  cursor.skip(16);
+  auto linkType = read32();
+  if (linkType != kLinkTypeEthernet) {
+    throw FbossError("Unsupported pcap link type ", linkType, " in ", path);
+  }
+
+  std::vector<HashFlow> flows;
+  while (cursor.canAdvance(kRecordHeaderLen)) {
+    // Skip timestamp
+    cursor.skip(8);
+    auto includedLen = read32();
+    cursor.skip(4);
+    if (!cursor.canAdvance(includedLen)) {
+      break;
+    }
+    try {
+      if (auto flow = parseFlow(folly::io::Cursor(cursor, includedLen))) {
+        flows.push_back(*flow);
+      }
+    } catch (const std::out_of_range&) {
+      // Packet truncated by the capture snaplen, skip it
+    }
+    cursor.skip(includedLen);
+  }
+  return flows;
+}
+
+} // namespace facebook::fboss::utility
@@ -0,0 +1,133 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/gen-cpp2/switch_config_types.h"
+
+#include <folly/IPAddress.h>
+#include <folly/Range.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace facebook::fboss::utility {
+
+/*
+ * Header fields of a flow, as seen by the hash engine. Addresses are kept
+ * as network order bytes (IPv4 in the first 4) so building a hash key is a
+ * plain copy.
+ */
+struct HashFlow {
+  HashFlow() = default;
+  HashFlow(
+      const folly::IPAddress& src,
+      const folly::IPAddress& dst,
+      uint16_t srcPort,
+      uint16_t dstPort,
+      uint32_t flowLabel = 0);
+
+  std::array<uint8_t, 16> srcIp{};
+  std::array<uint8_t, 16> dstIp{};
+  uint32_t flowLabel{0};
+  uint16_t srcPort{0};
+  uint16_t dstPort{0};
+  bool isV6{false};
+};
+
+/*
+ * Software model of the ECMP/LAG hash programmed from a cfg::LoadBalancer.
+ *
+ * The selected IPv4/IPv6/transport fields are packed into a key and run
+ * through the configured CRC, with the load balancer seed as the initial
+ * CRC value. The 16 bit result (the low or high half for CRC32 variants)
+ * picks member hash % numMembers, as for plain ECMP groups. This is not a
+ * bit exact model of any one ASIC pipeline, but it does preserve the
+ * properties that matter for tuning: CRC is linear, so for fixed length
+ * keys changing only the seed XORs a constant into the hash and does not
+ * depolarize power of two groups, while changing the algorithm or the
+ * field selection does. MPLS and UDF fields are not modelled.
+ */
+class LoadBalancerSimulator {
+ public:
+  explicit LoadBalancerSimulator(
+      const cfg::LoadBalancer& config,
+      uint32_t defaultSeed = 0);
+
+  uint16_t hash(const HashFlow& flow) const;
+  uint16_t hashKey(folly::ByteRange key) const;
+
+  /*
+   * Hashes flows in small batches, keeping several independent CRC
+   * computations in flight per step so table lookups are not serialized on
+   * a single CRC register.
+   */
+  void hash(const std::vector<HashFlow>& flows, std::vector<uint16_t>& hashes)
+      const;
+
+  // Number of flows landing on each of numMembers equal cost members
+  std::vector<uint64_t> memberLoad(
+      const std::vector<HashFlow>& flows,
+      size_t numMembers) const;
+
+  static constexpr size_t kMaxKeyLen = 40;
+
+ private:
+  size_t buildKey(const HashFlow& flow, uint8_t* key) const;
+  template <bool kReflected>
+  void hashBatch(const HashFlow* flows, size_t count, uint16_t* hashes) const;
+  uint16_t finalize(uint32_t crc) const;
+
+  bool hashV4Src_{false};
+  bool hashV4Dst_{false};
+  bool hashV6Src_{false};
+  bool hashV6Dst_{false};
+  bool hashFlowLabel_{false};
+  bool hashSrcPort_{false};
+  bool hashDstPort_{false};
+
+  unsigned width_{16};
+  bool reflected_{false};
+  bool upperHalf_{false};
+  uint32_t init_{0};
+  std::array<uint32_t, 256> table_{};
+};
+
+struct TierLoad {
+  std::vector<uint64_t> memberLoad;
+  // (highest - lowest) / lowest in percent, as checked by isLoadBalanced
+  double maxDeviationPct{0};
+  /*
+   * How much the choice at the previous tier determines the choice at this
+   * one: 0 when the flows a previous tier member carries spread evenly over
+   * this tier, 1 when they all land on a single member. Always 0 for the
+   * first tier.
+   */
+  double polarization{0};
+};
+
+/*
+ * Runs flows through consecutive hashing tiers, e.g. RSW -> FSW -> SSW,
+ * each given by its load balancer config and number of ECMP members.
+ */
+std::vector<TierLoad> simulateTiers(
+    const std::vector<HashFlow>& flows,
+    const std::vector<std::pair<cfg::LoadBalancer, size_t>>& tiers,
+    uint32_t defaultSeed = 0);
+
+std::vector<HashFlow>
+generateRandomFlows(size_t numFlows, bool isV6, uint32_t seed);
+
+// Extracts flows from IPv4/IPv6 packets of an ethernet pcap file
+std::vector<HashFlow> readFlowsFromPcap(const std::string& path);
+
+} // namespace facebook::fboss::utility
@@ -0,0 +1,131 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/test/LoadBalancerSimulator.h"
+
+#include <folly/Range.h>
+#include <gtest/gtest.h>
+
+#include <optional>
+
+using namespace facebook::fboss;
+using namespace facebook::fboss::utility;
+
+namespace {
+cfg::LoadBalancer makeLoadBalancer(
+    cfg::HashingAlgorithm algorithm,
+    std::optional<int32_t> seed,
+    bool fullHash = true) {
+  cfg::LoadBalancer loadBalancer;
+  *loadBalancer.id() = cfg::LoadBalancerID::ECMP;
+  *loadBalancer.algorithm() = algorithm;
+  if (seed) {
+    loadBalancer.seed() = *seed;
+  }
+  cfg::Fields fields;
+  fields.ipv4Fields() = std::set<cfg::IPv4Field>(
+      {cfg::IPv4Field::SOURCE_ADDRESS, cfg::IPv4Field::DESTINATION_ADDRESS});
+  fields.ipv6Fields() = std::set<cfg::IPv6Field>(
+      {cfg::IPv6Field::SOURCE_ADDRESS, cfg::IPv6Field::DESTINATION_ADDRESS});
+  if (fullHash) {
+    fields.transportFields() = std::set<cfg::TransportField>(
+        {cfg::TransportField::SOURCE_PORT,
+         cfg::TransportField::DESTINATION_PORT});
+  }
+  *loadBalancer.fieldSelection() = fields;
+  return loadBalancer;
+}
+} // namespace
+
+TEST(LoadBalancerSimulatorTest, CrcCheckValues) {
+  auto check = folly::StringPiece("123456789");
+  auto hashKey = [&check](cfg::HashingAlgorithm algorithm, uint32_t seed) {
+    return LoadBalancerSimulator(makeLoadBalancer(algorithm, seed))
+        .hashKey(folly::ByteRange(check));
+  };
+  EXPECT_EQ(hashKey(cfg::HashingAlgorithm::CRC16_CCITT, 0xffff), 0x29b1);
+  EXPECT_EQ(hashKey(cfg::HashingAlgorithm::CRC, 0), 0xfee8);
+  EXPECT_EQ(hashKey(cfg::HashingAlgorithm::CRC32_LO, 0xffffffff), 0xe6e7);
+  EXPECT_EQ(hashKey(cfg::HashingAlgorithm::CRC32_HI, 0xffffffff), 0x0376);
+  EXPECT_EQ(
+      hashKey(cfg::HashingAlgorithm::CRC32_ETHERNET_LO, 0xffffffff), 0xc6d9);
+  EXPECT_EQ(
+      hashKey(cfg::HashingAlgorithm::CRC32_ETHERNET_HI, 0xffffffff), 0x340b);
+}
+
+TEST(LoadBalancerSimulatorTest, BatchMatchesSingleFlow) {
+  auto flows = generateRandomFlows(1000, true /* isV6 */, 1);
+  auto v4Flows = generateRandomFlows(1000, false /* isV6 */, 2);
+  // Interleave families so batches carry keys of different lengths
+  for (size_t i = 0; i < v4Flows.size(); i += 3) {
+    flows[i] = v4Flows[i];
+  }
+  for (auto algorithm :
+       {cfg::HashingAlgorithm::CRC16_CCITT,
+        cfg::HashingAlgorithm::CRC32_ETHERNET_HI}) {
+    LoadBalancerSimulator simulator(makeLoadBalancer(algorithm, 0x1234));
+    std::vector<uint16_t> hashes;
+    simulator.hash(flows, hashes);
+    ASSERT_EQ(hashes.size(), flows.size());
+    for (size_t i = 0; i < flows.size(); ++i) {
+      EXPECT_EQ(hashes[i], simulator.hash(flows[i]));
+    }
+  }
+}
+
+TEST(LoadBalancerSimulatorTest, FieldSelection) {
+  LoadBalancerSimulator halfHash(makeLoadBalancer(
+      cfg::HashingAlgorithm::CRC16_CCITT, 0, false /* fullHash */));
+  LoadBalancerSimulator fullHash(
+      makeLoadBalancer(cfg::HashingAlgorithm::CRC16_CCITT, 0));
+  HashFlow flow(
+      folly::IPAddress("10.0.0.1"), folly::IPAddress("10.0.0.2"), 1000, 80);
+  HashFlow otherPort(
+      folly::IPAddress("10.0.0.1"), folly::IPAddress("10.0.0.2"), 1001, 80);
+  EXPECT_EQ(halfHash.hash(flow), halfHash.hash(otherPort));
+  EXPECT_NE(fullHash.hash(flow), fullHash.hash(otherPort));
+}
+
+TEST(LoadBalancerSimulatorTest, MemberLoad) {
+  auto flows = generateRandomFlows(64000, false /* isV6 */, 3);
+  LoadBalancerSimulator simulator(
+      makeLoadBalancer(cfg::HashingAlgorithm::CRC16_CCITT, 0));
+  auto load = simulator.memberLoad(flows, 8);
+  ASSERT_EQ(load.size(), 8);
+  for (auto memberFlows : load) {
+    EXPECT_NEAR(memberFlows, 8000, 400);
+  }
+}
+
+TEST(LoadBalancerSimulatorTest, Polarization) {
+  auto flows = generateRandomFlows(64000, true /* isV6 */, 4);
+  auto simulate = [&flows](cfg::LoadBalancer second) {
+    return simulateTiers(
+        flows,
+        {{makeLoadBalancer(cfg::HashingAlgorithm::CRC16_CCITT, 0x10), 4},
+         {second, 4}});
+  };
+  // Same hash at both tiers, every tier 1 member feeds one tier 2 member
+  auto tiers =
+      simulate(makeLoadBalancer(cfg::HashingAlgorithm::CRC16_CCITT, 0x10));
+  ASSERT_EQ(tiers.size(), 2);
+  EXPECT_EQ(tiers[0].polarization, 0);
+  EXPECT_LT(tiers[0].maxDeviationPct, 10);
+  EXPECT_NEAR(tiers[1].polarization, 1, 1e-9);
+
+  // CRC is linear, a different seed alone does not help
+  tiers = simulate(makeLoadBalancer(cfg::HashingAlgorithm::CRC16_CCITT, 0x20));
+  EXPECT_NEAR(tiers[1].polarization, 1, 1e-9);
+
+  tiers =
+      simulate(makeLoadBalancer(cfg::HashingAlgorithm::CRC32_ETHERNET_HI, 0));
+  EXPECT_LT(tiers[1].polarization, 0.01);
+  EXPECT_LT(tiers[1].maxDeviationPct, 10);
+}
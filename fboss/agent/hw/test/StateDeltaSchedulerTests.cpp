@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/hw/StateDeltaScheduler.h"
+
+#include <folly/Conv.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace facebook::fboss;
+
+TEST(StateDeltaSchedulerTests, InlineRunsInOrder) {
+  StateDeltaScheduler scheduler;
+  std::vector<int> order;
+  for (auto i = 0; i < 4; ++i) {
+    scheduler.addSection(
+        folly::to<std::string>(i), [&order, i]() { order.push_back(i); });
+  }
+  scheduler.run();
+  EXPECT_EQ(order, std::vector<int>({0, 1, 2, 3}));
+}
+
+TEST(StateDeltaSchedulerTests, InlineStopsAtError) {
+  StateDeltaScheduler scheduler;
+  bool ranAfterError = false;
+  scheduler.addSection("fail", []() { throw std::runtime_error("fail"); });
+  scheduler.addSection("after", [&]() { ranAfterError = true; });
+  EXPECT_THROW(scheduler.run(), std::runtime_error);
+  EXPECT_FALSE(ranAfterError);
+}
+
+TEST(StateDeltaSchedulerTests, DependencyMustBeEarlier) {
+  StateDeltaScheduler scheduler;
+  EXPECT_THROW(scheduler.addSection("self", []() {}, {0}), FbossError);
+}
+
+TEST(StateDeltaSchedulerTests, ConcurrentKeepsDependencyOrder) {
+  folly::CPUThreadPoolExecutor executor(4);
+  StateDeltaScheduler scheduler(&executor);
+  std::mutex mutex;
+  std::vector<std::string> order;
+  auto section = [&](std::string name) {
+    return [&, name]() {
+      std::lock_guard<std::mutex> lock(mutex);
+      order.push_back(name);
+    };
+  };
+  auto mirrors = scheduler.addSection("mirrors", section("mirrors"));
+  for (auto i = 0; i < 8; ++i) {
+    auto name = folly::to<std::string>("routes", i);
+    scheduler.addSection(name, section(name));
+  }
+  scheduler.addSection("acls", section("acls"), {mirrors});
+  scheduler.run();
+  ASSERT_EQ(10, order.size());
+  auto pos = [&](const std::string& name) {
+    return std::find(order.begin(), order.end(), name) - order.begin();
+  };
+  EXPECT_LT(pos("mirrors"), pos("acls"));
+}
+
+TEST(StateDeltaSchedulerTests, ConcurrentErrorWaitsForAll) {
+  folly::CPUThreadPoolExecutor executor(4);
+  StateDeltaScheduler scheduler(&executor);
+  std::atomic<int> numRan{0};
+  std::atomic<bool> dependentRan{false};
+  auto failed = scheduler.addSection(
+      "fail", []() { throw std::runtime_error("fail"); });
+  scheduler.addSection(
+      "dependent", [&]() { dependentRan = true; }, {failed});
+  for (auto i = 0; i < 8; ++i) {
+    scheduler.addSection(folly::to<std::string>(i), [&]() { ++numRan; });
+  }
+  EXPECT_THROW(scheduler.run(), std::runtime_error);
+  // Independent sections all ran before run() returned
+  EXPECT_EQ(8, numRan);
+  EXPECT_FALSE(dependentRan);
+}
@@ -429,6 +429,11 @@ struct CaptureInfo {
    * set of criteria that packet must meet to be captured
    */
   4: CaptureFilter filter;
+  /*
+   * Only capture the first snaplen bytes of each packet.  Captures whole
+   * packets if unset or 0.
+   */
+  5: optional i32 snaplen;
 }
 
 struct RouteUpdateLoggingInfo {
@@ -3,12 +3,28 @@ namespace py3 neteng.fboss
 
 include "common/fb303/if/fb303.thrift"
 
+typedef binary (cpp2.type = "folly::IOBuf") IOBuf
+
 struct TPacket {
   1: i64 timestamp;
   2: string l2Port;
   3: binary buf;
 }
 
+/*
+ * Packet carried in a TPacketBatch. The payload is an IOBuf so the server
+ * can hand over the received buffer chain without copying it into a string.
+ */
+struct TBatchedPacket {
+  1: i64 timestamp;
+  2: string l2Port;
+  3: IOBuf buf;
+}
+
+struct TPacketBatch {
+  1: list<TBatchedPacket> packets;
+}
+
 enum TPacketErrorCode {
   INVALID_L2PORT = 1,
   CLIENT_NOT_CONNECTED = 2,
@@ -27,6 +43,12 @@ service PacketStream extends fb303.FacebookService {
   stream<TPacket throws (1: TPacketException ex)> connect(
     1: string clientId,
   ) throws (1: TPacketException ex);
+  // Same as connect() but packets are delivered in batches of up to
+  // maxBatchSize packets per stream frame.
+  stream<TPacketBatch throws (1: TPacketException ex)> connectBatched(
+    1: string clientId,
+    2: i32 maxBatchSize,
+  ) throws (1: TPacketException ex);
   void registerPort(1: string clientId, 2: string l2Port) throws (
     1: TPacketException ex,
   );
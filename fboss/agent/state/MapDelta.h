@@ -43,6 +43,7 @@ class MapDelta {
   using NodeMapExtractor = typename Traits<MAP>::ExtractorT;
   using Iterator = DeltaValueIterator<MAP, VALUE, NodeMapExtractor>;
   using Impl = MapDeltaImpl<MAP, VALUE, Iterator>;
+  using Chunk = typename Impl::Chunk;
 
   MapDelta(const MAP* oldMap, const MAP* newMap)
       : impl_(std::move(oldMap), std::move(newMap)) {}
@@ -55,6 +56,12 @@ class MapDelta {
     return impl_.end();
   }
 
+  // See MapDeltaImpl::getChunks()
+  std::vector<Chunk> getChunks(size_t maxChunks, size_t minChunkSize = 1)
+      const {
+    return impl_.getChunks(maxChunks, minChunkSize);
+  }
+
   auto getNew() const {
     return impl_.getNew();
   }
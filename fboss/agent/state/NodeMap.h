@@ -129,6 +129,10 @@ class NodeMapT : public NodeBaseT<MapTypeT, NodeMapFields<TraitsT>> {
   Iterator end() const {
     return (Iterator(getAllNodes().end()));
   }
+  // First node whose key is not less than key
+  Iterator lower_bound(const KeyType& key) const {
+    return Iterator(getAllNodes().lower_bound(key));
+  }
   ReverseIterator rbegin() const {
     return (ReverseIterator(getAllNodes().rbegin()));
   }
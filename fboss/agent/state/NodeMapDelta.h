@@ -9,10 +9,12 @@
  */
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <functional>
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 #include <folly/functional/ApplyTuple.h>
 #include <glog/logging.h>
@@ -94,6 +96,7 @@ class DeltaValueIterator {
  public:
   using MapType = MAP;
   using Node = typename MAP::mapped_type;
+  using Extractor = MAP_EXTRACTOR;
 
   // Iterator properties
   using iterator_category = std::forward_iterator_tag;
@@ -107,14 +110,34 @@ class DeltaValueIterator {
       typename MapType::const_iterator oldIt,
       const MapType* newMap,
       typename MapType::const_iterator newIt)
+      : DeltaValueIterator(
+            oldMap,
+            oldIt,
+            oldMap->end(),
+            newMap,
+            newIt,
+            newMap->end()) {}
+
+  /*
+   * Iterate over the changes in [oldIt, oldEnd) and [newIt, newEnd) only.
+   * Both ranges must span the same keys, see MapDeltaImpl::getChunks().
+   */
+  DeltaValueIterator(
+      const MapType* oldMap,
+      typename MapType::const_iterator oldIt,
+      typename MapType::const_iterator oldEnd,
+      const MapType* newMap,
+      typename MapType::const_iterator newIt,
+      typename MapType::const_iterator newEnd)
       : oldIt_(oldIt),
         newIt_(newIt),
+        oldEnd_(oldEnd),
+        newEnd_(newEnd),
         oldMap_(oldMap),
         newMap_(newMap),
         value_(nullNode_, nullNode_) {
     // Advance to the first difference
-    while (oldIt_ != oldMap_->end() && newIt_ != newMap_->end() &&
-           *oldIt_ == *newIt_) {
+    while (oldIt_ != oldEnd_ && newIt_ != newEnd_ && *oldIt_ == *newIt_) {
       ++oldIt_;
       ++newIt_;
     }
@@ -149,13 +172,13 @@ class DeltaValueIterator {
   void advance() {
     // If we have already hit the end of one side, advance the other.
     // We are immediately done after this.
-    if (oldIt_ == oldMap_->end()) {
+    if (oldIt_ == oldEnd_) {
       // advance() shouldn't be called if we are already at the end
-      CHECK(newIt_ != newMap_->end());
+      CHECK(newIt_ != newEnd_);
       ++newIt_;
       updateValue();
       return;
-    } else if (newIt_ == newMap_->end()) {
+    } else if (newIt_ == newEnd_) {
       ++oldIt_;
       updateValue();
       return;
@@ -175,23 +198,22 @@ class DeltaValueIterator {
     }
 
     // Advance past any unchanged nodes.
-    while (oldIt_ != oldMap_->end() && newIt_ != newMap_->end() &&
-           *oldIt_ == *newIt_) {
+    while (oldIt_ != oldEnd_ && newIt_ != newEnd_ && *oldIt_ == *newIt_) {
       ++oldIt_;
       ++newIt_;
     }
     updateValue();
   }
   void updateValue() {
-    if (oldIt_ == oldMap_->end()) {
-      if (newIt_ == newMap_->end()) {
+    if (oldIt_ == oldEnd_) {
+      if (newIt_ == newEnd_) {
         value_.reset(nullNode_, nullNode_);
       } else {
         value_.reset(nullNode_, getValue(newIt_));
       }
       return;
     }
-    if (newIt_ == newMap_->end()) {
+    if (newIt_ == newEnd_) {
       value_.reset(getValue(oldIt_), nullNode_);
       return;
     }
@@ -209,6 +231,8 @@ class DeltaValueIterator {
  public:
   InnerIter oldIt_;
   InnerIter newIt_;
+  InnerIter oldEnd_;
+  InnerIter newEnd_;
   const MapType* oldMap_;
   const MapType* newMap_;
   VALUE value_;
@@ -218,6 +242,32 @@ class DeltaValueIterator {
 template <typename MAP, typename VALUE, typename MAP_EXTRACTOR>
 const typename VALUE::NodeWrapper
     DeltaValueIterator<MAP, VALUE, MAP_EXTRACTOR>::nullNode_ = nullptr;
+
+/*
+ * The changes of a map delta within a range of keys, see
+ * MapDeltaImpl::getChunks(). Can be passed to DeltaFunctions like a delta.
+ */
+template <typename ITERATOR, typename NODE_WRAPPER>
+class MapDeltaChunk {
+ public:
+  using Iterator = ITERATOR;
+  using NodeWrapper = NODE_WRAPPER;
+
+  MapDeltaChunk(Iterator begin, Iterator end)
+      : begin_(std::move(begin)), end_(std::move(end)) {}
+
+  Iterator begin() const {
+    return begin_;
+  }
+  Iterator end() const {
+    return end_;
+  }
+
+ private:
+  Iterator begin_;
+  Iterator end_;
+};
+
 template <
     typename MAP,
     typename VALUE,
@@ -231,6 +281,7 @@ class MapDeltaImpl {
   using Node = typename MAP::mapped_type;
   using NodeWrapper = typename VALUE::NodeWrapper;
   using Iterator = ITERATOR;
+  using Chunk = MapDeltaChunk<Iterator, NodeWrapper>;
 
   MapDeltaImpl(MapPointerType&& oldMap, MapPointerType&& newMap)
       : old_(std::move(oldMap)), new_(std::move(newMap)) {}
@@ -275,6 +326,65 @@ class MapDeltaImpl {
     return Iterator(getOld(), old_->end(), getNew(), new_->end());
   }
 
+  /*
+   * Split the delta into chunks over consecutive key ranges, which together
+   * hold all its changes and can be iterated concurrently. Chunks are cut
+   * at evenly spaced keys of the larger map, so that they have at least
+   * minChunkSize entries, and there are at most maxChunks of them.
+   *
+   * Finding the cuts takes a walk over the larger map, without comparing
+   * nodes, and a MAP::lower_bound() per cut in the other one. Deltas over
+   * small maps are not worth splitting.
+   */
+  std::vector<Chunk> getChunks(size_t maxChunks, size_t minChunkSize = 1)
+      const {
+    std::vector<Chunk> chunks;
+    if (old_ == new_) {
+      return chunks;
+    }
+    // As in begin(), a missing map is an empty range at the end of the
+    // other one
+    auto oldMap = old_ ? getOld() : getNew();
+    auto newMap = new_ ? getNew() : getOld();
+    auto oldLo = old_ ? oldMap->begin() : oldMap->end();
+    auto newLo = new_ ? newMap->begin() : newMap->end();
+    size_t oldSize = old_ ? old_->size() : 0;
+    size_t newSize = new_ ? new_->size() : 0;
+    auto splitOnOld = oldSize > newSize;
+    auto splitSize = std::max(oldSize, newSize);
+    auto numChunks = std::clamp<size_t>(
+        splitSize / std::max<size_t>(minChunkSize, 1),
+        1,
+        std::max<size_t>(maxChunks, 1));
+    chunks.reserve(numChunks);
+    auto splitIt = splitOnOld ? oldLo : newLo;
+    size_t splitPos = 0;
+    for (size_t chunk = 1; chunk < numChunks; ++chunk) {
+      for (auto pos = chunk * splitSize / numChunks; splitPos < pos;
+           ++splitPos) {
+        ++splitIt;
+      }
+      const auto& key = ITERATOR::Extractor::getKey(splitIt);
+      auto oldHi = old_ ? oldMap->lower_bound(key) : oldMap->end();
+      auto newHi = new_ ? newMap->lower_bound(key) : newMap->end();
+      chunks.emplace_back(
+          Iterator(oldMap, oldLo, oldHi, newMap, newLo, newHi),
+          Iterator(oldMap, oldHi, oldHi, newMap, newHi, newHi));
+      oldLo = oldHi;
+      newLo = newHi;
+    }
+    chunks.emplace_back(
+        Iterator(oldMap, oldLo, oldMap->end(), newMap, newLo, newMap->end()),
+        Iterator(
+            oldMap,
+            oldMap->end(),
+            oldMap->end(),
+            newMap,
+            newMap->end(),
+            newMap->end()));
+    return chunks;
+  }
+
  private:
   MapPointerType old_;
   MapPointerType new_;
@@ -311,6 +421,7 @@ class NodeMapDelta {
   };
   using Iterator = DeltaValueIterator<MAP, VALUE, NodeMapExtractor>;
   using Impl = MapDeltaImpl<MAP, VALUE, Iterator, MAPPOINTERTRAITS>;
+  using Chunk = typename Impl::Chunk;
 
   NodeMapDelta(MapPointerType&& oldMap, MapPointerType&& newMap)
       : impl_(std::move(oldMap), std::move(newMap)) {}
@@ -327,6 +438,10 @@ class NodeMapDelta {
   Iterator end() const {
     return impl_.end();
   }
+  std::vector<Chunk> getChunks(size_t maxChunks, size_t minChunkSize = 1)
+      const {
+    return impl_.getChunks(maxChunks, minChunkSize);
+  }
 
  private:
   Impl impl_;
@@ -466,6 +466,7 @@ class Route : public ThriftStructNode<Route<AddrT>, ThriftFieldsT<AddrT>> {
   // THRIFT_COPY
   void setResolved(const RouteNextHopEntry& fwd) {
     this->template set<switch_state_tags::fwd>(fwd.toThrift());
+    this->template ref<switch_state_tags::fwd>()->shareNextHops(fwd);
     setFlags(flags() | RESOLVED);
     setFlags(flags() & (~(UNRESOLVABLE | PROCESSING)));
   }
@@ -12,10 +12,13 @@
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/state/RouteNextHop.h"
 
+#include <folly/Synchronized.h>
 #include <folly/logging/xlog.h>
 #include <gflags/gflags.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
+#include <algorithm>
 #include <iterator>
+#include <map>
 #include <numeric>
 #include "folly/IPAddress.h"
 
@@ -44,9 +47,70 @@ std::vector<facebook::fboss::NextHopThrift> thriftNextHopsFromAddresses(
 DEFINE_bool(wide_ecmp, false, "Enable fixed width wide ECMP feature");
 DEFINE_bool(optimized_ucmp, false, "Enable UCMP normalization optimizations");
 DEFINE_double(ucmp_max_error, 0.05, "Max UCMP normalization error");
+DEFINE_bool(
+    intern_route_nexthops,
+    true,
+    "Share a single copy of identical nexthop sets between routes");
 
 namespace facebook::fboss {
 
+namespace {
+/*
+ * Pool of interned RouteNextHopEntry nexthops nodes, keyed by the nexthop
+ * set they hold. With wide ECMP the same few sets are used by most routes,
+ * sharing one node per set saves the per-route copy and lets comparisons
+ * short circuit on pointer equality. Nodes are published before being
+ * handed out so that they are never modified in place.
+ *
+ * The pool only holds weak references. Expired entries are swept whenever
+ * the pool doubled in size since the last sweep.
+ */
+class NextHopSetPool {
+ public:
+  using NextHopsNode = RouteNextHopEntry::NextHopsNode;
+
+  static NextHopSetPool& get() {
+    // leaked, RouteNextHopEntry objects may outlive static destruction
+    static auto* pool = new NextHopSetPool();
+    return *pool;
+  }
+
+  std::shared_ptr<NextHopsNode> intern(const RouteNextHopSet& nhops) {
+    auto locked = pool_.lock();
+    auto& entry = locked->sets[nhops];
+    if (auto node = entry.lock()) {
+      return node;
+    }
+    auto node =
+        std::make_shared<NextHopsNode>(util::fromRouteNextHopSet(nhops));
+    node->publish();
+    entry = node;
+    if (locked->sets.size() >= 2 * locked->sizeAfterSweep) {
+      for (auto it = locked->sets.begin(); it != locked->sets.end();) {
+        it = it->second.expired() ? locked->sets.erase(it) : std::next(it);
+      }
+      locked->sizeAfterSweep = std::max(locked->sets.size(), size_t(1));
+    }
+    return node;
+  }
+
+  size_t size() const {
+    auto locked = pool_.lock();
+    return std::count_if(
+        locked->sets.begin(), locked->sets.end(), [](const auto& entry) {
+          return !entry.second.expired();
+        });
+  }
+
+ private:
+  struct Pool {
+    std::map<RouteNextHopSet, std::weak_ptr<NextHopsNode>> sets;
+    size_t sizeAfterSweep{1};
+  };
+  folly::Synchronized<Pool, std::mutex> pool_;
+};
+} // namespace
+
 namespace util {
 
 RouteNextHopSet toRouteNextHopSet(
@@ -103,9 +167,50 @@ RouteNextHopEntry::RouteNextHopEntry(
   if (nhopSet.size() == 0) {
     throw FbossError("Empty nexthop set is passed to the RouteNextHopEntry");
   }
-  auto data = getRouteNextHopEntryThrift(
-      Action::NEXTHOPS, distance, nhopSet, counterID, classID);
-  this->fromThrift(std::move(data));
+  setNextHops(std::move(nhopSet), distance, counterID, classID);
+}
+
+void RouteNextHopEntry::setNextHops(
+    NextHopSet nhopSet,
+    AdminDistance distance,
+    std::optional<RouteCounterID> counterID,
+    std::optional<AclLookupClass> classID) {
+  if (!FLAGS_intern_route_nexthops) {
+    this->fromThrift(getRouteNextHopEntryThrift(
+        Action::NEXTHOPS, distance, std::move(nhopSet), counterID, classID));
+    return;
+  }
+  this->fromThrift(getRouteNextHopEntryThrift(
+      Action::NEXTHOPS, distance, NextHopSet(), counterID, classID));
+  this->ref<switch_state_tags::nexthops>() =
+      NextHopSetPool::get().intern(nhopSet);
+}
+
+void RouteNextHopEntry::copyFrom(const RouteNextHopEntry& other) {
+  const auto& nexthops = other.cref<switch_state_tags::nexthops>();
+  if (!nexthops || !nexthops->isPublished()) {
+    this->fromThrift(other.toThrift());
+    return;
+  }
+  // Immutable nexthops, share them rather than copying the list
+  this->fromThrift(getRouteNextHopEntryThrift(
+      other.getAction(),
+      other.getAdminDistance(),
+      NextHopSet(),
+      other.getCounterID(),
+      other.getClassID()));
+  this->ref<switch_state_tags::nexthops>() = nexthops;
+}
+
+void RouteNextHopEntry::shareNextHops(const RouteNextHopEntry& other) {
+  const auto& nexthops = other.cref<switch_state_tags::nexthops>();
+  if (nexthops && nexthops->isPublished()) {
+    this->ref<switch_state_tags::nexthops>() = nexthops;
+  }
+}
+
+size_t RouteNextHopEntry::numInternedNextHopSets() {
+  return NextHopSetPool::get().size();
 }
 
 NextHopWeight RouteNextHopEntry::getTotalWeight() const {
@@ -149,21 +254,24 @@ std::string RouteNextHopEntry::str() const {
 }
 
 bool operator==(const RouteNextHopEntry& a, const RouteNextHopEntry& b) {
+  // Compare nexthops last, and by node first, as those are the expensive
+  // ones to decode
   return (
       a.getAction() == b.getAction() and
-      a.getNextHopSet() == b.getNextHopSet() and
       a.getAdminDistance() == b.getAdminDistance() and
       a.getCounterID() == b.getCounterID() and
-      a.getClassID() == b.getClassID());
+      a.getClassID() == b.getClassID() and
+      (a.hasSameNextHopsNode(b) or a.getNextHopSet() == b.getNextHopSet()));
 }
 
 bool operator<(const RouteNextHopEntry& a, const RouteNextHopEntry& b) {
   if (a.getAdminDistance() != b.getAdminDistance()) {
     return a.getAdminDistance() < b.getAdminDistance();
   }
-  return (
-      (a.getAction() == b.getAction()) ? (a.getNextHopSet() < b.getNextHopSet())
-                                       : a.getAction() < b.getAction());
+  if (a.getAction() != b.getAction()) {
+    return a.getAction() < b.getAction();
+  }
+  return !a.hasSameNextHopsNode(b) && a.getNextHopSet() < b.getNextHopSet();
 }
 
 // Methods for RouteNextHopEntry
@@ -21,6 +21,7 @@
 
 DECLARE_uint32(ecmp_width);
 DECLARE_bool(optimized_ucmp);
+DECLARE_bool(intern_route_nexthops);
 
 namespace facebook::fboss {
 
@@ -54,6 +55,8 @@ class RouteNextHopEntry
   using NextHopSet = boost::container::flat_set<NextHop>;
   using AclLookupClass = cfg::AclLookupClass;
   using BaseT = thrift_cow::ThriftStructNode<state::RouteNextHopEntry>;
+  using NextHopsNode = typename BaseT::Fields::template TypeFor<
+      switch_state_tags::nexthops>::element_type;
   using BaseT::BaseT;
 
   RouteNextHopEntry(
@@ -77,16 +80,14 @@ class RouteNextHopEntry
       AdminDistance distance,
       std::optional<RouteCounterID> counterID = std::nullopt,
       std::optional<AclLookupClass> classID = std::nullopt) {
-    auto data = getRouteNextHopEntryThrift(
-        Action::NEXTHOPS, distance, NextHopSet({nhop}), counterID, classID);
-    this->fromThrift(std::move(data));
+    setNextHops(NextHopSet({nhop}), distance, counterID, classID);
   }
 
   RouteNextHopEntry(RouteNextHopEntry&& other) noexcept {
-    this->fromThrift(other.toThrift());
+    copyFrom(other);
   }
   RouteNextHopEntry& operator=(RouteNextHopEntry&& other) noexcept {
-    this->fromThrift(other.toThrift());
+    copyFrom(other);
     return *this;
   }
 
@@ -100,6 +101,25 @@ class RouteNextHopEntry
 
   NextHopSet getNextHopSet() const;
 
+  /*
+   * Whether this and other point to the same nexthops node, which is the
+   * case for entries built from the same interned nexthop set.
+   */
+  bool hasSameNextHopsNode(const RouteNextHopEntry& other) const {
+    return cref<switch_state_tags::nexthops>() ==
+        other.cref<switch_state_tags::nexthops>();
+  }
+
+  /*
+   * Point this entry to other's nexthops node if that one is shared
+   * (published, hence immutable). Only valid if this entry has been built
+   * from other, e.g. from other.toThrift().
+   */
+  void shareNextHops(const RouteNextHopEntry& other);
+
+  // Number of distinct nexthop sets currently interned
+  static size_t numInternedNextHopSets();
+
   const std::optional<RouteCounterID> getCounterID() const {
     if (auto counter = safe_cref<switch_state_tags::counterID>()) {
       return counter->cref();
@@ -188,6 +208,12 @@ class RouteNextHopEntry
       NextHopSet nhopSet = NextHopSet(),
       std::optional<RouteCounterID> counterID = std::nullopt,
       std::optional<AclLookupClass> classID = std::nullopt);
+  void setNextHops(
+      NextHopSet nhopSet,
+      AdminDistance distance,
+      std::optional<RouteCounterID> counterID,
+      std::optional<AclLookupClass> classID);
+  void copyFrom(const RouteNextHopEntry& other);
   void normalize(
       std::vector<NextHopWeight>& scaledWeights,
       NextHopWeight totalWeight) const;
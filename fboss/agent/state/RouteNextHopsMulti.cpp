@@ -62,6 +62,7 @@ void RouteNextHopsMulti::update(
   auto data = this->toThrift();
   RouteNextHopsMulti::update(clientId, data, nhe.toThrift());
   this->fromThrift(data);
+  map()->ref(clientId)->shareNextHops(nhe);
 }
 
 // THRIFT_COPY
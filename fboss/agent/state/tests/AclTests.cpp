@@ -21,6 +21,7 @@
 
 #include <folly/IPAddress.h>
 #include <folly/MacAddress.h>
+#include <folly/ScopeGuard.h>
 #include <gtest/gtest.h>
 
 using namespace facebook::fboss;
@@ -31,6 +32,7 @@ using std::make_shared;
 using std::shared_ptr;
 
 DECLARE_bool(enable_acl_table_group);
+DECLARE_int32(acl_priority_gap);
 
 TEST(Acl, applyConfig) {
   FLAGS_enable_acl_table_group = false;
@@ -1020,3 +1022,143 @@ TEST(Acl, GetRequiredAclTableQualifiers) {
   EXPECT_EQ(q0, qualifiers0);
   EXPECT_EQ(q1, qualifiers1);
 }
+
+TEST(Acl, applyConfigIncremental) {
+  FLAGS_enable_acl_table_group = false;
+  auto platform = createMockPlatform();
+  auto stateV0 = make_shared<SwitchState>();
+  stateV0->registerPort(PortID(1), "port1");
+
+  cfg::SwitchConfig config;
+  config.ports()->resize(1);
+  preparedMockPortConfig(config.ports()[0], 1);
+  config.dataPlaneTrafficPolicy() = cfg::TrafficPolicyConfig();
+  for (auto i = 0; i < 3; ++i) {
+    cfg::AclEntry acl;
+    *acl.name() = "acl" + std::to_string(i);
+    *acl.actionType() = cfg::AclActionType::PERMIT;
+    acl.l4SrcPort() = 100 + i;
+    config.acls()->push_back(acl);
+    cfg::MatchToAction matchToAction;
+    *matchToAction.matcher() = *acl.name();
+    matchToAction.action()->sendToQueue() = cfg::QueueMatchAction();
+    *matchToAction.action()->sendToQueue()->queueId() = 1;
+    config.dataPlaneTrafficPolicy()->matchToAction()->push_back(matchToAction);
+  }
+  auto stateV1 = publishAndApplyConfig(stateV0, &config, platform.get());
+  ASSERT_NE(nullptr, stateV1);
+
+  // Change a single ACL, the other entries are reused as is
+  auto configV1 = config;
+  configV1.acls()[1].l4SrcPort() = 200;
+  stateV1->publish();
+  auto stateV2 = applyThriftConfig(
+      stateV1,
+      &configV1,
+      platform.get(),
+      (RoutingInformationBase*)nullptr,
+      nullptr,
+      &config);
+  ASSERT_NE(nullptr, stateV2);
+  EXPECT_EQ(stateV1->getAcl("acl0"), stateV2->getAcl("acl0"));
+  EXPECT_NE(stateV1->getAcl("acl1"), stateV2->getAcl("acl1"));
+  EXPECT_EQ(200, stateV2->getAcl("acl1")->getL4SrcPort().value());
+  EXPECT_EQ(stateV1->getAcl("acl2"), stateV2->getAcl("acl2"));
+
+  // Same result as re-evaluating the whole config
+  auto fullStateV2 = publishAndApplyConfig(stateV1, &configV1, platform.get());
+  ASSERT_NE(nullptr, fullStateV2);
+  EXPECT_EQ(fullStateV2->getAcls()->size(), stateV2->getAcls()->size());
+  for (const auto& acl : *configV1.acls()) {
+    EXPECT_EQ(
+        *fullStateV2->getAcl(*acl.name()), *stateV2->getAcl(*acl.name()));
+  }
+
+  // Reordering the traffic policy changes priorities, so entries are updated
+  auto configV2 = configV1;
+  std::swap(
+      configV2.dataPlaneTrafficPolicy()->matchToAction()[0],
+      configV2.dataPlaneTrafficPolicy()->matchToAction()[2]);
+  stateV2->publish();
+  auto stateV3 = applyThriftConfig(
+      stateV2,
+      &configV2,
+      platform.get(),
+      (RoutingInformationBase*)nullptr,
+      nullptr,
+      &configV1);
+  ASSERT_NE(nullptr, stateV3);
+  EXPECT_EQ(
+      stateV2->getAcl("acl0")->getPriority(),
+      stateV3->getAcl("acl2")->getPriority());
+  EXPECT_EQ(
+      stateV2->getAcl("acl2")->getPriority(),
+      stateV3->getAcl("acl0")->getPriority());
+
+  // Nothing changed
+  stateV3->publish();
+  EXPECT_EQ(
+      nullptr,
+      applyThriftConfig(
+          stateV3,
+          &configV2,
+          platform.get(),
+          (RoutingInformationBase*)nullptr,
+          nullptr,
+          &configV2));
+}
+
+TEST(Acl, applyConfigPriorityGap) {
+  FLAGS_enable_acl_table_group = false;
+  FLAGS_acl_priority_gap = 16;
+  SCOPE_EXIT {
+    FLAGS_acl_priority_gap = 0;
+  };
+  auto platform = createMockPlatform();
+  auto stateV0 = make_shared<SwitchState>();
+  stateV0->registerPort(PortID(1), "port1");
+
+  cfg::SwitchConfig config;
+  config.ports()->resize(1);
+  preparedMockPortConfig(config.ports()[0], 1);
+  config.dataPlaneTrafficPolicy() = cfg::TrafficPolicyConfig();
+  auto addAcl = [](cfg::SwitchConfig& cfg, const std::string& name, int pos) {
+    cfg::AclEntry acl;
+    *acl.name() = name;
+    *acl.actionType() = cfg::AclActionType::PERMIT;
+    acl.l4SrcPort() = 100 + pos;
+    cfg.acls()->push_back(acl);
+    cfg::MatchToAction matchToAction;
+    *matchToAction.matcher() = name;
+    matchToAction.action()->sendToQueue() = cfg::QueueMatchAction();
+    *matchToAction.action()->sendToQueue()->queueId() = 1;
+    auto& mtas = *cfg.dataPlaneTrafficPolicy()->matchToAction();
+    mtas.insert(mtas.begin() + pos, matchToAction);
+  };
+  for (auto i = 0; i < 3; ++i) {
+    addAcl(config, "acl" + std::to_string(i), i);
+  }
+  auto stateV1 = publishAndApplyConfig(stateV0, &config, platform.get());
+  ASSERT_NE(nullptr, stateV1);
+  for (auto i = 0; i < 3; ++i) {
+    EXPECT_EQ(
+        AclTable::kDataplaneAclMaxPriority + 15 + 16 * i,
+        stateV1->getAcl("acl" + std::to_string(i))->getPriority());
+  }
+
+  // Inserting at the top leaves the other entries as they are
+  auto configV1 = config;
+  addAcl(configV1, "aclTop", 0);
+  auto stateV2 = publishAndApplyConfig(stateV1, &configV1, platform.get());
+  ASSERT_NE(nullptr, stateV2);
+  for (auto i = 0; i < 3; ++i) {
+    auto name = "acl" + std::to_string(i);
+    EXPECT_EQ(*stateV1->getAcl(name), *stateV2->getAcl(name));
+  }
+  EXPECT_LT(
+      stateV2->getAcl("aclTop")->getPriority(),
+      stateV2->getAcl("acl0")->getPriority());
+  EXPECT_GE(
+      stateV2->getAcl("aclTop")->getPriority(),
+      AclTable::kDataplaneAclMaxPriority);
+}
@@ -31,6 +31,22 @@ class MapDeltaTest : public ::testing::Test {
         [&](auto addStr) { added.push_back(*addStr); },
         [&](auto rmStr) { removed.push_back(*rmStr); });
   }
+  // Compute the delta chunk by chunk, in order
+  size_t computeDeltaChunks(
+      const std::map<int, std::string>* oldMap,
+      const std::map<int, std::string>* newMap,
+      size_t maxChunks,
+      size_t minChunkSize = 1) {
+    auto chunks = MapDelta(oldMap, newMap).getChunks(maxChunks, minChunkSize);
+    for (const auto& chunk : chunks) {
+      DeltaFunctions::forEachChanged(
+          chunk,
+          [&](auto /*oldStr*/, auto newStr) { changed.push_back(*newStr); },
+          [&](auto addStr) { added.push_back(*addStr); },
+          [&](auto rmStr) { removed.push_back(*rmStr); });
+    }
+    return chunks.size();
+  }
   std::vector<std::string> added, removed, changed;
 };
 
@@ -87,3 +103,50 @@ TEST_F(MapDeltaTest, noChange) {
   EXPECT_EQ(removed.size(), 0);
   EXPECT_EQ(changed.size(), 0);
 }
+
+TEST_F(MapDeltaTest, chunks) {
+  std::map<int, std::string> oldMap, newMap;
+  for (auto i = 0; i < 1000; ++i) {
+    if (i % 3) {
+      oldMap[i] = std::to_string(i);
+    }
+    if (i % 5) {
+      newMap[i] = i % 7 ? std::to_string(i) : std::to_string(-i);
+    }
+  }
+  computeDelta(oldMap, newMap);
+  auto expectedAdded = added;
+  auto expectedRemoved = removed;
+  auto expectedChanged = changed;
+  for (auto maxChunks : {1, 2, 3, 7, 64, 5000}) {
+    SetUp();
+    auto numChunks = computeDeltaChunks(&oldMap, &newMap, maxChunks);
+    EXPECT_EQ(numChunks, std::min<size_t>(maxChunks, newMap.size()));
+    EXPECT_EQ(added, expectedAdded);
+    EXPECT_EQ(removed, expectedRemoved);
+    EXPECT_EQ(changed, expectedChanged);
+  }
+  // No chunks smaller than minChunkSize
+  SetUp();
+  EXPECT_EQ(computeDeltaChunks(&oldMap, &newMap, 64, 200), 4);
+  EXPECT_EQ(added, expectedAdded);
+  EXPECT_EQ(removed, expectedRemoved);
+  EXPECT_EQ(changed, expectedChanged);
+}
+
+TEST_F(MapDeltaTest, chunksAddedOrRemovedMap) {
+  std::map<int, std::string> map;
+  for (auto i = 0; i < 100; ++i) {
+    map[i] = std::to_string(i);
+  }
+  computeDeltaChunks(nullptr, &map, 8);
+  EXPECT_EQ(added.size(), map.size());
+  EXPECT_EQ(removed.size(), 0);
+  SetUp();
+  computeDeltaChunks(&map, nullptr, 8);
+  EXPECT_EQ(added.size(), 0);
+  EXPECT_EQ(removed.size(), map.size());
+  SetUp();
+  EXPECT_EQ(computeDeltaChunks(&map, &map, 8), 0);
+  EXPECT_EQ(added.size() + removed.size() + changed.size(), 0);
+}
@@ -416,3 +416,47 @@ TEST(RouteNextHopEntry, Thrift) {
   validateThriftStructNodeSerialization<RouteNextHopEntry>(nhops0);
   validateThriftStructNodeSerialization<RouteNextHopEntry>(nhops1);
 }
+
+TEST(RouteNextHopEntry, InternedNextHops) {
+  auto makeNextHops = [](InterfaceID intf) {
+    RouteNextHopSet nhops;
+    nhops.emplace(ResolvedNextHop(nextHopAddr2, intf, ECMP_WEIGHT));
+    nhops.emplace(ResolvedNextHop(nextHopAddr4, intf, ECMP_WEIGHT));
+    return nhops;
+  };
+  auto numInterned = RouteNextHopEntry::numInternedNextHopSets();
+  {
+    RouteNextHopEntry entry0(
+        makeNextHops(InterfaceID(1)), kDefaultAdminDistance);
+    RouteNextHopEntry entry1(
+        makeNextHops(InterfaceID(1)),
+        AdminDistance::STATIC_ROUTE,
+        std::optional<RouteCounterID>("counter0"));
+    RouteNextHopEntry entry2(
+        makeNextHops(InterfaceID(2)), kDefaultAdminDistance);
+    EXPECT_EQ(numInterned + 2, RouteNextHopEntry::numInternedNextHopSets());
+
+    // Same nexthops share one node regardless of other attributes
+    EXPECT_TRUE(entry0.hasSameNextHopsNode(entry1));
+    EXPECT_FALSE(entry0.hasSameNextHopsNode(entry2));
+    EXPECT_FALSE(entry0 == entry1);
+    EXPECT_FALSE(entry0 == entry2);
+    EXPECT_EQ(
+        entry0,
+        RouteNextHopEntry(makeNextHops(InterfaceID(1)), kDefaultAdminDistance));
+    EXPECT_EQ(makeNextHops(InterfaceID(1)), entry1.getNextHopSet());
+
+    // Moves keep sharing, entries built from thrift do not but still compare
+    // equal
+    RouteNextHopEntry moved(std::move(entry0));
+    EXPECT_TRUE(moved.hasSameNextHopsNode(entry1));
+    RouteNextHopEntry fromThrift(moved.toThrift());
+    EXPECT_FALSE(fromThrift.hasSameNextHopsNode(moved));
+    EXPECT_EQ(fromThrift, moved);
+    fromThrift.shareNextHops(moved);
+    EXPECT_TRUE(fromThrift.hasSameNextHopsNode(moved));
+    validateThriftStructNodeSerialization<RouteNextHopEntry>(moved);
+  }
+  // Pool does not keep unused sets alive
+  EXPECT_EQ(numInterned, RouteNextHopEntry::numInternedNextHopSets());
+}
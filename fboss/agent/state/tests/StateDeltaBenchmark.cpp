@@ -0,0 +1,108 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <folly/Benchmark.h>
+#include <folly/Conv.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/futures/Future.h>
+#include "fboss/agent/state/DeltaFunctions.h"
+#include "fboss/agent/state/MapDelta.h"
+
+#include <atomic>
+#include <map>
+#include <string>
+
+using namespace facebook::fboss;
+
+DEFINE_int32(delta_map_size, 1000000, "Number of entries in the delta maps");
+DEFINE_int32(delta_threads, 8, "Number of threads walking chunks");
+
+namespace {
+using BenchMap = std::map<int, std::string>;
+
+struct DeltaMaps {
+  DeltaMaps() {
+    // A full table delta with a few percent of entries changed, as on a
+    // large route churn
+    for (auto i = 0; i < FLAGS_delta_map_size; ++i) {
+      auto value = folly::to<std::string>("entry ", i);
+      oldMap.emplace(i, value);
+      if (i % 50 == 0) {
+        // Removed
+        continue;
+      }
+      newMap.emplace(i, i % 20 == 0 ? value + " changed" : value);
+    }
+    for (auto i = 0; i < FLAGS_delta_map_size / 50; ++i) {
+      // Added
+      newMap.emplace(
+          FLAGS_delta_map_size + i, folly::to<std::string>("entry ", i));
+    }
+  }
+  BenchMap oldMap;
+  BenchMap newMap;
+};
+
+const DeltaMaps& getDeltaMaps() {
+  static DeltaMaps maps;
+  return maps;
+}
+
+template <typename Delta>
+size_t countChanges(const Delta& delta) {
+  size_t changes = 0;
+  DeltaFunctions::forEachChanged(
+      delta,
+      [&](auto /*oldStr*/, auto /*newStr*/) { ++changes; },
+      [&](auto /*addStr*/) { ++changes; },
+      [&](auto /*rmStr*/) { ++changes; });
+  return changes;
+}
+} // namespace
+
+BENCHMARK_COUNTERS(MapDeltaSerial, counters) {
+  const DeltaMaps* maps;
+  BENCHMARK_SUSPEND {
+    maps = &getDeltaMaps();
+  }
+  counters["changes"] = countChanges(MapDelta(&maps->oldMap, &maps->newMap));
+}
+
+BENCHMARK_COUNTERS(MapDeltaChunked, counters) {
+  const DeltaMaps* maps;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor;
+  BENCHMARK_SUSPEND {
+    maps = &getDeltaMaps();
+    executor =
+        std::make_unique<folly::CPUThreadPoolExecutor>(FLAGS_delta_threads);
+  }
+  // Cutting chunks is part of the measured cost
+  auto chunks = MapDelta(&maps->oldMap, &maps->newMap)
+                    .getChunks(FLAGS_delta_threads, 1024);
+  std::atomic<size_t> changes{0};
+  std::vector<folly::SemiFuture<folly::Unit>> walked;
+  walked.reserve(chunks.size());
+  for (const auto& chunk : chunks) {
+    walked.push_back(folly::via(executor.get(), [&chunk, &changes]() {
+                       changes += countChanges(chunk);
+                     }).semi());
+  }
+  folly::collectAll(std::move(walked)).get();
+  counters["changes"] = changes;
+  counters["chunks"] = chunks.size();
+  BENCHMARK_SUSPEND {
+    executor.reset();
+  }
+}
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/AclPriorityPlanner.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+using namespace facebook::fboss;
+
+namespace {
+constexpr int kMinPriority = 100000;
+
+void checkPlan(
+    const std::vector<std::optional<int>>& curPriorities,
+    const folly::F14FastSet<int>& inUse,
+    const std::vector<int>& priorities) {
+  ASSERT_EQ(curPriorities.size(), priorities.size());
+  for (size_t i = 0; i < priorities.size(); ++i) {
+    EXPECT_GE(priorities[i], kMinPriority);
+    if (i > 0) {
+      EXPECT_LT(priorities[i - 1], priorities[i]);
+    }
+    if (curPriorities[i] != priorities[i]) {
+      // Only ever moved to, or added at, a free priority
+      EXPECT_FALSE(inUse.contains(priorities[i]));
+    }
+  }
+}
+
+int numMoved(
+    const std::vector<std::optional<int>>& curPriorities,
+    const std::vector<int>& priorities) {
+  int moved = 0;
+  for (size_t i = 0; i < priorities.size(); ++i) {
+    moved += curPriorities[i] && *curPriorities[i] != priorities[i];
+  }
+  return moved;
+}
+} // namespace
+
+TEST(AclPriorityPlanner, initialLayout) {
+  std::vector<std::optional<int>> curPriorities(3);
+  EXPECT_EQ(
+      AclPriorityPlanner(kMinPriority, 1).plan(curPriorities, {}),
+      std::vector<int>({kMinPriority, kMinPriority + 1, kMinPriority + 2}));
+  EXPECT_EQ(
+      AclPriorityPlanner(kMinPriority, 16).plan(curPriorities, {}),
+      std::vector<int>(
+          {kMinPriority + 15, kMinPriority + 31, kMinPriority + 47}));
+}
+
+TEST(AclPriorityPlanner, insertAtTop) {
+  AclPriorityPlanner planner(kMinPriority, 16);
+  std::vector<std::optional<int>> curPriorities(2000);
+  auto priorities = planner.plan(curPriorities, {});
+  folly::F14FastSet<int> inUse(priorities.begin(), priorities.end());
+
+  curPriorities.assign(priorities.begin(), priorities.end());
+  curPriorities.insert(curPriorities.begin(), std::nullopt);
+  auto newPriorities = planner.plan(curPriorities, inUse);
+  checkPlan(curPriorities, inUse, newPriorities);
+  EXPECT_EQ(0, numMoved(curPriorities, newPriorities));
+}
+
+TEST(AclPriorityPlanner, noGapMovesFewest) {
+  // Numbered by position, as without gaps
+  AclPriorityPlanner planner(kMinPriority, 1);
+  std::vector<std::optional<int>> curPriorities(10);
+  auto priorities = planner.plan(curPriorities, {});
+  folly::F14FastSet<int> inUse(priorities.begin(), priorities.end());
+
+  // Insert in the middle, only entries after it need to move
+  curPriorities.assign(priorities.begin(), priorities.end());
+  curPriorities.insert(curPriorities.begin() + 7, std::nullopt);
+  auto newPriorities = planner.plan(curPriorities, inUse);
+  checkPlan(curPriorities, inUse, newPriorities);
+  EXPECT_EQ(3, numMoved(curPriorities, newPriorities));
+}
+
+TEST(AclPriorityPlanner, reorder) {
+  AclPriorityPlanner planner(kMinPriority, 4);
+  std::vector<std::optional<int>> curPriorities(8);
+  auto priorities = planner.plan(curPriorities, {});
+  folly::F14FastSet<int> inUse(priorities.begin(), priorities.end());
+
+  // Move the last entry to the front, only it needs a new priority
+  curPriorities.assign(priorities.begin(), priorities.end());
+  std::rotate(
+      curPriorities.begin(), curPriorities.end() - 1, curPriorities.end());
+  auto newPriorities = planner.plan(curPriorities, inUse);
+  checkPlan(curPriorities, inUse, newPriorities);
+  EXPECT_EQ(1, numMoved(curPriorities, newPriorities));
+}
+
+TEST(AclPriorityPlanner, skipsPrioritiesInUse) {
+  AclPriorityPlanner planner(kMinPriority, 1);
+  // Entry at kMinPriority + 1 is going away, its priority stays unusable
+  std::vector<std::optional<int>> curPriorities{
+      kMinPriority, std::nullopt, kMinPriority + 3};
+  folly::F14FastSet<int> inUse{
+      kMinPriority, kMinPriority + 1, kMinPriority + 3};
+  auto priorities = planner.plan(curPriorities, inUse);
+  checkPlan(curPriorities, inUse, priorities);
+  EXPECT_EQ(
+      priorities,
+      std::vector<int>({kMinPriority, kMinPriority + 2, kMinPriority + 3}));
+}
+
+TEST(AclPriorityPlanner, belowMinPriorityNotKept) {
+  AclPriorityPlanner planner(kMinPriority, 1);
+  // e.g. a CPU ACL becoming a dataplane one
+  std::vector<std::optional<int>> curPriorities{5, kMinPriority + 1};
+  folly::F14FastSet<int> inUse{5, kMinPriority + 1};
+  auto priorities = planner.plan(curPriorities, inUse);
+  checkPlan(curPriorities, inUse, priorities);
+  EXPECT_EQ(
+      priorities, std::vector<int>({kMinPriority, kMinPriority + 1}));
+}
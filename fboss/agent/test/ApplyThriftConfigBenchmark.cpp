@@ -0,0 +1,157 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <folly/Benchmark.h>
+#include "fboss/agent/ApplyThriftConfig.h"
+#include "fboss/agent/gen-cpp2/switch_config_types.h"
+#include "fboss/agent/hw/mock/MockPlatform.h"
+#include "fboss/agent/state/DeltaFunctions.h"
+#include "fboss/agent/state/StateDelta.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/TestUtils.h"
+
+using namespace facebook::fboss;
+
+DECLARE_bool(enable_acl_table_group);
+DECLARE_bool(skip_unchanged_config_sections);
+DECLARE_int32(acl_priority_gap);
+
+namespace {
+static constexpr int kNumAcls = 5000;
+static constexpr int kNumPolicyAcls = 2000;
+
+cfg::SwitchConfig aclConfig(int numAcls = kNumAcls) {
+  cfg::SwitchConfig config;
+  config.ports()->resize(1);
+  preparedMockPortConfig(config.ports()[0], 1);
+  config.dataPlaneTrafficPolicy() = cfg::TrafficPolicyConfig();
+  for (auto i = 0; i < numAcls; ++i) {
+    cfg::AclEntry acl;
+    *acl.name() = "acl" + std::to_string(i);
+    *acl.actionType() = cfg::AclActionType::PERMIT;
+    acl.l4SrcPort() = i % 65536;
+    acl.dstIp() = "2401:db00::/32";
+    config.acls()->push_back(acl);
+    cfg::MatchToAction matchToAction;
+    *matchToAction.matcher() = *acl.name();
+    matchToAction.action()->sendToQueue() = cfg::QueueMatchAction();
+    *matchToAction.action()->sendToQueue()->queueId() = i % 8;
+    config.dataPlaneTrafficPolicy()->matchToAction()->push_back(matchToAction);
+  }
+  return config;
+}
+} // namespace
+
+/*
+ * Apply a config that differs from the running one in a single ACL, either
+ * re-evaluating every section (full) or skipping sections and ACL entries
+ * that did not change since the previous config (incremental).
+ */
+void applyConfigSingleAclChange(uint32_t iters, bool incremental) {
+  std::unique_ptr<MockPlatform> platform;
+  std::shared_ptr<SwitchState> state;
+  cfg::SwitchConfig config;
+  cfg::SwitchConfig newConfig;
+  BENCHMARK_SUSPEND {
+    FLAGS_enable_acl_table_group = false;
+    FLAGS_skip_unchanged_config_sections = incremental;
+    platform = createMockPlatform();
+    auto initialState = std::make_shared<SwitchState>();
+    initialState->registerPort(PortID(1), "port1");
+    config = aclConfig();
+    state = publishAndApplyConfig(initialState, &config, platform.get());
+    CHECK(state);
+    state->publish();
+    newConfig = config;
+    newConfig.acls()[kNumAcls / 2].l4SrcPort() = 1;
+  }
+  for (uint32_t i = 0; i < iters; ++i) {
+    auto newState = applyThriftConfig(
+        state,
+        &newConfig,
+        platform.get(),
+        (RoutingInformationBase*)nullptr,
+        nullptr,
+        &config);
+    folly::doNotOptimizeAway(newState);
+  }
+}
+
+BENCHMARK_PARAM(applyConfigSingleAclChange, false);
+BENCHMARK_RELATIVE_PARAM(applyConfigSingleAclChange, true);
+
+/*
+ * Insert one ACL at the top of a kNumPolicyAcls entry traffic policy, with
+ * ACL priorities numbered by position (gap of 0) or gap based. Times the
+ * config apply and reports the HW operations the resulting ACL delta takes,
+ * each changed entry being a remove and an add.
+ */
+void insertAclAtTop(folly::UserCounters& counters, int gap) {
+  std::unique_ptr<MockPlatform> platform;
+  std::shared_ptr<SwitchState> state;
+  cfg::SwitchConfig config;
+  cfg::SwitchConfig newConfig;
+  BENCHMARK_SUSPEND {
+    FLAGS_enable_acl_table_group = false;
+    FLAGS_skip_unchanged_config_sections = true;
+    FLAGS_acl_priority_gap = gap;
+    platform = createMockPlatform();
+    auto initialState = std::make_shared<SwitchState>();
+    initialState->registerPort(PortID(1), "port1");
+    config = aclConfig(kNumPolicyAcls);
+    state = publishAndApplyConfig(initialState, &config, platform.get());
+    CHECK(state);
+    state->publish();
+    newConfig = config;
+    cfg::AclEntry acl;
+    *acl.name() = "aclTop";
+    *acl.actionType() = cfg::AclActionType::PERMIT;
+    acl.dstIp() = "2401:db00:1::/48";
+    newConfig.acls()->push_back(acl);
+    cfg::MatchToAction matchToAction;
+    *matchToAction.matcher() = *acl.name();
+    matchToAction.action()->sendToQueue() = cfg::QueueMatchAction();
+    *matchToAction.action()->sendToQueue()->queueId() = 0;
+    auto& matchToActions =
+        *newConfig.dataPlaneTrafficPolicy()->matchToAction();
+    matchToActions.insert(matchToActions.begin(), matchToAction);
+  }
+  auto newState = applyThriftConfig(
+      state,
+      &newConfig,
+      platform.get(),
+      (RoutingInformationBase*)nullptr,
+      nullptr,
+      &config);
+  BENCHMARK_SUSPEND {
+    CHECK(newState);
+    int64_t hwOps = 0;
+    DeltaFunctions::forEachChanged(
+        StateDelta(state, newState).getAclsDelta(),
+        [&](const auto& /*oldAcl*/, const auto& /*newAcl*/) { hwOps += 2; },
+        [&](const auto& /*addedAcl*/) { ++hwOps; },
+        [&](const auto& /*removedAcl*/) { ++hwOps; });
+    counters["acl_hw_ops"] = hwOps;
+    FLAGS_acl_priority_gap = 0;
+  }
+}
+
+BENCHMARK_COUNTERS(InsertAclAtTopPositional, counters) {
+  insertAclAtTop(counters, 0);
+}
+
+BENCHMARK_COUNTERS(InsertAclAtTopGapped, counters) {
+  insertAclAtTop(counters, 16);
+}
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "fboss/agent/Utils.h"
+#include "fboss/agent/hw/HwSwitchWarmBootHelper.h"
+
+#include <boost/filesystem/operations.hpp>
+#include <folly/FileUtil.h>
+#include <folly/dynamic.h>
+#include <folly/experimental/TestUtil.h>
+#include <gflags/gflags.h>
+
+DECLARE_bool(dump_json_switch_state);
+
+namespace facebook::fboss {
+
+namespace {
+folly::dynamic makeState() {
+  folly::dynamic adapterKeys = folly::dynamic::object;
+  adapterKeys["SAI_OBJECT_TYPE_PORT"] = folly::dynamic::array(1, 2, 3);
+  adapterKeys["SAI_OBJECT_TYPE_ROUTE_ENTRY"] = folly::dynamic::array(
+      folly::dynamic::object("prefix", "10.0.0.0/24")("vrf", 0));
+  folly::dynamic state = folly::dynamic::object;
+  state["hwSwitch"] = folly::dynamic::object("adapterKeys", adapterKeys)(
+      "warmBootable", true)("mtu", 9000.5);
+  state["rib"] = folly::dynamic::array();
+  state["nothing"] = nullptr;
+  return state;
+}
+} // namespace
+
+TEST(BinaryStateFile, roundTrip) {
+  folly::test::TemporaryDirectory tmpDir;
+  auto file = (tmpDir.path() / "binary_switch_state").string();
+  auto state = makeState();
+  ASSERT_TRUE(dumpBinaryStateToFile(file, state));
+  auto read = readBinaryStateFromFile(file);
+  ASSERT_TRUE(read.has_value());
+  EXPECT_EQ(state, *read);
+
+  // Smaller than the pretty printed JSON it replaces
+  std::string binary;
+  ASSERT_TRUE(folly::readFile(file.c_str(), binary));
+  auto jsonFile = (tmpDir.path() / "switch_state").string();
+  ASSERT_TRUE(dumpStateToFile(jsonFile, state));
+  std::string json;
+  ASSERT_TRUE(folly::readFile(jsonFile.c_str(), json));
+  EXPECT_LT(binary.size(), json.size());
+}
+
+TEST(BinaryStateFile, missingFile) {
+  folly::test::TemporaryDirectory tmpDir;
+  EXPECT_FALSE(readBinaryStateFromFile((tmpDir.path() / "missing").string()));
+}
+
+TEST(BinaryStateFile, notBinaryState) {
+  folly::test::TemporaryDirectory tmpDir;
+  auto file = (tmpDir.path() / "switch_state").string();
+  ASSERT_TRUE(dumpStateToFile(file, makeState()));
+  EXPECT_FALSE(readBinaryStateFromFile(file));
+}
+
+TEST(BinaryStateFile, unsupportedVersion) {
+  folly::test::TemporaryDirectory tmpDir;
+  auto file = (tmpDir.path() / "binary_switch_state").string();
+  ASSERT_TRUE(dumpBinaryStateToFile(file, makeState()));
+  std::string binary;
+  ASSERT_TRUE(folly::readFile(file.c_str(), binary));
+  // Bump the little endian version following the 4 byte magic
+  binary[4] += 1;
+  ASSERT_TRUE(folly::writeFile(binary, file.c_str()));
+  EXPECT_FALSE(readBinaryStateFromFile(file));
+}
+
+TEST(BinaryStateFile, truncated) {
+  folly::test::TemporaryDirectory tmpDir;
+  auto file = (tmpDir.path() / "binary_switch_state").string();
+  ASSERT_TRUE(dumpBinaryStateToFile(file, makeState()));
+  std::string binary;
+  ASSERT_TRUE(folly::readFile(file.c_str(), binary));
+  binary.resize(binary.size() / 2);
+  ASSERT_TRUE(folly::writeFile(binary, file.c_str()));
+  EXPECT_FALSE(readBinaryStateFromFile(file));
+}
+
+TEST(BinaryStateFile, noStaleJsonFallback) {
+  gflags::FlagSaver flagSaver;
+  folly::test::TemporaryDirectory tmpDir;
+  HwSwitchWarmBootHelper helper(0, tmpDir.path().string(), "sdk_");
+  auto jsonFile = (tmpDir.path() / "switch_state").string();
+  auto binaryFile = (tmpDir.path() / "binary_switch_state").string();
+
+  FLAGS_dump_json_switch_state = true;
+  ASSERT_TRUE(helper.storeWarmBootState(makeState(), state::WarmbootState{}));
+  ASSERT_TRUE(boost::filesystem::exists(jsonFile));
+
+  // Exiting without JSON removes the JSON state of the earlier exit
+  FLAGS_dump_json_switch_state = false;
+  auto newState = makeState();
+  newState["rib"].push_back(1);
+  ASSERT_TRUE(helper.storeWarmBootState(newState, state::WarmbootState{}));
+  EXPECT_FALSE(boost::filesystem::exists(jsonFile));
+  EXPECT_EQ(std::get<0>(helper.getWarmBootState()), newState);
+
+  // An unreadable binary state fails rather than warm booting from the
+  // earlier exit's state
+  ASSERT_TRUE(folly::writeFile(std::string("garbage"), binaryFile.c_str()));
+  EXPECT_ANY_THROW(helper.getWarmBootState());
+}
+
+} // namespace facebook::fboss
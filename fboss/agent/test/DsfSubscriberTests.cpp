@@ -12,8 +12,10 @@
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/test/HwTestHandle.h"
 #include "fboss/agent/test/TestUtils.h"
+#include "fboss/thrift_cow/nodes/Serializer.h"
 
 #include <folly/logging/xlog.h>
+#include <folly/synchronization/Baton.h>
 #include <gtest/gtest.h>
 #include <optional>
 
@@ -22,11 +24,15 @@ using namespace facebook::fboss;
 namespace {
 constexpr auto kRemoteSwitchId = 42;
 constexpr auto kSysPortRangeMin = 1000;
-std::shared_ptr<SystemPortMap> makeSysPorts() {
+std::shared_ptr<SystemPortMap> makeSysPorts(
+    int64_t switchId = kRemoteSwitchId,
+    int firstSysPortId = kSysPortRangeMin + 1,
+    int numSysPorts = 2) {
   auto sysPorts = std::make_shared<SystemPortMap>();
-  for (auto sysPortId = kSysPortRangeMin + 1; sysPortId < kSysPortRangeMin + 3;
+  for (auto sysPortId = firstSysPortId;
+       sysPortId < firstSysPortId + numSysPorts;
        ++sysPortId) {
-    sysPorts->addNode(makeSysPort(std::nullopt, sysPortId, kRemoteSwitchId));
+    sysPorts->addNode(makeSysPort(std::nullopt, sysPortId, switchId));
   }
   return sysPorts;
 }
@@ -47,6 +53,56 @@ std::shared_ptr<InterfaceMap> makeRifs(const SystemPortMap* sysPorts) {
   }
   return rifs;
 }
+
+state::NeighborEntryFields makeNbr(const std::string& ip, int rif) {
+  state::NeighborEntryFields nbr;
+  nbr.ipaddress() = ip;
+  nbr.mac() = "01:02:03:04:05:06";
+  cfg::PortDescriptor port;
+  port.portId() = rif;
+  port.portType() = cfg::PortDescriptorType::SystemPort;
+  nbr.portId() = port;
+  nbr.interfaceId() = rif;
+  nbr.isLocal() = true;
+  return nbr;
+}
+
+std::vector<std::string> makePath(
+    std::vector<std::string> basePath,
+    const std::vector<std::string>& relPath) {
+  basePath.insert(basePath.end(), relPath.begin(), relPath.end());
+  return basePath;
+}
+
+fsdb::OperDeltaUnit makeDeltaUnit(
+    const std::vector<std::string>& path,
+    std::optional<folly::fbstring> newState) {
+  fsdb::OperDeltaUnit unit;
+  unit.path()->raw() = path;
+  if (newState) {
+    unit.newState() = *newState;
+  }
+  return unit;
+}
+
+fsdb::OperDelta makeDelta(std::vector<fsdb::OperDeltaUnit> units) {
+  fsdb::OperDelta delta;
+  delta.changes() = std::move(units);
+  delta.protocol() = fsdb::OperProtocol::BINARY;
+  return delta;
+}
+
+// Initial sync from FSDB, publishing the entire subscribed maps
+fsdb::OperDelta makeFullDelta(
+    const std::vector<std::string>& sysPortsPath,
+    const std::vector<std::string>& rifsPath,
+    const std::shared_ptr<SystemPortMap>& sysPorts,
+    const std::shared_ptr<InterfaceMap>& rifs) {
+  return makeDelta(
+      {makeDeltaUnit(
+           sysPortsPath, sysPorts->encode(fsdb::OperProtocol::BINARY)),
+       makeDeltaUnit(rifsPath, rifs->encode(fsdb::OperProtocol::BINARY))});
+}
 } // namespace
 
 namespace facebook::fboss {
@@ -71,7 +127,13 @@ TEST_F(DsfSubscriberTest, scheduleUpdate) {
   auto sysPorts = makeSysPorts();
   auto rifs = makeRifs(sysPorts.get());
   dsfSubscriber_->scheduleUpdate(
-      sysPorts, rifs, "switch", SwitchID(kRemoteSwitchId));
+      "switch",
+      SwitchID(kRemoteSwitchId),
+      {makeFullDelta(
+          DsfSubscriber::getSystemPortsPath(),
+          DsfSubscriber::getInterfacesPath(),
+          sysPorts,
+          rifs)});
   // Don't wait for state update to mimic async scheduling of
   // state updates.
 }
@@ -80,12 +142,7 @@ TEST_F(DsfSubscriberTest, setupNeighbors) {
   auto updateAndCompareTables = [this](
                                     const auto& sysPorts,
                                     const auto& rifs,
-                                    bool publishState,
                                     bool noNeighbors = false) {
-    if (publishState) {
-      rifs->publish();
-    }
-
     // dsfSubscriber_->scheduleUpdate is expected to set isLocal to False,
     // and rest of the structure should remain the same.
     auto expectedRifs = InterfaceMap(rifs->toThrift());
@@ -100,7 +157,13 @@ TEST_F(DsfSubscriberTest, setupNeighbors) {
     }
 
     dsfSubscriber_->scheduleUpdate(
-        sysPorts, rifs, "switch", SwitchID(kRemoteSwitchId));
+        "switch",
+        SwitchID(kRemoteSwitchId),
+        {makeFullDelta(
+            DsfSubscriber::getSystemPortsPath(),
+            DsfSubscriber::getInterfacesPath(),
+            sysPorts,
+            rifs)});
     waitForStateUpdates(sw_);
     EXPECT_EQ(
         sysPorts->toThrift(),
@@ -111,13 +174,11 @@ TEST_F(DsfSubscriberTest, setupNeighbors) {
 
     // neighbor entries are modified to set isLocal=false
     // Thus, if neighbor table is non-empty, programmed vs. actually
-    // programmed would be unequal for published state.
-    // for unpublished state, the passed state would be modified, and thus,
-    // programmed vs actually programmed state would be equal.
+    // programmed would be unequal.
     EXPECT_TRUE(
         rifs->toThrift() !=
             sw_->getState()->getRemoteInterfaces()->toThrift() ||
-        noNeighbors || !publishState);
+        noNeighbors);
   };
 
   auto makeNbrs = []() {
@@ -129,77 +190,274 @@ TEST_F(DsfSubscriberTest, setupNeighbors) {
         {"10.0.2.1", kSysPortRangeMin + 2},
     };
     for (const auto& [ip, rif] : ip2Rif) {
-      state::NeighborEntryFields nbr;
-      nbr.ipaddress() = ip;
-      nbr.mac() = "01:02:03:04:05:06";
-      cfg::PortDescriptor port;
-      port.portId() = rif;
-      port.portType() = cfg::PortDescriptorType::SystemPort;
-      nbr.portId() = port;
-      nbr.interfaceId() = rif;
-      nbr.isLocal() = true;
       folly::IPAddress ipAddr(ip);
       if (ipAddr.isV6()) {
-        ndpTable.insert({ip, nbr});
+        ndpTable.insert({ip, makeNbr(ip, rif)});
       } else {
-        arpTable.insert({ip, nbr});
+        arpTable.insert({ip, makeNbr(ip, rif)});
       }
     }
     return std::make_pair(ndpTable, arpTable);
   };
 
-  auto verifySetupNeighbors = [&](bool publishState) {
-    {
-      // No neighbors
-      auto sysPorts = makeSysPorts();
-      auto rifs = makeRifs(sysPorts.get());
-      updateAndCompareTables(
-          sysPorts, rifs, publishState, true /* noNeighbors */);
-    }
-    {
-      // add neighbors
-      auto sysPorts = makeSysPorts();
-      auto rifs = makeRifs(sysPorts.get());
-      auto firstRif = kSysPortRangeMin + 1;
-      auto [ndpTable, arpTable] = makeNbrs();
-      (*rifs)[firstRif]->setNdpTable(ndpTable);
-      (*rifs)[firstRif]->setArpTable(arpTable);
-      updateAndCompareTables(sysPorts, rifs, publishState);
-    }
-    {
-      // update neighbors
-      auto sysPorts = makeSysPorts();
-      auto rifs = makeRifs(sysPorts.get());
-      auto firstRif = kSysPortRangeMin + 1;
-      auto [ndpTable, arpTable] = makeNbrs();
-      ndpTable.begin()->second.mac() = "06:05:04:03:02:01";
-      arpTable.begin()->second.mac() = "06:05:04:03:02:01";
-      (*rifs)[firstRif]->setNdpTable(ndpTable);
-      (*rifs)[firstRif]->setArpTable(arpTable);
-      updateAndCompareTables(sysPorts, rifs, publishState);
+  {
+    // No neighbors
+    auto sysPorts = makeSysPorts();
+    auto rifs = makeRifs(sysPorts.get());
+    updateAndCompareTables(sysPorts, rifs, true /* noNeighbors */);
+  }
+  {
+    // add neighbors
+    auto sysPorts = makeSysPorts();
+    auto rifs = makeRifs(sysPorts.get());
+    auto firstRif = kSysPortRangeMin + 1;
+    auto [ndpTable, arpTable] = makeNbrs();
+    (*rifs)[firstRif]->setNdpTable(ndpTable);
+    (*rifs)[firstRif]->setArpTable(arpTable);
+    updateAndCompareTables(sysPorts, rifs);
+  }
+  {
+    // update neighbors
+    auto sysPorts = makeSysPorts();
+    auto rifs = makeRifs(sysPorts.get());
+    auto firstRif = kSysPortRangeMin + 1;
+    auto [ndpTable, arpTable] = makeNbrs();
+    ndpTable.begin()->second.mac() = "06:05:04:03:02:01";
+    arpTable.begin()->second.mac() = "06:05:04:03:02:01";
+    (*rifs)[firstRif]->setNdpTable(ndpTable);
+    (*rifs)[firstRif]->setArpTable(arpTable);
+    updateAndCompareTables(sysPorts, rifs);
+  }
+  {
+    // delete neighbors
+    auto sysPorts = makeSysPorts();
+    auto rifs = makeRifs(sysPorts.get());
+    auto firstRif = kSysPortRangeMin + 1;
+    auto [ndpTable, arpTable] = makeNbrs();
+    ndpTable.erase(ndpTable.begin());
+    arpTable.erase(arpTable.begin());
+    (*rifs)[firstRif]->setNdpTable(ndpTable);
+    (*rifs)[firstRif]->setArpTable(arpTable);
+    updateAndCompareTables(sysPorts, rifs);
+  }
+  {
+    // clear neighbors
+    auto sysPorts = makeSysPorts();
+    auto rifs = makeRifs(sysPorts.get());
+    updateAndCompareTables(sysPorts, rifs, true /* noNeighbors */);
+  }
+}
+
+TEST_F(DsfSubscriberTest, deltaUpdates) {
+  auto sysPortsPath = DsfSubscriber::getSystemPortsPath();
+  auto rifsPath = DsfSubscriber::getInterfacesPath();
+  auto firstRif = kSysPortRangeMin + 1;
+  auto secondRif = kSysPortRangeMin + 2;
+  auto sysPorts = makeSysPorts();
+  auto rifs = makeRifs(sysPorts.get());
+  state::NeighborEntries arpTable;
+  arpTable.insert({"10.0.1.1", makeNbr("10.0.1.1", firstRif)});
+  (*rifs)[firstRif]->setArpTable(arpTable);
+
+  auto applyDelta = [this](fsdb::OperDelta delta) {
+    dsfSubscriber_->scheduleUpdate(
+        "switch", SwitchID(kRemoteSwitchId), {std::move(delta)});
+    waitForStateUpdates(sw_);
+    return sw_->getState();
+  };
+  auto getArpEntry = [](const auto& state, int rif, const std::string& ip) {
+    return state->getRemoteInterfaces()->getNode(rif)->getArpTable()->getNodeIf(
+        ip);
+  };
+
+  auto state =
+      applyDelta(makeFullDelta(sysPortsPath, rifsPath, sysPorts, rifs));
+  auto origSecondRif = state->getRemoteInterfaces()->getNode(secondRif);
+
+  // Neighbor field update
+  state = applyDelta(makeDelta({makeDeltaUnit(
+      makePath(
+          rifsPath,
+          {folly::to<std::string>(firstRif), "arpTable", "10.0.1.1", "mac"}),
+      thrift_cow::serialize<apache::thrift::type_class::string>(
+          fsdb::OperProtocol::BINARY, std::string("06:05:04:03:02:01")))}));
+  auto arpEntry = getArpEntry(state, firstRif, "10.0.1.1");
+  ASSERT_NE(arpEntry, nullptr);
+  EXPECT_EQ(arpEntry->getMac(), folly::MacAddress("06:05:04:03:02:01"));
+  EXPECT_FALSE(arpEntry->getIsLocal());
+  // Rifs without changes are left untouched
+  EXPECT_EQ(state->getRemoteInterfaces()->getNode(secondRif), origSecondRif);
+
+  // Neighbor add
+  auto newNbr = makeNbr("10.0.2.1", secondRif);
+  state = applyDelta(makeDelta({makeDeltaUnit(
+      makePath(
+          rifsPath,
+          {folly::to<std::string>(secondRif), "arpTable", "10.0.2.1"}),
+      thrift_cow::serialize<apache::thrift::type_class::structure>(
+          fsdb::OperProtocol::BINARY, newNbr))}));
+  arpEntry = getArpEntry(state, secondRif, "10.0.2.1");
+  ASSERT_NE(arpEntry, nullptr);
+  EXPECT_FALSE(arpEntry->getIsLocal());
+
+  // Neighbor remove
+  state = applyDelta(makeDelta({makeDeltaUnit(
+      makePath(
+          rifsPath,
+          {folly::to<std::string>(firstRif), "arpTable", "10.0.1.1"}),
+      std::nullopt)}));
+  EXPECT_EQ(getArpEntry(state, firstRif, "10.0.1.1"), nullptr);
+
+  // Sys port and rif remove
+  state = applyDelta(makeDelta(
+      {makeDeltaUnit(
+           makePath(sysPortsPath, {folly::to<std::string>(secondRif)}),
+           std::nullopt),
+       makeDeltaUnit(
+           makePath(rifsPath, {folly::to<std::string>(secondRif)}),
+           std::nullopt)}));
+  EXPECT_EQ(state->getRemoteSystemPorts()->size(), 1);
+  EXPECT_EQ(state->getRemoteInterfaces()->size(), 1);
+  EXPECT_EQ(state->getRemoteInterfaces()->getNodeIf(secondRif), nullptr);
+}
+
+TEST_F(DsfSubscriberTest, multiNodeScale) {
+  constexpr auto kNumNodes = 64;
+  constexpr auto kSysPortsPerNode = 16;
+  constexpr auto kFirstNodeSwitchId = 100;
+  auto sysPortsPath = DsfSubscriber::getSystemPortsPath();
+  auto rifsPath = DsfSubscriber::getInterfacesPath();
+
+  // Stand in for the FSDB instances of remote nodes, each publishing its
+  // system ports and rifs, with a neighbor resolved on every rif.
+  std::vector<fsdb::OperDelta> nodeSyncs;
+  for (auto node = 0; node < kNumNodes; ++node) {
+    auto sysPorts = makeSysPorts(
+        kFirstNodeSwitchId + node,
+        kSysPortRangeMin + node * kSysPortsPerNode,
+        kSysPortsPerNode);
+    auto rifs = makeRifs(sysPorts.get());
+    for (const auto& [id, rif] : *rifs) {
+      state::NeighborEntries ndpTable;
+      auto ip = folly::sformat("2401::{}", id);
+      ndpTable.insert({ip, makeNbr(ip, id)});
+      rif->setNdpTable(ndpTable);
     }
-    {
-      // delete neighbors
-      auto sysPorts = makeSysPorts();
-      auto rifs = makeRifs(sysPorts.get());
-      auto firstRif = kSysPortRangeMin + 1;
-      auto [ndpTable, arpTable] = makeNbrs();
-      ndpTable.erase(ndpTable.begin());
-      arpTable.erase(arpTable.begin());
-      (*rifs)[firstRif]->setNdpTable(ndpTable);
-      (*rifs)[firstRif]->setArpTable(arpTable);
-      updateAndCompareTables(sysPorts, rifs, publishState);
+    nodeSyncs.push_back(
+        makeFullDelta(sysPortsPath, rifsPath, sysPorts, rifs));
+  }
+
+  // Hold the update thread, so all nodes' updates queue up behind it
+  folly::Baton<> baton;
+  sw_->updateState(
+      "block updates", [&baton](const std::shared_ptr<SwitchState>&) {
+        baton.wait();
+        return std::shared_ptr<SwitchState>{};
+      });
+  auto generation = sw_->getState()->getGeneration();
+  for (auto node = 0; node < kNumNodes; ++node) {
+    dsfSubscriber_->scheduleUpdate(
+        folly::sformat("node{}", node),
+        SwitchID(kFirstNodeSwitchId + node),
+        {std::move(nodeSyncs[node])});
+  }
+  baton.post();
+  auto state = waitForStateUpdates(sw_);
+
+  // Updates from all nodes were applied in a single state update
+  EXPECT_EQ(state->getGeneration(), generation + 1);
+  EXPECT_EQ(
+      state->getRemoteSystemPorts()->size(), kNumNodes * kSysPortsPerNode);
+  EXPECT_EQ(state->getRemoteInterfaces()->size(), kNumNodes * kSysPortsPerNode);
+  for (const auto& [id, rif] : std::as_const(*state->getRemoteInterfaces())) {
+    EXPECT_EQ(rif->getNdpTable()->size(), 1);
+    for (const auto& [ip, nbr] : std::as_const(*rif->getNdpTable())) {
+      EXPECT_FALSE(nbr->getIsLocal());
     }
-    {
-      // clear neighbors
-      auto sysPorts = makeSysPorts();
-      auto rifs = makeRifs(sysPorts.get());
-      updateAndCompareTables(
-          sysPorts, rifs, publishState, true /* noNeighbors */);
+  }
+
+  // A single neighbor change on one node only touches that rif
+  auto rifs = state->getRemoteInterfaces();
+  auto changedRif = kSysPortRangeMin + kSysPortsPerNode;
+  auto ip = folly::sformat("2401::{}", changedRif);
+  dsfSubscriber_->scheduleUpdate(
+      "node1",
+      SwitchID(kFirstNodeSwitchId + 1),
+      {makeDelta({makeDeltaUnit(
+          makePath(
+              rifsPath,
+              {folly::to<std::string>(changedRif), "ndpTable", ip, "mac"}),
+          thrift_cow::serialize<apache::thrift::type_class::string>(
+              fsdb::OperProtocol::BINARY,
+              std::string("06:05:04:03:02:01")))})});
+  state = waitForStateUpdates(sw_);
+  for (const auto& [id, rif] : std::as_const(*state->getRemoteInterfaces())) {
+    if (id == changedRif) {
+      auto nbr = rif->getNdpTable()->getNode(ip);
+      EXPECT_EQ(nbr->getMac(), folly::MacAddress("06:05:04:03:02:01"));
+      EXPECT_FALSE(nbr->getIsLocal());
+    } else {
+      EXPECT_EQ(rif, rifs->getNode(id));
     }
-  };
+  }
+}
+
+TEST_F(DsfSubscriberTest, failedNodeRolledBack) {
+  constexpr auto kGoodNodeSwitchId = 100;
+  constexpr auto kBadNodeSwitchId = 101;
+  auto sysPortsPath = DsfSubscriber::getSystemPortsPath();
+  auto rifsPath = DsfSubscriber::getInterfacesPath();
+  auto goodSysPorts = makeSysPorts(kGoodNodeSwitchId, kSysPortRangeMin);
+  auto badSysPorts = makeSysPorts(kBadNodeSwitchId, kSysPortRangeMin + 10);
+  auto badRif = kSysPortRangeMin + 10;
+
+  dsfSubscriber_->scheduleUpdate(
+      "bad",
+      SwitchID(kBadNodeSwitchId),
+      {makeFullDelta(
+          sysPortsPath,
+          rifsPath,
+          badSysPorts,
+          makeRifs(badSysPorts.get()))});
+  auto state = waitForStateUpdates(sw_);
+  ASSERT_EQ(state->getRemoteSystemPorts()->size(), 2);
+  auto oldBadRif = state->getRemoteInterfaces()->getNodeIf(badRif);
+  ASSERT_NE(oldBadRif, nullptr);
+
+  // Batch a good node's sync with a bad node delta that removes a rif, then
+  // fails on a field of an unknown rif.
+  folly::Baton<> baton;
+  sw_->updateState(
+      "block updates", [&baton](const std::shared_ptr<SwitchState>&) {
+        baton.wait();
+        return std::shared_ptr<SwitchState>{};
+      });
+  dsfSubscriber_->scheduleUpdate(
+      "good",
+      SwitchID(kGoodNodeSwitchId),
+      {makeFullDelta(
+          sysPortsPath,
+          rifsPath,
+          goodSysPorts,
+          makeRifs(goodSysPorts.get()))});
+  dsfSubscriber_->scheduleUpdate(
+      "bad",
+      SwitchID(kBadNodeSwitchId),
+      {makeDelta(
+          {makeDeltaUnit(
+               makePath(rifsPath, {folly::to<std::string>(badRif)}),
+               std::nullopt),
+           makeDeltaUnit(
+               makePath(rifsPath, {"4242", "arpTable", "10.0.1.1", "mac"}),
+               thrift_cow::serialize<apache::thrift::type_class::string>(
+                   fsdb::OperProtocol::BINARY,
+                   std::string("06:05:04:03:02:01")))})});
+  baton.post();
+  state = waitForStateUpdates(sw_);
 
-  verifySetupNeighbors(false /* publishState */);
-  verifySetupNeighbors(true /* publishState */);
+  // The good node's update landed, the bad node's was rolled back whole
+  EXPECT_EQ(state->getRemoteSystemPorts()->size(), 4);
+  EXPECT_EQ(state->getRemoteInterfaces()->size(), 4);
+  EXPECT_EQ(state->getRemoteInterfaces()->getNodeIf(badRif), oldBadRif);
 }
 } // namespace facebook::fboss
@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <folly/Benchmark.h>
+#include "fboss/agent/EncapIndexAllocator.h"
+#include "fboss/agent/hw/switch_asics/MockAsic.h"
+#include "fboss/agent/state/NeighborEntry.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/state/Vlan.h"
+#include "fboss/agent/test/HwTestHandle.h"
+#include "fboss/agent/test/TestUtils.h"
+
+using namespace facebook::fboss;
+
+namespace {
+static constexpr int kNumNeighbors = 20000;
+
+// Mock asic reserved range is too small for kNumNeighbors
+class LargeEncapRangeAsic : public MockAsic {
+ public:
+  LargeEncapRangeAsic()
+      : MockAsic(cfg::SwitchType::VOQ, 0, makeRange(0, 1000)) {}
+  cfg::Range64 getReservedEncapIndexRange() const override {
+    return makeRange(0x200000, 0x300000);
+  }
+};
+
+std::shared_ptr<SwitchState> addNeighbor(
+    std::shared_ptr<SwitchState> state,
+    int nbrIdx,
+    int64_t encapIdx) {
+  auto vlan = state->getVlans()->cbegin()->second;
+  auto ip = folly::IPAddressV6("2401:db00:2110:3001::").toByteArray();
+  ip[14] = nbrIdx >> 8;
+  ip[15] = nbrIdx & 0xff;
+  state::NeighborEntryFields nbr;
+  nbr.mac() = "02:00:00:00:00:01";
+  nbr.interfaceId() = static_cast<int>(vlan->getInterfaceID());
+  nbr.ipaddress() = folly::IPAddressV6(ip).str();
+  nbr.portId() =
+      PortDescriptor(state->getPorts()->cbegin()->second->getID()).toThrift();
+  nbr.state() = state::NeighborState::Reachable;
+  nbr.encapIndex() = encapIdx;
+  vlan->getNdpTable()->modify(vlan->getID(), &state)->addEntry(
+      NeighborEntryFields<folly::IPAddressV6>::fromThrift(nbr));
+  state->publish();
+  return state;
+}
+} // namespace
+
+/*
+ * Resolve kNumNeighbors neighbors one state update at a time, allocating an
+ * encap index for each. Either with a new allocator every time, which has
+ * to look at every neighbor in the state, or with a persistent one that
+ * only processes the changes since the previous allocation.
+ */
+void resolveNeighbors(uint32_t iters, bool persistent) {
+  std::unique_ptr<HwTestHandle> handle;
+  std::shared_ptr<SwitchState> initialState;
+  LargeEncapRangeAsic asic;
+  BENCHMARK_SUSPEND {
+    auto config = testConfigA(cfg::SwitchType::VOQ);
+    handle = createTestHandle(&config);
+    initialState = handle->getSw()->getState();
+  }
+  for (uint32_t i = 0; i < iters; ++i) {
+    auto state = initialState;
+    EncapIndexAllocator allocator;
+    for (auto nbrIdx = 0; nbrIdx < kNumNeighbors; ++nbrIdx) {
+      auto encapIdx = persistent
+          ? allocator.getNextAvailableEncapIdx(state, asic)
+          : EncapIndexAllocator().getNextAvailableEncapIdx(state, asic);
+      state = addNeighbor(state, nbrIdx, encapIdx);
+    }
+    folly::doNotOptimizeAway(state);
+  }
+}
+
+BENCHMARK_PARAM(resolveNeighbors, false);
+BENCHMARK_RELATIVE_PARAM(resolveNeighbors, true);
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -182,3 +182,43 @@ TEST_F(EncapIndexAllocatorTest, vlanAndIntfNeighbors) {
       allocator.getNextAvailableEncapIdx(stateV3, getAsic()),
       allocationStart() + 3);
 }
+
+TEST_F(EncapIndexAllocatorTest, incrementalSync) {
+  auto stateV0 = getSw()->getState();
+  EXPECT_EQ(
+      allocator.getNextAvailableEncapIdx(stateV0, getAsic()),
+      allocationStart());
+  auto stateV1 = addNeighborToVlan(
+      stateV0,
+      folly::IPAddressV6{"2401:db00:2110:3001::0002"},
+      allocationStart());
+  stateV1 = addNeighborToInterface(
+      stateV1,
+      folly::IPAddressV6{"2401:db00:2110:3001::0003"},
+      allocationStart() + 1);
+  stateV1->publish();
+  EXPECT_EQ(
+      allocator.getNextAvailableEncapIdx(stateV1, getAsic()),
+      allocationStart() + 2);
+  // Unpublished states are not kept as the base for later allocations
+  auto stateV2 = addNeighborToVlan(
+      stateV1,
+      folly::IPAddressV6{"2401:db00:2110:3001::0004"},
+      allocationStart() + 2);
+  EXPECT_EQ(
+      allocator.getNextAvailableEncapIdx(stateV2, getAsic()),
+      allocationStart() + 3);
+  EXPECT_EQ(
+      allocator.getNextAvailableEncapIdx(stateV1, getAsic()),
+      allocationStart() + 2);
+  // Removing a neighbor frees up its index
+  auto stateV3 = stateV1;
+  auto firstVlan = stateV3->getVlans()->cbegin()->second;
+  firstVlan->getNdpTable()
+      ->modify(firstVlan->getID(), &stateV3)
+      ->removeEntry(folly::IPAddressV6{"2401:db00:2110:3001::0002"});
+  stateV3->publish();
+  EXPECT_EQ(
+      allocator.getNextAvailableEncapIdx(stateV3, getAsic()),
+      allocationStart());
+}
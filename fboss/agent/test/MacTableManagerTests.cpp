@@ -55,6 +55,25 @@ class MacTableManagerTest : public ::testing::Test {
     return MacAddress("01:02:03:04:05:06");
   }
 
+  folly::MacAddress kMacAddress(int idx) const {
+    return MacAddress::fromHBO(0x020000000000 + idx);
+  }
+
+  void triggerMacLearnedCb(folly::MacAddress mac) {
+    sw_->l2LearningUpdateReceived(
+        L2Entry(
+            mac,
+            kVlan(),
+            PortDescriptor(kPortID()),
+            L2Entry::L2EntryType::L2_ENTRY_TYPE_PENDING),
+        L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD);
+  }
+
+  void waitForMacUpdates() {
+    waitForBackgroundThread(sw_);
+    waitForStateUpdates(sw_);
+  }
+
   void triggerMacLearnedCb(bool wait = true) {
     triggerMacCbHelper(
         facebook::fboss::L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD, wait);
@@ -172,4 +191,32 @@ TEST_F(MacTableManagerTest, SameMacAgedCbTwice) {
   verifyMacIsDeleted();
 }
 
+TEST_F(MacTableManagerTest, MacLearnedBurst) {
+  constexpr auto kNumMacs = 1000;
+  for (auto i = 0; i < kNumMacs; ++i) {
+    triggerMacLearnedCb(kMacAddress(i));
+    // repeated learns for a queued MAC are dropped
+    triggerMacLearnedCb(kMacAddress(i));
+  }
+  waitForMacUpdates();
+
+  verifyStateUpdate([=]() {
+    auto macTable =
+        getSw()->getState()->getVlans()->getVlan(kVlan())->getMacTable();
+    for (auto i = 0; i < kNumMacs; ++i) {
+      auto node = macTable->getMacIf(kMacAddress(i));
+      ASSERT_NE(nullptr, node);
+      EXPECT_EQ(kPortID(), node->getPort().phyPortID());
+    }
+  });
+}
+
+TEST_F(MacTableManagerTest, MacLearnedAgedLearnedNoWait) {
+  triggerMacLearnedCb(false);
+  triggerMacAgedCb(false);
+  triggerMacLearnedCb(true);
+
+  verifyMacIsAdded();
+}
+
 } // namespace facebook::fboss
@@ -9,6 +9,7 @@
  */
 #include <folly/Benchmark.h>
 #include <folly/Random.h>
+#include <malloc.h>
 #include "fboss/agent/state/RouteNextHopEntry.h"
 
 using namespace facebook::fboss;
@@ -23,6 +24,21 @@ static constexpr int kRSWNumPaths = 8;
 static constexpr int kFSWNumPaths = 36;
 static constexpr int kRSWNumRoutes = 10000;
 static constexpr int kFSWNumRoutes = 30000;
+// Full table scale run of interned nexthop sets
+static constexpr int kFullTableNumRoutes = 100000;
+static constexpr int kFullTableNumPaths = 128;
+static constexpr int kFullTableNumEcmpGroups = 16;
+
+std::vector<RouteNextHopEntry> makeFullTableEntries(
+    const std::vector<RouteNextHopEntry::NextHopSet>& nhopSets) {
+  std::vector<RouteNextHopEntry> entries;
+  entries.reserve(kFullTableNumRoutes);
+  for (auto routeIndex = 0; routeIndex < kFullTableNumRoutes; ++routeIndex) {
+    entries.emplace_back(
+        nhopSets[routeIndex % nhopSets.size()], kDefaultAdminDistance);
+  }
+  return entries;
+}
 } // namespace
 
 void RouteNextHopEntryScaleOptimized(
@@ -66,6 +82,54 @@ void RouteNextHopEntryScaleOptimizedFSW(uint32_t /* iters */, bool optimized) {
       optimized, kFSWEcmpWidth, kFSWNumPaths, kFSWNumRoutes);
 }
 
+/*
+ * kFullTableNumRoutes routes spread over kFullTableNumEcmpGroups ECMP groups
+ * of kFullTableNumPaths nexthops each, with or without interning of the
+ * nexthop sets. Reports the heap used by the route entries and times
+ * comparing every route with an identical copy, as FIB deltas do.
+ */
+void RouteNextHopEntryFullTable(folly::UserCounters& counters, bool interned) {
+  FLAGS_intern_route_nexthops = interned;
+  std::vector<RouteNextHopEntry> entries;
+  std::vector<RouteNextHopEntry> sameEntries;
+  BENCHMARK_SUSPEND {
+    std::vector<RouteNextHopEntry::NextHopSet> nhopSets;
+    for (auto group = 0; group < kFullTableNumEcmpGroups; ++group) {
+      RouteNextHopEntry::NextHopSet nhops;
+      for (auto pathIndex = 0; pathIndex < kFullTableNumPaths; ++pathIndex) {
+        nhops.emplace(ResolvedNextHop(
+            folly::IPAddress(fmt::format(
+                "2401:db00:e112:{:x}:1028::{:x}", group, pathIndex + 1)),
+            InterfaceID(pathIndex),
+            ECMP_WEIGHT));
+      }
+      nhopSets.emplace_back(std::move(nhops));
+    }
+    auto heapBefore = mallinfo2().uordblks;
+    entries = makeFullTableEntries(nhopSets);
+    counters["heap_bytes_per_route"] =
+        (mallinfo2().uordblks - heapBefore) / kFullTableNumRoutes;
+    sameEntries = makeFullTableEntries(nhopSets);
+  }
+  size_t numEqual = 0;
+  for (auto routeIndex = 0; routeIndex < kFullTableNumRoutes; ++routeIndex) {
+    numEqual += entries[routeIndex] == sameEntries[routeIndex];
+  }
+  CHECK_EQ(numEqual, static_cast<size_t>(kFullTableNumRoutes));
+  BENCHMARK_SUSPEND {
+    entries.clear();
+    sameEntries.clear();
+  }
+}
+
+BENCHMARK_COUNTERS(RouteNextHopEntryFullTableCopied, counters) {
+  RouteNextHopEntryFullTable(counters, false);
+}
+
+BENCHMARK_COUNTERS(RouteNextHopEntryFullTableInterned, counters) {
+  RouteNextHopEntryFullTable(counters, true);
+}
+
 BENCHMARK_PARAM(RouteNextHopEntryScaleOptimizedRSW, true);
 BENCHMARK_PARAM(RouteNextHopEntryScaleOptimizedRSW, false);
 BENCHMARK_PARAM(RouteNextHopEntryScaleOptimizedFSW, true);
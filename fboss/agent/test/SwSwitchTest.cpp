@@ -38,6 +38,7 @@ using std::string;
 using ::testing::_;
 using ::testing::ByRef;
 using ::testing::Eq;
+using ::testing::Mock;
 using ::testing::Return;
 
 class SwSwitchTest : public ::testing::Test {
@@ -98,6 +99,42 @@ TEST_F(SwSwitchTest, UpdateStatsExceptionCounter) {
       SwitchStats::kCounterPrefix + "update_stats_exceptions.sum.60", 1);
 }
 
+TEST_F(SwSwitchTest, UpdateStatsPublishesSnapshot) {
+  MockHwSwitch* hw = static_cast<MockHwSwitch*>(sw->getHw());
+  EXPECT_EQ(hw->getStatsSnapshot()->version, 0);
+
+  // Without FSDB stats publishing there is no reader of the snapshot, so
+  // SwSwitch does not have it gathered
+  EXPECT_CALL(*hw, getSysPortStats()).Times(0);
+  sw->updateStats();
+  EXPECT_EQ(hw->getStatsSnapshot()->version, 0);
+  Mock::VerifyAndClearExpectations(hw);
+
+  HwPortStats hwPortStats;
+  hwPortStats.inBytes_() = 100;
+  folly::F14FastMap<std::string, HwPortStats> portStats{
+      {"port1", hwPortStats}};
+  EXPECT_CALL(*hw, getPortStats()).WillOnce(Return(portStats));
+  hw->updateStats(sw->stats());
+
+  auto snapshot = hw->getStatsSnapshot();
+  EXPECT_EQ(snapshot->version, 1);
+  EXPECT_EQ(*snapshot->portStats.at("port1").inBytes_(), 100);
+
+  // A failed stats pass does not publish a new snapshot
+  EXPECT_CALL(*hw, updateStatsImpl(sw->stats()))
+      .WillOnce(ThrowException())
+      .WillRepeatedly(Return());
+  EXPECT_THROW(hw->updateStats(sw->stats()), std::exception);
+  EXPECT_EQ(hw->getStatsSnapshot(), snapshot);
+
+  // Readers keep the snapshot they hold across later passes
+  hw->updateStats(sw->stats());
+  EXPECT_EQ(hw->getStatsSnapshot()->version, 2);
+  EXPECT_EQ(snapshot->version, 1);
+  EXPECT_EQ(*snapshot->portStats.at("port1").inBytes_(), 100);
+}
+
 TEST_F(SwSwitchTest, TestStateNonCoalescing) {
   const PortID kPort1{1};
   const VlanID kVlan1{1};
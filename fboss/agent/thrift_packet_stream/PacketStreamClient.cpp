@@ -10,8 +10,12 @@ namespace fboss {
 
 PacketStreamClient::PacketStreamClient(
     const std::string& clientId,
-    folly::EventBase* evb)
+    folly::EventBase* evb,
+    int32_t maxBatchSize,
+    int32_t batchCredits)
     : clientId_(clientId),
+      maxBatchSize_(maxBatchSize),
+      batchCredits_(batchCredits),
       evb_(evb),
       clientEvbThread_(
           std::make_unique<folly::ScopedEventBaseThread>(clientId)) {
@@ -71,8 +75,22 @@ void PacketStreamClient::connectToServer(const std::string& ip, uint16_t port) {
 #endif
 }
 
+void PacketStreamClient::recvPacketBatch(TPacketBatch&& batch) {
+  for (auto& batchedPacket : *batch.packets()) {
+    TPacket packet;
+    packet.timestamp() = *batchedPacket.timestamp();
+    packet.l2Port() = std::move(*batchedPacket.l2Port());
+    packet.buf() = batchedPacket.buf()->moveToFbString().toStdString();
+    recvPacket(std::move(packet));
+  }
+}
+
 #if FOLLY_HAS_COROUTINES
 folly::coro::Task<void> PacketStreamClient::connect() {
+  if (maxBatchSize_ > 0) {
+    co_await connectBatched();
+    co_return;
+  }
   auto result = co_await client_->co_connect(clientId_);
   if (isConnectCancelled()) {
     XLOG(ERR) << "Cancellation Requested;";
@@ -100,6 +118,42 @@ folly::coro::Task<void> PacketStreamClient::connect() {
   XLOG(DBG2) << "Client Cancellation Completed";
   co_return;
 }
+
+folly::coro::Task<void> PacketStreamClient::connectBatched() {
+  // The chunk buffer size is the number of stream credits granted to the
+  // server, it stops sending once that many batches are unconsumed. Batches
+  // then wait in the server's bounded per client queue, and are dropped
+  // once it is full.
+  apache::thrift::RpcOptions options;
+  options.setChunkBufferSize(batchCredits_);
+  auto result =
+      co_await client_->co_connectBatched(options, clientId_, maxBatchSize_);
+  if (isConnectCancelled()) {
+    XLOG(ERR) << "Cancellation Requested;";
+    co_return;
+  }
+  state_.store(State::CONNECTED);
+  XLOG(DBG2) << clientId_ << " connected successfully in batched mode";
+  auto getToken = [this]() {
+    return cancelSource_.withWLock(
+        [](auto& cancelSource) { return cancelSource->getToken(); });
+  };
+
+  auto gen = std::move(result).toAsyncGenerator();
+  try {
+    while (auto batch = co_await folly::coro::co_withCancellation(
+               getToken(), gen.next())) {
+      recvPacketBatch(std::move(*batch));
+    }
+  } catch (const folly::OperationCancelled&) {
+    XLOG(WARNING) << "Packet Stream Operation cancelled";
+  } catch (const std::exception& ex) {
+    XLOG(ERR) << clientId_ << " Server error: " << folly::exceptionStr(ex);
+    state_.store(State::INIT);
+  }
+  XLOG(DBG2) << "Client Cancellation Completed";
+  co_return;
+}
 #endif
 
 void PacketStreamClient::registerPortToServer(const std::string& port) {
@@ -14,7 +14,17 @@ namespace facebook {
 namespace fboss {
 class PacketStreamClient {
  public:
-  PacketStreamClient(const std::string& clientId, folly::EventBase* evb);
+  static constexpr int32_t kDefaultBatchCredits = 16;
+
+  // maxBatchSize > 0 connects with connectBatched() so the server may carry
+  // up to maxBatchSize packets per stream frame. batchCredits bounds how many
+  // frames the server may have in flight towards this client, see
+  // PacketStreamService::send().
+  PacketStreamClient(
+      const std::string& clientId,
+      folly::EventBase* evb,
+      int32_t maxBatchSize = 0,
+      int32_t batchCredits = kDefaultBatchCredits);
 
   virtual ~PacketStreamClient();
   void connectToServer(const std::string& ip, uint16_t port);
@@ -28,6 +38,9 @@ class PacketStreamClient {
   // will have the logic to do operation after receiving this
   // packet.
   virtual void recvPacket(TPacket&& packet) = 0;
+  // Clients using batched mode can override this to consume the IOBuf
+  // payloads directly, the default copies each packet into a TPacket.
+  virtual void recvPacketBatch(TPacketBatch&& batch);
 
  private:
   enum class State : uint16_t {
@@ -41,9 +54,12 @@ class PacketStreamClient {
 #if FOLLY_HAS_COROUTINES
   bool isConnectCancelled();
   folly::coro::Task<void> connect();
+  folly::coro::Task<void> connectBatched();
   folly::Synchronized<std::unique_ptr<folly::CancellationSource>> cancelSource_;
 #endif
   std::string clientId_;
+  int32_t maxBatchSize_;
+  int32_t batchCredits_;
   std::unique_ptr<PacketStreamAsyncClient> client_;
   folly::EventBase* evb_;
   std::atomic<State> state_{State::INIT};
@@ -1,18 +1,29 @@
 // Copyright 2004-present Facebook. All Rights Reserved.
 
 #include "fboss/agent/thrift_packet_stream/PacketStreamService.h"
+#include <folly/ScopeGuard.h>
 #include <folly/logging/xlog.h>
 
+DEFINE_int32(
+    packet_stream_batch_queue_depth,
+    64,
+    "Batches queued per batched packet stream client waiting for stream "
+    "credits, batches published while the queue is full are dropped");
+DEFINE_int32(
+    packet_stream_flush_interval_ms,
+    10,
+    "Longest time a partial batch waits before being published to a "
+    "batched packet stream client");
+
 namespace facebook {
 namespace fboss {
 
 PacketStreamService::~PacketStreamService() {
+  flushScheduler_.shutdown();
   try {
     clientMap_.withWLock([](auto& lockedMap) {
       for (auto& iter : lockedMap) {
-        auto& clientInfo = iter.second;
-        auto publisher = std::move(clientInfo.publisher_);
-        std::move(*publisher.get()).complete();
+        iter.second.complete();
       }
       lockedMap.clear();
     });
@@ -66,7 +77,180 @@ apache::thrift::ServerStream<TPacket> PacketStreamService::connect(
   }
 }
 
+apache::thrift::ServerStream<TPacketBatch> PacketStreamService::connectBatched(
+    std::unique_ptr<std::string> clientIdPtr,
+    int32_t maxBatchSize) {
+  try {
+    if (!clientIdPtr || clientIdPtr->empty()) {
+      XLOG(ERR) << "Invalid Client";
+      throw createTPacketException(
+          TPacketErrorCode::INVALID_CLIENT, "Invalid client");
+    }
+    if (maxBatchSize <= 0) {
+      XLOG(ERR) << "Invalid batch size " << maxBatchSize;
+      throw createTPacketException(
+          TPacketErrorCode::INTERNAL_ERROR, "Invalid batch size");
+    }
+    const auto& clientId = *clientIdPtr;
+    // Thrift only pulls from the pipe while the client has credits, so
+    // batches the client is not ready for wait in the bounded pipe.
+    auto [batches, pipe] =
+        BatchPipe::create(FLAGS_packet_stream_batch_queue_depth);
+    clientMap_.withWLock([client = clientId,
+                          maxBatchSize,
+                          &pipe = pipe](auto& lockedMap) {
+      lockedMap.emplace(
+          std::make_pair(client, ClientInfo(std::move(pipe), maxBatchSize)));
+    });
+    std::call_once(flushSchedulerStarted_, [this]() {
+      flushScheduler_.addFunction(
+          [this]() { flushAll(); },
+          std::chrono::milliseconds(FLAGS_packet_stream_flush_interval_ms),
+          "packetStreamFlush");
+      flushScheduler_.start();
+    });
+    clientConnected(clientId);
+    XLOG(DBG2) << clientId
+               << " connected successfully to PacketStreamService, batch size "
+               << maxBatchSize;
+    return streamBatches(clientId, std::move(batches));
+  } catch (const std::exception& except) {
+    XLOG(ERR) << "connectBatched failed with exp:" << except.what();
+    throw createTPacketException(
+        TPacketErrorCode::INTERNAL_ERROR, except.what());
+  }
+}
+
+void PacketStreamService::ClientInfo::publishLocked(
+    TPacketBatch& pending) const {
+  if (pending.packets()->empty()) {
+    return;
+  }
+  TPacketBatch batch;
+  batch.packets()->reserve(maxBatchSize_);
+  std::swap(batch, pending);
+  auto numPackets = batch.packets()->size();
+  // writing only enqueues on the pipe, do it under the lock so that
+  // batches from concurrent senders keep their order.
+  if (!batchPipe_->try_write(std::move(batch))) {
+    numDropped_->fetch_add(numPackets, std::memory_order_relaxed);
+  }
+}
+
+void PacketStreamService::ClientInfo::enqueue(TBatchedPacket&& packet) const {
+  auto pending = pendingBatch_->lock();
+  pending->packets()->push_back(std::move(packet));
+  if (pending->packets()->size() >= maxBatchSize_) {
+    publishLocked(*pending);
+  }
+}
+
+void PacketStreamService::ClientInfo::flush() const {
+  if (!isBatched()) {
+    return;
+  }
+  auto pending = pendingBatch_->lock();
+  publishLocked(*pending);
+}
+
+void PacketStreamService::ClientInfo::complete() {
+  if (isBatched()) {
+    flush();
+    auto pipe = std::move(batchPipe_);
+    std::move(*pipe.get()).close();
+  } else {
+    auto publisher = std::move(publisher_);
+    std::move(*publisher.get()).complete();
+  }
+}
+
+folly::coro::AsyncGenerator<TPacketBatch&&> PacketStreamService::streamBatches(
+    std::string clientId,
+    folly::coro::AsyncGenerator<TPacketBatch&&> batches) {
+  // Runs once the stream ends, whether the client cancelled it or the pipe
+  // was closed by complete()
+  SCOPE_EXIT {
+    clientGone(clientId);
+  };
+  while (auto batch = co_await batches.next()) {
+    co_yield std::move(*batch);
+  }
+}
+
+void PacketStreamService::clientGone(const std::string& clientId) {
+  // when the client is disconnected run this section.
+  XLOG(DBG2) << "Client disconnected: " << clientId;
+  auto erased = clientMap_.withWLock(
+      [&](auto& lockedMap) { return lockedMap.erase(clientId); });
+  if (erased) {
+    clientDisconnected(clientId);
+  }
+}
+
+void PacketStreamService::flushAll() {
+  clientMap_.withRLock([](auto& lockedMap) {
+    for (const auto& [clientId, clientInfo] : lockedMap) {
+      clientInfo.flush();
+    }
+  });
+}
+
+const PacketStreamService::ClientInfo& PacketStreamService::getRegisteredClient(
+    const ClientMap& clientMap,
+    const std::string& clientId,
+    const std::string& l2Port) const {
+  auto iter = clientMap.find(clientId);
+  if (iter == clientMap.end()) {
+    XLOG(ERR) << "Client '" << clientId << "' Not Connected";
+    throw createTPacketException(
+        TPacketErrorCode::CLIENT_NOT_CONNECTED, "client not connected");
+  }
+  const auto& clientInfo = iter->second;
+  auto portIter = clientInfo.portList_.find(l2Port);
+  if (portIter == clientInfo.portList_.end()) {
+    XLOG(ERR) << "Port '" << l2Port << "' not Registered";
+    throw createTPacketException(
+        TPacketErrorCode::PORT_NOT_REGISTERED, "PORT not registered");
+  }
+  return clientInfo;
+}
+
 void PacketStreamService::send(const std::string& clientId, TPacket&& packet) {
+  clientMap_.withRLock([&](auto& lockedMap) {
+    const auto& clientInfo =
+        getRegisteredClient(lockedMap, clientId, *packet.l2Port());
+    if (!clientInfo.isBatched()) {
+      clientInfo.publisher_->next(packet);
+      return;
+    }
+    TBatchedPacket batchedPacket;
+    batchedPacket.timestamp() = *packet.timestamp();
+    batchedPacket.l2Port() = std::move(*packet.l2Port());
+    batchedPacket.buf() =
+        std::move(*folly::IOBuf::fromString(std::move(*packet.buf())));
+    clientInfo.enqueue(std::move(batchedPacket));
+  });
+}
+
+void PacketStreamService::send(
+    const std::string& clientId,
+    TBatchedPacket&& packet) {
+  clientMap_.withRLock([&](auto& lockedMap) {
+    const auto& clientInfo =
+        getRegisteredClient(lockedMap, clientId, *packet.l2Port());
+    if (!clientInfo.isBatched()) {
+      TPacket tpacket;
+      tpacket.timestamp() = *packet.timestamp();
+      tpacket.l2Port() = std::move(*packet.l2Port());
+      tpacket.buf() = packet.buf()->moveToFbString().toStdString();
+      clientInfo.publisher_->next(std::move(tpacket));
+      return;
+    }
+    clientInfo.enqueue(std::move(packet));
+  });
+}
+
+void PacketStreamService::flush(const std::string& clientId) {
   clientMap_.withRLock([&](auto& lockedMap) {
     auto iter = lockedMap.find(clientId);
     if (iter == lockedMap.end()) {
@@ -74,14 +258,17 @@ void PacketStreamService::send(const std::string& clientId, TPacket&& packet) {
       throw createTPacketException(
           TPacketErrorCode::CLIENT_NOT_CONNECTED, "client not connected");
     }
-    const auto& clientInfo = iter->second;
-    auto portIter = clientInfo.portList_.find(*packet.l2Port());
-    if (portIter == clientInfo.portList_.end()) {
-      XLOG(ERR) << "Port '" << *packet.l2Port() << "' not Registered";
-      throw createTPacketException(
-          TPacketErrorCode::PORT_NOT_REGISTERED, "PORT not registered");
+    iter->second.flush();
+  });
+}
+
+uint64_t PacketStreamService::numDropped(const std::string& clientId) {
+  return clientMap_.withRLock([&](auto& lockedMap) -> uint64_t {
+    auto iter = lockedMap.find(clientId);
+    if (iter == lockedMap.end() || !iter->second.isBatched()) {
+      return 0;
     }
-    clientInfo.publisher_->next(packet);
+    return iter->second.numDropped_->load(std::memory_order_relaxed);
   });
 }
 
@@ -186,9 +373,7 @@ void PacketStreamService::disconnect(std::unique_ptr<std::string> clientIdPtr) {
       throw createTPacketException(
           TPacketErrorCode::CLIENT_NOT_CONNECTED, "client not connected");
     }
-    auto& clientInfo = iter->second;
-    auto publisher = std::move(clientInfo.publisher_);
-    std::move(*publisher.get()).complete();
+    iter->second.complete();
     lockedMap.erase(iter);
     clientDisconnected(clientId);
   });
@@ -4,6 +4,17 @@
 
 #include <common/fb303/cpp/FacebookBase2.h>
 #include <fboss/agent/if/gen-cpp2/PacketStream.tcc>
+#include <folly/experimental/FunctionScheduler.h>
+#include <folly/experimental/coro/AsyncGenerator.h>
+#include <folly/experimental/coro/AsyncPipe.h>
+#include <gflags/gflags.h>
+
+#include <atomic>
+#include <mutex>
+
+DECLARE_int32(packet_stream_batch_queue_depth);
+DECLARE_int32(packet_stream_flush_interval_ms);
+
 namespace facebook {
 namespace fboss {
 class PacketStreamService : virtual public PacketStreamSvIf,
@@ -15,6 +26,19 @@ class PacketStreamService : virtual public PacketStreamSvIf,
 
   // helper functions.
   void send(const std::string& clientId, TPacket&& packet);
+  // For clients connected through connectBatched() the packet is queued in
+  // the client's pending batch, which is published once it holds
+  // maxBatchSize packets, flush() is called, or at the latest after
+  // --packet_stream_flush_interval_ms. The payload IOBuf chain is moved into
+  // the batch without copying.
+  //
+  // Published batches wait in a queue of --packet_stream_batch_queue_depth
+  // batches per client, which the stream drains as the client grants
+  // credits. Batches published while the queue is full are dropped.
+  void send(const std::string& clientId, TBatchedPacket&& packet);
+  void flush(const std::string& clientId);
+  // Packets dropped for a batched client whose queue was full
+  uint64_t numDropped(const std::string& clientId);
   bool isClientConnected(const std::string& clientId);
   bool isPortRegistered(const std::string& clientId, const std::string& port);
 
@@ -24,6 +48,9 @@ class PacketStreamService : virtual public PacketStreamSvIf,
   }
   apache::thrift::ServerStream<TPacket> connect(
       std::unique_ptr<std::string> clientId) override;
+  apache::thrift::ServerStream<TPacketBatch> connectBatched(
+      std::unique_ptr<std::string> clientId,
+      int32_t maxBatchSize) override;
   void registerPort(
       std::unique_ptr<std::string> clientId,
       std::unique_ptr<std::string> l2Port) override;
@@ -45,16 +72,52 @@ class PacketStreamService : virtual public PacketStreamSvIf,
       const std::string& l2Port) = 0;
 
  private:
+  using BatchPipe = folly::coro::
+      BoundedAsyncPipe<TPacketBatch, false /* SingleProducer */>;
+  using PendingBatch = folly::Synchronized<TPacketBatch, std::mutex>;
+
   struct ClientInfo {
     explicit ClientInfo(apache::thrift::ServerStreamPublisher<TPacket> pub)
         : publisher_(
               std::make_unique<apache::thrift::ServerStreamPublisher<TPacket>>(
                   std::move(pub))) {}
+    ClientInfo(BatchPipe pipe, size_t maxBatchSize)
+        : batchPipe_(std::make_unique<BatchPipe>(std::move(pipe))),
+          maxBatchSize_(maxBatchSize),
+          pendingBatch_(std::make_unique<PendingBatch>()),
+          numDropped_(std::make_unique<std::atomic<uint64_t>>(0)) {}
+    bool isBatched() const {
+      return batchPipe_ != nullptr;
+    }
+    void enqueue(TBatchedPacket&& packet) const;
+    void flush() const;
+    void publishLocked(TPacketBatch& pending) const;
+    void complete();
+
     std::unordered_set<std::string> portList_;
     std::unique_ptr<apache::thrift::ServerStreamPublisher<TPacket>> publisher_;
+    std::unique_ptr<BatchPipe> batchPipe_;
+    size_t maxBatchSize_{1};
+    std::unique_ptr<PendingBatch> pendingBatch_;
+    std::unique_ptr<std::atomic<uint64_t>> numDropped_;
   };
   using ClientMap = std::unordered_map<std::string, ClientInfo>;
+  const ClientInfo& getRegisteredClient(
+      const ClientMap& clientMap,
+      const std::string& clientId,
+      const std::string& l2Port) const;
+  // Stream of the batches written to a client's pipe, which runs
+  // clientGone() once the client goes away.
+  folly::coro::AsyncGenerator<TPacketBatch&&> streamBatches(
+      std::string clientId,
+      folly::coro::AsyncGenerator<TPacketBatch&&> batches);
+  void clientGone(const std::string& clientId);
+  void flushAll();
+
   folly::Synchronized<ClientMap> clientMap_;
+  // Flushes partial batches, started by the first batched client
+  folly::FunctionScheduler flushScheduler_;
+  std::once_flag flushSchedulerStarted_;
 };
 
 } // namespace fboss
@@ -0,0 +1,146 @@
+// Copyright 2004-present Facebook.  All rights reserved.
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <folly/io/async/ScopedEventBaseThread.h>
+#include <folly/synchronization/Baton.h>
+#include <sys/resource.h>
+#include <thrift/lib/cpp2/util/ScopedServerInterfaceThread.h>
+#include "fboss/agent/thrift_packet_stream/PacketStreamClient.h"
+#include "fboss/agent/thrift_packet_stream/PacketStreamService.h"
+
+/*
+ * Loopback benchmark of the packet stream: a PacketStreamService and a
+ * PacketStreamClient talk over ::1 and we push kNumPackets through either the
+ * per packet stream (connect) or the batched one (connectBatched). Reports
+ * packets per second and CPU time (user + sys of this process, which hosts
+ * both ends) per packet.
+ */
+
+using namespace facebook::fboss;
+
+namespace {
+
+constexpr auto kClient = "benchClient";
+constexpr auto kPort = "eth0";
+constexpr size_t kNumPackets = 200000;
+constexpr size_t kPacketSize = 256;
+
+class BenchPacketStreamService : public PacketStreamService {
+ public:
+  BenchPacketStreamService() : PacketStreamService("PacketStreamBenchmark") {}
+  void clientConnected(const std::string& /*clientId*/) override {}
+  void clientDisconnected(const std::string& /*clientId*/) override {}
+  void addPort(const std::string& /*clientId*/, const std::string& /*l2Port*/)
+      override {}
+  void removePort(
+      const std::string& /*clientId*/,
+      const std::string& /*l2Port*/) override {}
+};
+
+class BenchPacketStreamClient : public PacketStreamClient {
+ public:
+  BenchPacketStreamClient(folly::EventBase* evb, int32_t maxBatchSize)
+      : PacketStreamClient(kClient, evb, maxBatchSize) {}
+
+  void recvPacket(TPacket&& /*packet*/) override {
+    received(1);
+  }
+  void recvPacketBatch(TPacketBatch&& batch) override {
+    received(batch.packets()->size());
+  }
+
+  void expect(size_t count) {
+    expected_ = count;
+    received_ = 0;
+    done_.reset();
+  }
+  void wait() {
+    done_.wait();
+  }
+
+ private:
+  void received(size_t count) {
+    if ((received_ += count) == expected_) {
+      done_.post();
+    }
+  }
+  std::atomic<size_t> received_{0};
+  size_t expected_{0};
+  folly::Baton<> done_;
+};
+
+std::chrono::microseconds cpuTime() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return std::chrono::seconds(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+      std::chrono::microseconds(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+void runPacketStreamBenchmark(
+    folly::UserCounters& counters,
+    int32_t maxBatchSize) {
+  folly::BenchmarkSuspender suspender;
+  auto handler = std::make_shared<BenchPacketStreamService>();
+  apache::thrift::ScopedServerInterfaceThread server(handler);
+  folly::ScopedEventBaseThread clientThread;
+  BenchPacketStreamClient client(clientThread.getEventBase(), maxBatchSize);
+  client.connectToServer("::1", server.getPort());
+  while (!client.isConnectedToServer()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  client.registerPortToServer(kPort);
+  auto payload = folly::IOBuf::create(kPacketSize);
+  payload->append(kPacketSize);
+  client.expect(kNumPackets);
+
+  auto cpuStart = cpuTime();
+  auto start = std::chrono::steady_clock::now();
+  suspender.dismiss();
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    if (maxBatchSize > 0) {
+      TBatchedPacket pkt;
+      *pkt.l2Port() = kPort;
+      // clone shares the payload, no copy of the packet data
+      *pkt.buf() = std::move(*payload->clone());
+      handler->send(kClient, std::move(pkt));
+    } else {
+      TPacket pkt;
+      *pkt.l2Port() = kPort;
+      *pkt.buf() = std::string(kPacketSize, 'x');
+      handler->send(kClient, std::move(pkt));
+    }
+  }
+  if (maxBatchSize > 0) {
+    handler->flush(kClient);
+  }
+  client.wait();
+  suspender.rehire();
+
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  auto cpu = cpuTime() - cpuStart;
+  counters["pps"] = kNumPackets * 1000000 / elapsed.count();
+  counters["cpu_ns_per_pkt"] = cpu.count() * 1000 / kNumPackets;
+  client.cancel();
+}
+
+} // namespace
+
+BENCHMARK_COUNTERS(PacketStreamPerPacket, counters) {
+  runPacketStreamBenchmark(counters, 0);
+}
+
+BENCHMARK_COUNTERS(PacketStreamBatched16, counters) {
+  runPacketStreamBenchmark(counters, 16);
+}
+
+BENCHMARK_COUNTERS(PacketStreamBatched64, counters) {
+  runPacketStreamBenchmark(counters, 64);
+}
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
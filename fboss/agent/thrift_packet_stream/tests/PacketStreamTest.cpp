@@ -11,6 +11,9 @@
 #include "fboss/agent/thrift_packet_stream/PacketStreamClient.h"
 #include "fboss/agent/thrift_packet_stream/PacketStreamService.h"
 
+#include <chrono>
+#include <thread>
+
 using namespace testing;
 using namespace facebook::fboss;
 
@@ -52,8 +55,9 @@ class DerivedPacketStreamClient : public PacketStreamClient {
   DerivedPacketStreamClient(
       const std::string& clientId,
       folly::EventBase* evb,
-      std::shared_ptr<folly::Baton<>> baton)
-      : PacketStreamClient(clientId, evb), baton_(baton) {}
+      std::shared_ptr<folly::Baton<>> baton,
+      int32_t maxBatchSize = 0)
+      : PacketStreamClient(clientId, evb, maxBatchSize), baton_(baton) {}
 
   void recvPacket(TPacket&& packet) override {
     {
@@ -138,6 +142,29 @@ class PacketStreamTest : public Test {
     *pkt.buf() = g_pktCnt;
     EXPECT_NO_THROW(handler_->send(g_client, std::move(pkt)));
   }
+  void sendBatchedPkts(const std::string& port, int count) {
+    for (auto i = 0; i < count; i++) {
+      TBatchedPacket pkt;
+      *pkt.l2Port() = port;
+      *pkt.buf() = std::move(*folly::IOBuf::copyBuffer(g_pktCnt));
+      EXPECT_NO_THROW(handler_->send(g_client, std::move(pkt)));
+    }
+  }
+
+  template <typename Pred>
+  bool waitFor(
+      Pred pred,
+      std::chrono::milliseconds timeout = std::chrono::seconds(5)) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!pred()) {
+      if (std::chrono::steady_clock::now() > deadline) {
+        return false;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+  }
+
   std::shared_ptr<folly::Baton<>> baton_;
   std::shared_ptr<DerivedPacketStreamService> handler_;
   std::unique_ptr<apache::thrift::ScopedServerInterfaceThread> server_;
@@ -187,6 +214,67 @@ TEST_F(PacketStreamTest, PacketSendMultiple) {
   clientReset(std::move(streamClient));
 }
 
+TEST_F(PacketStreamTest, PacketSendBatched) {
+  // Partial batches only go out on flush()
+  gflags::FlagSaver flagSaver;
+  FLAGS_packet_stream_flush_interval_ms = 60000;
+  std::string port(*g_ports.begin());
+  auto baton = std::make_shared<folly::Baton<>>();
+  auto streamClient = std::make_unique<DerivedPacketStreamClient>(
+      g_client, clientThread_.getEventBase(), baton, 4 /* maxBatchSize */);
+  tryConnect(baton, *streamClient);
+  EXPECT_NO_THROW(streamClient->registerPortToServer(port));
+  streamClient->setBaton(nullptr);
+  sendBatchedPkts(port, 10);
+  // two full batches went out, the remaining two wait for a flush
+  EXPECT_TRUE(waitFor([&]() { return streamClient->getPckCnt(port) == 8; }));
+  EXPECT_NO_THROW(handler_->flush(g_client));
+  EXPECT_TRUE(waitFor([&]() { return streamClient->getPckCnt(port) == 10; }));
+
+  TBatchedPacket unregistered;
+  *unregistered.l2Port() = "testRandom";
+  EXPECT_THROW(
+      handler_->send(g_client, std::move(unregistered)), TPacketException);
+  clientReset(std::move(streamClient));
+}
+
+TEST_F(PacketStreamTest, PacketSendBatchedFlushInterval) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_packet_stream_flush_interval_ms = 10;
+  std::string port(*g_ports.begin());
+  auto baton = std::make_shared<folly::Baton<>>();
+  auto streamClient = std::make_unique<DerivedPacketStreamClient>(
+      g_client, clientThread_.getEventBase(), baton, 4 /* maxBatchSize */);
+  tryConnect(baton, *streamClient);
+  EXPECT_NO_THROW(streamClient->registerPortToServer(port));
+  streamClient->setBaton(nullptr);
+  // A partial batch goes out without an explicit flush()
+  sendBatchedPkts(port, 2);
+  EXPECT_TRUE(waitFor([&]() { return streamClient->getPckCnt(port) == 2; }));
+  clientReset(std::move(streamClient));
+}
+
+TEST_F(PacketStreamTest, PacketSendBatchedQueueFull) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_packet_stream_batch_queue_depth = 1;
+  std::string port(*g_ports.begin());
+  auto baton = std::make_shared<folly::Baton<>>();
+  auto streamClient = std::make_unique<DerivedPacketStreamClient>(
+      g_client, clientThread_.getEventBase(), baton, 1 /* maxBatchSize */);
+  tryConnect(baton, *streamClient);
+  EXPECT_NO_THROW(streamClient->registerPortToServer(port));
+  streamClient->setBaton(nullptr);
+  // Sending faster than the client consumes overflows the one batch queue,
+  // every packet is either received or counted as dropped
+  constexpr auto kNumPkts = 1000;
+  sendBatchedPkts(port, kNumPkts);
+  EXPECT_TRUE(waitFor([&]() {
+    return streamClient->getPckCnt(port) + handler_->numDropped(g_client) ==
+        kNumPkts;
+  }));
+  clientReset(std::move(streamClient));
+}
+
 TEST_F(PacketStreamTest, UnregisterPortToServerFail) {
   std::string port(*g_ports.begin());
   auto baton = std::make_shared<folly::Baton<>>();
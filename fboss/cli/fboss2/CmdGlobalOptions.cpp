@@ -42,6 +42,16 @@ void CmdGlobalOptions::init(CLI::App& app) {
          qsfpThriftPort_,
          "QsfpService thrift port to connect to")
       ->check(CLI::PositiveNumber);
+  app.add_option(
+         "--max-parallel-hosts",
+         maxParallelHosts_,
+         "Maximum number of hosts to query concurrently")
+      ->check(CLI::PositiveNumber);
+  app.add_option(
+         "--host-timeout",
+         hostTimeoutMs_,
+         "Per host thrift receive timeout in milliseconds")
+      ->check(CLI::PositiveNumber);
   app.add_option(
       "--color", color_, "color (no, yes => yes for tty and no for pipe)");
   app.add_option(
@@ -441,6 +441,14 @@ class CmdGlobalOptions {
     return color_;
   }
 
+  int getMaxParallelHosts() const {
+    return maxParallelHosts_;
+  }
+
+  int getHostTimeoutMs() const {
+    return hostTimeoutMs_;
+  }
+
   // Setters for testing purposes
   void setSslPolicy(SSLPolicy& sslPolicy) {
     sslPolicy_ = sslPolicy;
@@ -474,6 +482,14 @@ class CmdGlobalOptions {
     fsdbThriftPort_ = port;
   }
 
+  void setMaxParallelHosts(int maxParallelHosts) {
+    maxParallelHosts_ = maxParallelHosts;
+  }
+
+  void setHostTimeoutMs(int hostTimeoutMs) {
+    hostTimeoutMs_ = hostTimeoutMs;
+  }
+
   void setFilterInput(std::string& filter) {
     filter_ = filter;
   }
@@ -516,6 +532,8 @@ class CmdGlobalOptions {
   int dataCorralServiceThriftPort_{5971};
   int vipInjectorThriftPort_{3333};
   std::string color_{"yes"};
+  int maxParallelHosts_{64};
+  int hostTimeoutMs_{45000};
   std::string filter_;
   std::string aggregate_;
   bool aggregateAcrossDevices_{false};
@@ -67,12 +67,17 @@
 #include "folly/futures/Future.h"
 #include "thrift/lib/cpp2/protocol/Serializer.h"
 
+#include <folly/ScopeGuard.h>
 #include <folly/Singleton.h>
+#include <folly/json.h>
 #include <folly/logging/xlog.h>
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <future>
 #include <iostream>
 #include <stdexcept>
+#include <thread>
 
 #include "fboss/cli/fboss2/commands/show/acl/gen-cpp2/model_visitation.h"
 #include "fboss/cli/fboss2/commands/show/agent/gen-cpp2/model_visitation.h"
@@ -108,6 +113,12 @@
 #include "fboss/lib/phy/gen-cpp2/phy_visitation.h"
 #include "fboss/lib/phy/gen-cpp2/prbs_visitation.h"
 
+/*
+ * Results are rendered in host order as soon as each host's future is ready,
+ * so output for the first hosts is streamed while later hosts are still being
+ * queried. Each result is released right after it is printed so that memory
+ * does not grow with the number of hosts.
+ */
 template <typename CmdTypeT>
 void printTabular(
     CmdTypeT& cmd,
@@ -117,16 +128,20 @@ void printTabular(
     std::ostream& out,
     std::ostream& err) {
   for (auto& result : results) {
-    auto [host, data, errStr] = result.get();
-    if (results.size() != 1) {
-      out << host << "::" << std::endl << std::string(80, '=') << std::endl;
-    }
+    {
+      const auto& [host, data, errStr] = result.get();
+      if (results.size() != 1) {
+        out << host << "::" << std::endl << std::string(80, '=') << std::endl;
+      }
 
-    if (errStr.empty()) {
-      cmd.printOutput(data);
-    } else {
-      err << errStr << std::endl << std::endl;
+      if (errStr.empty()) {
+        cmd.printOutput(data);
+      } else {
+        err << errStr << std::endl << std::endl;
+      }
+      out.flush();
     }
+    result = {};
   }
 }
 
@@ -138,20 +153,31 @@ void printJson(
         results,
     std::ostream& out,
     std::ostream& err) {
-  std::map<std::string, typename CmdTypeT::RetType> hostResults;
+  // Emit the host -> result map one entry at a time instead of building the
+  // whole map in memory first. The output is identical to serializing a
+  // std::map<std::string, RetType>.
+  bool first = true;
+  out << "{";
   for (auto& result : results) {
-    auto [host, data, errStr] = result.get();
-    if (errStr.empty()) {
-      hostResults[host] = data;
-    } else {
-      err << host << "::" << std::endl << std::string(80, '=') << std::endl;
-      err << errStr << std::endl << std::endl;
+    {
+      const auto& [host, data, errStr] = result.get();
+      if (errStr.empty()) {
+        if (!first) {
+          out << ",";
+        }
+        first = false;
+        out << folly::toJson(host) << ":"
+            << apache::thrift::SimpleJSONSerializer::serialize<std::string>(
+                   data);
+        out.flush();
+      } else {
+        err << host << "::" << std::endl << std::string(80, '=') << std::endl;
+        err << errStr << std::endl << std::endl;
+      }
     }
+    result = {};
   }
-
-  out << apache::thrift::SimpleJSONSerializer::serialize<std::string>(
-             hostResults)
-      << std::endl;
+  out << "}" << std::endl;
 }
 
 template <typename CmdTypeT>
@@ -476,21 +502,60 @@ void CmdHandler<CmdTypeT, CmdTypeTraits>::runHelper() {
   }
 
   auto hosts = getHosts();
+  // JSON output is keyed by host name, keep it in the same order a
+  // std::map<std::string, RetType> would serialize in.
+  if (CmdGlobalOptions::getInstance()->getFmt().isJson()) {
+    std::sort(hosts.begin(), hosts.end());
+    hosts.erase(std::unique(hosts.begin(), hosts.end()), hosts.end());
+  }
 
+  std::vector<std::promise<std::tuple<std::string, RetType, std::string>>>
+      promiseList(hosts.size());
   std::vector<std::shared_future<std::tuple<std::string, RetType, std::string>>>
       futureList;
+  futureList.reserve(hosts.size());
+  for (auto& promise : promiseList) {
+    futureList.push_back(promise.get_future().share());
+  }
 
-  for (const auto& host : hosts) {
-    futureList.push_back(std::async(
-                             std::launch::async,
-                             &CmdHandler::asyncHandler,
-                             this,
-                             host,
-                             parsedFilters,
-                             validFilters)
-                             .share());
+  // Bounded fan-out: a fixed number of workers pull the next host to query,
+  // rather than spawning one thread per host. Hosts are handed out in order so
+  // the printers below can start rendering as soon as the first hosts finish.
+  std::atomic<size_t> nextHost{0};
+  std::atomic<bool> anyFailed{false};
+  auto numWorkers = std::min<size_t>(
+      hosts.size(),
+      std::max(CmdGlobalOptions::getInstance()->getMaxParallelHosts(), 1));
+  std::vector<std::thread> workers;
+  workers.reserve(numWorkers);
+  for (size_t i = 0; i < numWorkers; ++i) {
+    workers.emplace_back([&]() {
+      for (auto idx = nextHost++; idx < hosts.size(); idx = nextHost++) {
+        try {
+          auto result = asyncHandler(hosts[idx], parsedFilters, validFilters);
+          if (!std::get<2>(result).empty()) {
+            anyFailed = true;
+          }
+          promiseList[idx].set_value(std::move(result));
+        } catch (...) {
+          anyFailed = true;
+          promiseList[idx].set_exception(std::current_exception());
+        }
+      }
+    });
   }
 
+  auto joinWorkers = [&workers]() {
+    for (auto& worker : workers) {
+      if (worker.joinable()) {
+        worker.join();
+      }
+    }
+  };
+  SCOPE_EXIT {
+    joinWorkers();
+  };
+
   if (!parsedAggregationInput.has_value()) {
     if (CmdGlobalOptions::getInstance()->getFmt().isJson()) {
       printJson(impl(), futureList, std::cout, std::cerr);
@@ -501,12 +566,10 @@ void CmdHandler<CmdTypeT, CmdTypeTraits>::runHelper() {
     printAggregate<CmdTypeT>(parsedAggregationInput, futureList, validAggs);
   }
 
-  for (auto& fut : futureList) {
-    auto [host, data, errStr] = fut.get();
-    // exit with failure if any of the calls failed
-    if (!errStr.empty()) {
-      throw std::runtime_error("Error in command execution");
-    }
+  joinWorkers();
+  // exit with failure if any of the calls failed
+  if (anyFailed) {
+    throw std::runtime_error("Error in command execution");
   }
 }
 
@@ -22,6 +22,7 @@
 
 #include <unistd.h>
 #include <algorithm>
+#include <set>
 
 namespace facebook::fboss {
 
@@ -50,15 +51,34 @@ class CmdShowPort : public CmdHandler<CmdShowPort, CmdShowPortTraits> {
         utils::createClient<facebook::fboss::FbossCtrlAsyncClient>(hostInfo);
     client->sync_getAllPortInfo(portEntries);
 
-    try {
-      auto qsfpService =
-          utils::createClient<facebook::fboss::QsfpServiceAsyncClient>(
-              hostInfo);
+    // Only ask qsfp_service for the transceivers backing the queried ports.
+    // Breakout ports share a transceiver, so dedupe the IDs.
+    if (!queriedPorts.data().empty()) {
+      std::unordered_set<std::string> queriedSet(
+          queriedPorts.data().begin(), queriedPorts.data().end());
+      std::set<int32_t> tcvrIds;
+      for (const auto& [_, portInfo] : portEntries) {
+        if (auto tcvrId = portInfo.transceiverIdx();
+            tcvrId && queriedSet.count(portInfo.get_name())) {
+          tcvrIds.insert(tcvrId->get_transceiverId());
+        }
+      }
+      requiredTransceiverEntries.assign(tcvrIds.begin(), tcvrIds.end());
+    }
 
-      qsfpService->sync_getTransceiverInfo(
-          transceiverEntries, requiredTransceiverEntries);
-    } catch (apache::thrift::transport::TTransportException& e) {
-      std::cerr << "Cannot connect to qsfp_service\n";
+    // An empty list returns every transceiver on the box, so skip the call
+    // when none of the queried ports has one.
+    if (queriedPorts.data().empty() || !requiredTransceiverEntries.empty()) {
+      try {
+        auto qsfpService =
+            utils::createClient<facebook::fboss::QsfpServiceAsyncClient>(
+                hostInfo);
+
+        qsfpService->sync_getTransceiverInfo(
+            transceiverEntries, requiredTransceiverEntries);
+      } catch (apache::thrift::transport::TTransportException& e) {
+        std::cerr << "Cannot connect to qsfp_service\n";
+      }
     }
 
     return createModel(portEntries, transceiverEntries, queriedPorts.data());
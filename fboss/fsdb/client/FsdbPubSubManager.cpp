@@ -357,6 +357,19 @@ void FsdbPubSubManager::addStatPathSubscription(
       FsdbStreamClient::ServerOptions(fsdbHost, fsdbPort));
 }
 
+void FsdbPubSubManager::addStateDeltaSubscription(
+    const MultiPath& subscribePaths,
+    FsdbStreamClient::FsdbStreamStateChangeCb stateChangeCb,
+    FsdbExtDeltaSubscriber::FsdbOperDeltaUpdateCb operDeltaCb,
+    FsdbStreamClient::ServerOptions&& serverOptions) {
+  addSubscriptionImpl<FsdbExtDeltaSubscriber>(
+      toExtendedOperPath(subscribePaths),
+      stateChangeCb,
+      operDeltaCb,
+      false /*subscribeStat*/,
+      std::move(serverOptions));
+}
+
 void FsdbPubSubManager::addStatePathSubscription(
     const Path& subscribePath,
     FsdbStreamClient::FsdbStreamStateChangeCb stateChangeCb,
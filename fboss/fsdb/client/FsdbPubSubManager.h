@@ -113,6 +113,11 @@ class FsdbPubSubManager {
 
   /* Apis that use ServerOptions */
   // TODO: change all above apis to use server options
+  void addStateDeltaSubscription(
+      const MultiPath& subscribePaths,
+      FsdbStreamClient::FsdbStreamStateChangeCb stateChangeCb,
+      FsdbExtDeltaSubscriber::FsdbOperDeltaUpdateCb operDeltaCb,
+      FsdbStreamClient::ServerOptions&& serverOptions);
   void addStatePathSubscription(
       const Path& subscribePath,
       FsdbStreamClient::FsdbStreamStateChangeCb stateChangeCb,
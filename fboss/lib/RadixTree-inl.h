@@ -52,6 +52,14 @@ RadixTree<IPADDRTYPE, T, TreeTraits>::longestMatchImpl(
   TreeNode* parent = nullptr;
   TreeNode* lastValueNodeSeen = nullptr;
   auto curNode = root_.get();
+  if (!trail && masklen >= kStrideBits && !strideIndex_.empty()) {
+    // Skip the nodes covering the first kStrideBits bits in one step. The
+    // node we start at covers toMatch, so we never need to back up to its
+    // parent.
+    const auto& entry = strideIndex_[toMatch.bytes()[0]];
+    curNode = entry.start;
+    lastValueNodeSeen = entry.lastValueAbove;
+  }
   auto done = false;
   while (curNode && !done) {
     auto searchDirection = curNode->searchDirection(toMatch, masklen);
@@ -118,6 +126,7 @@ RadixTree<IPADDRTYPE, T, TreeTraits>::insert(
   auto foundExact = false;
   // Can't trust the clients to have 0s in all bits after mask length
   auto toAdd = ipaddr.mask(mask);
+  const auto oldRoot = root_.get();
   auto bestMatch = longestMatchImpl(
       toAdd, mask, foundExact, true /*include non value nodes*/);
   if (foundExact) {
@@ -126,6 +135,7 @@ RadixTree<IPADDRTYPE, T, TreeTraits>::insert(
     if (bestMatch->isNonValueNode()) {
       bestMatch->setValue(std::forward<VALUE>(value));
       ++size_;
+      updateStrideIndex(mask <= kStrideBits);
       return std::make_pair(traits_.makeItr(bestMatch), true);
     } else {
       // Prefix already exists in the tree
@@ -135,6 +145,8 @@ RadixTree<IPADDRTYPE, T, TreeTraits>::insert(
   auto newNode = makeNode(toAdd, mask, std::forward<VALUE>(value));
   // Cache new node pointer since the unique_ptr maybe moved
   auto newNodeRaw = newNode.get();
+  // Whether we added a node no longer than kStrideBits
+  auto strideNodeAdded = mask <= kStrideBits;
   if (!bestMatch) {
     // No match found
     if (!root_) {
@@ -146,7 +158,7 @@ RadixTree<IPADDRTYPE, T, TreeTraits>::insert(
       // specific root.
       auto prefix = IPADDRTYPE::longestCommonPrefix(
           {root_->ipAddress(), root_->masklen()}, {toAdd, mask});
-      std::unique_ptr<TreeNode> newRoot = nullptr;
+      NodePtr newRoot = nullptr;
       if (prefix.first == toAdd && prefix.second == mask) {
         // To be added node is the new root
         newRoot = std::move(newNode);
@@ -217,7 +229,8 @@ RadixTree<IPADDRTYPE, T, TreeTraits>::insert(
         // bestMatchChild and new node.
         auto internalNode = makeNode(prefix.first, prefix.second);
         auto internalNodeRaw = internalNode.get();
-        std::unique_ptr<TreeNode> oldBestMatchChild = nullptr;
+        strideNodeAdded = strideNodeAdded || prefix.second <= kStrideBits;
+        NodePtr oldBestMatchChild = nullptr;
         if (toAddDirection == TreeDirection::LEFT) {
           oldBestMatchChild = bestMatch->resetLeft(std::move(internalNode));
         } else {
@@ -237,7 +250,7 @@ RadixTree<IPADDRTYPE, T, TreeTraits>::insert(
         CHECK(internalNode == nullptr);
       } else {
         // New node needs to be inserted  b/w bestMatch and bestMatchChild
-        std::unique_ptr<TreeNode> oldBestMatchChild = nullptr;
+        NodePtr oldBestMatchChild = nullptr;
         if (toAddDirection == TreeDirection::LEFT) {
           oldBestMatchChild = bestMatch->resetLeft(std::move(newNode));
         } else {
@@ -258,6 +271,7 @@ RadixTree<IPADDRTYPE, T, TreeTraits>::insert(
   }
   CHECK(newNode == nullptr);
   ++size_;
+  updateStrideIndex(strideNodeAdded || root_.get() != oldRoot);
   return std::make_pair(traits_.makeItr(newNodeRaw), true);
 }
 
@@ -278,6 +292,9 @@ bool RadixTree<IPADDRTYPE, T, TreeTraits>::erase(TreeNode* toDelete) {
     return false;
   }
   CHECK(toDelete->isValueNode());
+  const auto oldRoot = root_.get();
+  // Whether we removed or changed a node no longer than kStrideBits
+  auto strideNodeRemoved = toDelete->masklen() <= kStrideBits;
   auto parent = toDelete->parent();
   auto left = toDelete->left();
   auto right = toDelete->right();
@@ -335,6 +352,8 @@ bool RadixTree<IPADDRTYPE, T, TreeTraits>::erase(TreeNode* toDelete) {
         // since otherwise we would have a non value node with just
         // one child.
         TreeNode* grandParent = parent->parent();
+        strideNodeRemoved =
+            strideNodeRemoved || parent->masklen() <= kStrideBits;
         // toDeleteSibling must be non null since toDelete's parent
         // was a non value node, which always has 2 children.
         auto toDeleteSibling = parent->left() ? parent->resetLeft(nullptr)
@@ -383,6 +402,7 @@ bool RadixTree<IPADDRTYPE, T, TreeTraits>::erase(TreeNode* toDelete) {
     }
   }
   --size_;
+  updateStrideIndex(strideNodeRemoved || root_.get() != oldRoot);
   return true;
 }
 
@@ -402,27 +422,68 @@ bool RadixTree<IPADDRTYPE, T, TreeTraits>::radixSubTreesEqual(
 }
 
 template <typename IPADDRTYPE, typename T, typename TreeTraits>
-std::unique_ptr<typename RadixTree<IPADDRTYPE, T, TreeTraits>::TreeNode>
-RadixTree<IPADDRTYPE, T, TreeTraits>::cloneSubTree(const TreeNode* node) {
+typename RadixTree<IPADDRTYPE, T, TreeTraits>::NodePtr
+RadixTree<IPADDRTYPE, T, TreeTraits>::cloneSubTree(
+    const TreeNode* node,
+    NodeAllocator* allocator) {
   if (!node) {
     return nullptr;
   }
-  std::unique_ptr<TreeNode> copy;
+  NodePtr copy;
   if (node->isValueNode()) {
-    copy = std::make_unique<TreeNode>(
-        node->ipAddress(),
-        node->masklen(),
-        node->value(),
-        node->nodeDeleteCallback());
+    copy = allocator->create(node->ipAddress(), node->masklen(), node->value());
   } else {
-    copy = std::make_unique<TreeNode>(
-        node->ipAddress(), node->masklen(), node->nodeDeleteCallback());
+    copy = allocator->create(node->ipAddress(), node->masklen());
   }
-  copy->resetLeft(cloneSubTree(node->left()));
-  copy->resetRight(cloneSubTree(node->right()));
+  copy->resetLeft(cloneSubTree(node->left(), allocator));
+  copy->resetRight(cloneSubTree(node->right(), allocator));
   return copy;
 }
 
+template <typename IPADDRTYPE, typename T, typename TreeTraits>
+void RadixTree<IPADDRTYPE, T, TreeTraits>::updateStrideIndex(bool affected) {
+  if (size_ < kStrideIndexMinSize) {
+    if (!strideIndex_.empty()) {
+      strideIndex_ = std::vector<StrideEntry>();
+    }
+    return;
+  }
+  if (!affected && !strideIndex_.empty()) {
+    // Only nodes longer than kStrideBits, below the ones the index
+    // points to, changed
+    return;
+  }
+  auto root = root_.get();
+  // Addresses not covered by any node no longer than kStrideBits are
+  // searched from the root, or not at all if the root is that short.
+  strideIndex_.assign(
+      1 << kStrideBits,
+      StrideEntry{root->masklen() > kStrideBits ? root : nullptr, nullptr});
+  fillStrideIndex(root, nullptr);
+}
+
+template <typename IPADDRTYPE, typename T, typename TreeTraits>
+void RadixTree<IPADDRTYPE, T, TreeTraits>::fillStrideIndex(
+    TreeNode* node,
+    TreeNode* lastValueAbove) {
+  if (!node || node->masklen() > kStrideBits) {
+    return;
+  }
+  // Node covers the entries of all values of the bits past its mask,
+  // its children then overwrite the ones they cover.
+  auto numEntries = 1 << (kStrideBits - node->masklen());
+  auto first = node->ipAddress().bytes()[0] & ~(numEntries - 1);
+  std::fill_n(
+      strideIndex_.begin() + first,
+      numEntries,
+      StrideEntry{node, lastValueAbove});
+  if (node->isValueNode()) {
+    lastValueAbove = node;
+  }
+  fillStrideIndex(node->left(), lastValueAbove);
+  fillStrideIndex(node->right(), lastValueAbove);
+}
+
 template <typename IterType>
 typename std::vector<IterType> pathFromRoot(
     IterType itr,
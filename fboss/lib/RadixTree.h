@@ -22,42 +22,54 @@
 #include <optional>
 
 namespace facebook::network {
+
+template <typename NODE>
+class RadixTreeNodeAllocator;
+
 /*
  * Node in RadixTree, holds IP, mask. Will hold  value for nodes
  * created as a result of user inserts. Other type of nodes are
  * ones created by the radix tree implementation, which will
  * hold no values. All non value nodes will have 2 children,
  * this invariant must be maintained at all times.
+ * Nodes are created and freed by the allocator of the tree they
+ * are in, which also holds the tree's delete callback.
  */
 template <typename IPADDRTYPE, typename T>
 class RadixTreeNode {
  public:
-  // Optional function parameter to call from destructor
+  typedef RadixTreeNodeAllocator<RadixTreeNode> NodeAllocator;
+  // Optional function parameter to call before freeing a node
   typedef std::function<void(const RadixTreeNode<IPADDRTYPE, T>&)>
       NodeDeleteCallback;
 
+  // Hands the node back to the allocator it came from
+  struct NodeDeleter {
+    void operator()(RadixTreeNode* node) const {
+      node->allocator_->destroy(node);
+    }
+  };
+  typedef std::unique_ptr<RadixTreeNode, NodeDeleter> NodePtr;
+
   RadixTreeNode(
+      NodeAllocator* allocator,
       const IPADDRTYPE& ipAddr,
-      uint8_t mlen,
-      NodeDeleteCallback deleteCallback)
-      : ipAddress_(ipAddr), masklen_(mlen), deleteCallback_(deleteCallback) {}
+      uint8_t mlen)
+      : ipAddress_(ipAddr), masklen_(mlen), allocator_(allocator) {}
 
   template <typename VALUE>
   RadixTreeNode(
+      NodeAllocator* allocator,
       const IPADDRTYPE& ipAddr,
       uint8_t mlen,
-      VALUE&& val,
-      NodeDeleteCallback deleteCallback)
+      VALUE&& val)
       : ipAddress_(ipAddr),
         masklen_(mlen),
         value_(std::forward<VALUE>(val)),
-        deleteCallback_(deleteCallback) {}
+        allocator_(allocator) {}
 
-  ~RadixTreeNode() {
-    if (deleteCallback_) {
-      deleteCallback_(*this);
-    }
-  }
+  RadixTreeNode(const RadixTreeNode&) = delete;
+  RadixTreeNode& operator=(const RadixTreeNode&) = delete;
 
   enum class TreeDirection { LEFT, RIGHT, PARENT, THIS_NODE };
 
@@ -101,10 +113,10 @@ class RadixTreeNode {
     return value_.value();
   }
   NodeDeleteCallback nodeDeleteCallback() const {
-    return deleteCallback_;
+    return allocator_->nodeDeleteCallback();
   }
   std::string str(bool printValue = true) const {
-    auto nodeStr = folly::to<std::string>(ipAddress_.str(), "/", masklen_);
+    auto nodeStr = folly::to<std::string>(ipAddress_.str(), "/", masklen());
     if (printValue) {
       nodeStr += isNonValueNode()
           ? "(*)"
@@ -129,8 +141,7 @@ class RadixTreeNode {
         (!isValueNode() || this->value() == r.value());
   }
 
-  std::unique_ptr<RadixTreeNode> resetLeft(
-      std::unique_ptr<RadixTreeNode> newLeft) {
+  NodePtr resetLeft(NodePtr newLeft) {
     auto old = std::move(left_);
     left_ = std::move(newLeft);
     if (left_) {
@@ -139,8 +150,7 @@ class RadixTreeNode {
     return old;
   }
 
-  std::unique_ptr<RadixTreeNode> resetRight(
-      std::unique_ptr<RadixTreeNode> newRight) {
+  NodePtr resetRight(NodePtr newRight) {
     auto old = std::move(right_);
     right_ = std::move(newRight);
     if (right_) {
@@ -163,13 +173,120 @@ class RadixTreeNode {
   }
 
  protected:
+  // Mask length goes next to the address, in what would be its padding
   IPADDRTYPE ipAddress_;
-  uint32_t masklen_{0}; // Number of bits to match.
+  uint8_t masklen_{0}; // Number of bits to match.
   std::optional<T> value_;
-  std::unique_ptr<RadixTreeNode> left_{nullptr};
-  std::unique_ptr<RadixTreeNode> right_{nullptr};
+  NodePtr left_{nullptr};
+  NodePtr right_{nullptr};
   RadixTreeNode* parent_{nullptr};
-  NodeDeleteCallback deleteCallback_;
+  NodeAllocator* allocator_;
+};
+
+/*
+ * Allocates the nodes of a radix tree out of slabs rather than one heap
+ * allocation per node, and calls the tree's delete callback on the nodes it
+ * frees. Freed nodes go on a free list for the next allocations, slabs are
+ * only given back once the tree is cleared or destroyed.
+ */
+template <typename NODE>
+class RadixTreeNodeAllocator {
+ public:
+  typedef typename NODE::NodeDeleteCallback NodeDeleteCallback;
+
+  explicit RadixTreeNodeAllocator(NodeDeleteCallback nodeDeleteCallback)
+      : nodeDeleteCallback_(std::move(nodeDeleteCallback)) {}
+  ~RadixTreeNodeAllocator() {
+    DCHECK_EQ(numNodes_, 0);
+  }
+  RadixTreeNodeAllocator(const RadixTreeNodeAllocator&) = delete;
+  RadixTreeNodeAllocator& operator=(const RadixTreeNodeAllocator&) = delete;
+
+  template <typename... Args>
+  typename NODE::NodePtr create(Args&&... args) {
+    auto slot = allocateSlot();
+    NODE* node = nullptr;
+    try {
+      node = new (slot->node) NODE(this, std::forward<Args>(args)...);
+    } catch (...) {
+      releaseSlot(slot);
+      throw;
+    }
+    ++numNodes_;
+    return typename NODE::NodePtr(node);
+  }
+
+  void destroy(NODE* node) {
+    if (nodeDeleteCallback_) {
+      nodeDeleteCallback_(*node);
+    }
+    node->~NODE();
+    releaseSlot(reinterpret_cast<Slot*>(node));
+    --numNodes_;
+  }
+
+  // Give the slabs back, once all nodes are freed
+  void releaseSlabs() {
+    CHECK_EQ(numNodes_, 0);
+    slabs_.clear();
+    freeList_ = nullptr;
+    nextSlabSize_ = kMinSlabSize;
+    allocatedSlots_ = 0;
+  }
+
+  const NodeDeleteCallback& nodeDeleteCallback() const {
+    return nodeDeleteCallback_;
+  }
+  void swapNodeDeleteCallback(RadixTreeNodeAllocator& other) noexcept {
+    nodeDeleteCallback_.swap(other.nodeDeleteCallback_);
+  }
+
+  size_t numNodes() const {
+    return numNodes_;
+  }
+  // Memory held for nodes, including free ones
+  size_t allocatedBytes() const {
+    return allocatedSlots_ * sizeof(Slot);
+  }
+
+ private:
+  union Slot {
+    Slot* next;
+    alignas(NODE) unsigned char node[sizeof(NODE)];
+  };
+  // Slabs double in size, so small trees stay small and large ones
+  // still need few allocations
+  static constexpr size_t kMinSlabSize = 8;
+  static constexpr size_t kMaxSlabSize = 1024;
+
+  Slot* allocateSlot() {
+    if (!freeList_) {
+      auto slabSize = nextSlabSize_;
+      slabs_.push_back(std::make_unique<Slot[]>(slabSize));
+      allocatedSlots_ += slabSize;
+      nextSlabSize_ = std::min(2 * slabSize, kMaxSlabSize);
+      auto slab = slabs_.back().get();
+      for (size_t i = 0; i < slabSize; ++i) {
+        slab[i].next = freeList_;
+        freeList_ = &slab[i];
+      }
+    }
+    auto slot = freeList_;
+    freeList_ = slot->next;
+    return slot;
+  }
+
+  void releaseSlot(Slot* slot) {
+    slot->next = freeList_;
+    freeList_ = slot;
+  }
+
+  NodeDeleteCallback nodeDeleteCallback_;
+  std::vector<std::unique_ptr<Slot[]>> slabs_;
+  Slot* freeList_{nullptr};
+  size_t nextSlabSize_{kMinSlabSize};
+  size_t allocatedSlots_{0};
+  size_t numNodes_{0};
 };
 
 /*
@@ -378,6 +495,8 @@ class RadixTree {
   typedef RadixTreeNode<IPADDRTYPE, T> TreeNode;
   typedef typename TreeNode::TreeDirection TreeDirection;
   typedef typename TreeNode::NodeDeleteCallback NodeDeleteCallback;
+  typedef typename TreeNode::NodeAllocator NodeAllocator;
+  typedef typename TreeNode::NodePtr NodePtr;
   typedef typename TreeTraits::Iterator Iterator;
   typedef typename TreeTraits::ConstIterator ConstIterator;
   typedef typename std::vector<ConstIterator> VecConstIterators;
@@ -385,7 +504,8 @@ class RadixTree {
   explicit RadixTree(
       NodeDeleteCallback nodeDelCallback = NodeDeleteCallback(),
       const TreeTraits& treeTraits = TreeTraits())
-      : nodeDeleteCallback_(nodeDelCallback), traits_(treeTraits) {}
+      : allocator_(std::make_unique<NodeAllocator>(std::move(nodeDelCallback))),
+        traits_(treeTraits) {}
 
   RadixTree(const RadixTree& r) = delete;
   RadixTree& operator=(const RadixTree& r) = delete;
@@ -407,17 +527,25 @@ class RadixTree {
   void clear() {
     root_.reset(nullptr);
     size_ = 0;
+    strideIndex_ = std::vector<StrideEntry>();
+    allocator_->releaseSlabs();
   }
   RadixTree(RadixTree&& r) noexcept
-      : nodeDeleteCallback_(r.nodeDeleteCallback_), traits_(r.traits_) {
+      : RadixTree(r.nodeDeleteCallback(), r.traits_) {
     *this = std::move(r);
   }
   // Move radix tree onto this
   RadixTree& operator=(RadixTree&& r) noexcept {
     // Don't copy the traits and delete callback, use
-    // ones with which this Radix tree was created
+    // ones with which this Radix tree was created. Take over r's
+    // allocator along with its nodes, but keep our delete callback
+    // for them.
+    clear();
+    std::swap(allocator_, r.allocator_);
+    allocator_->swapNodeDeleteCallback(*r.allocator_);
     size_ = r.size_;
     makeRoot(std::move(r.root_));
+    strideIndex_.swap(r.strideIndex_);
     r.size_ = 0;
     return *this;
   }
@@ -428,9 +556,10 @@ class RadixTree {
     static_assert(
         std::is_same<T, U>::value,
         "clone template type must be the same as Radix tree value type");
-    RadixTree copy(nodeDeleteCallback_, traits_);
+    RadixTree copy(nodeDeleteCallback(), traits_);
     copy.size_ = size_;
-    copy.root_ = cloneSubTree(root_.get());
+    copy.root_ = cloneSubTree(root_.get(), copy.allocator_.get());
+    copy.updateStrideIndex(true);
     return copy;
   }
   /*
@@ -583,14 +712,39 @@ class RadixTree {
     return root_.get();
   }
   NodeDeleteCallback nodeDeleteCallback() const {
-    return nodeDeleteCallback_;
+    return allocator_->nodeDeleteCallback();
   }
   const TreeTraits& traits() const {
     return traits_;
   }
+  // Memory held for the nodes of this tree
+  size_t allocatedBytes() const {
+    return allocator_->allocatedBytes() +
+        strideIndex_.capacity() * sizeof(StrideEntry);
+  }
 
  private:
-  static std::unique_ptr<TreeNode> cloneSubTree(const TreeNode* node);
+  /*
+   * Multibit stride over the first kStrideBits bits of an address. For
+   * each value of those bits, start is the deepest node no longer than
+   * kStrideBits on the search path of any address starting with them (or
+   * the root, if no node is that short), so a lookup can skip straight to
+   * it. lastValueAbove is the last value node above start on that path.
+   * Only kept once the tree is big enough for the top levels to matter.
+   */
+  struct StrideEntry {
+    TreeNode* start{nullptr};
+    TreeNode* lastValueAbove{nullptr};
+  };
+  static constexpr uint8_t kStrideBits = 8;
+  static constexpr size_t kStrideIndexMinSize = 1 << kStrideBits;
+
+  // Called after inserts, erases. Set affected if nodes no longer than
+  // kStrideBits or the root changed.
+  void updateStrideIndex(bool affected);
+  void fillStrideIndex(TreeNode* node, TreeNode* lastValueAbove);
+
+  static NodePtr cloneSubTree(const TreeNode* node, NodeAllocator* allocator);
   // Worker function to do the actual longest match lookup.
   const TreeNode* longestMatchImpl(
       const IPADDRTYPE& ipaddr,
@@ -611,18 +765,16 @@ class RadixTree {
             ipaddr, masklen, foundExact, includeNonValueNodes, trail));
   }
 
-  std::unique_ptr<TreeNode> makeNode(const IPADDRTYPE& ip, uint8_t masklen) {
-    return std::make_unique<TreeNode>(ip, masklen, nodeDeleteCallback_);
+  NodePtr makeNode(const IPADDRTYPE& ip, uint8_t masklen) {
+    return allocator_->create(ip, masklen);
   }
 
   template <typename VALUE>
-  std::unique_ptr<TreeNode>
-  makeNode(const IPADDRTYPE& ip, uint8_t masklen, VALUE&& value) {
-    return std::make_unique<TreeNode>(
-        ip, masklen, std::forward<VALUE>(value), nodeDeleteCallback_);
+  NodePtr makeNode(const IPADDRTYPE& ip, uint8_t masklen, VALUE&& value) {
+    return allocator_->create(ip, masklen, std::forward<VALUE>(value));
   }
 
-  void makeRoot(std::unique_ptr<TreeNode> newRoot) {
+  void makeRoot(NodePtr newRoot) {
     CHECK(root_ != newRoot || root_ == nullptr);
     if (newRoot) {
       newRoot->setParent(nullptr);
@@ -635,9 +787,11 @@ class RadixTree {
       bool includeNonValueNodes,
       const TreeNode* node) const;
 
-  std::unique_ptr<TreeNode> root_{nullptr};
+  // Nodes point to the allocator, which must outlive root_
+  std::unique_ptr<NodeAllocator> allocator_;
+  NodePtr root_{nullptr};
   size_t size_{0};
-  NodeDeleteCallback nodeDeleteCallback_;
+  std::vector<StrideEntry> strideIndex_;
   TreeTraits traits_;
 };
 
@@ -1072,6 +1226,9 @@ class RadixTree<folly::IPAddress, T> {
   size_t size6() const {
     return ipv6Tree_.size();
   }
+  size_t allocatedBytes() const {
+    return ipv4Tree_.allocatedBytes() + ipv6Tree_.allocatedBytes();
+  }
   /*
    * Insert a IP, mask, value in tree. Returns inserted node, true
    * if a node was inserted. If a node for IP, mask already existed
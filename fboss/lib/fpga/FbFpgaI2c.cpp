@@ -7,16 +7,29 @@
 
 #include <folly/CppAttributes.h>
 #include <folly/Format.h>
+#include <folly/ScopeGuard.h>
 #include <folly/Synchronized.h>
 #include <folly/futures/Future.h>
 #include <folly/logging/xlog.h>
 
 #include <algorithm>
+#include <chrono>
 #include <thread>
 
 namespace {
 constexpr uint32_t kFacebookFpgaRTCWriteBlock = 0x2000;
 constexpr uint32_t kFacebookFpgaRTCReadBlock = 0x3000;
+
+// A byte takes at least this long on the wire at 400KHz, no point in polling
+// the status before that.
+constexpr uint32_t kI2cMinByteTimeUsec = 25;
+// Status polls issued back to back before backing off
+constexpr uint32_t kI2cSpinPolls = 8;
+constexpr uint32_t kI2cMinBackoffUsec = 10;
+constexpr uint32_t kI2cMaxBackoffUsec = 1000;
+// Give up after about as long as the former fixed 100us/byte + 20 x 1ms
+constexpr uint32_t kI2cTimeoutByteUsec = 100;
+constexpr uint32_t kI2cTimeoutBaseUsec = 20000;
 } // unnamed namespace
 
 namespace facebook::fboss {
@@ -49,15 +62,25 @@ FbFpgaI2c::FbFpgaI2c(
 
 bool FbFpgaI2c::waitForResponse(size_t len) {
   I2cRtcStatus rtcStatus(version_);
-  uint32_t retries = 20;
+  uint32_t timeoutUsec = kI2cTimeoutByteUsec * len + kI2cTimeoutBaseUsec;
+  auto deadline = std::chrono::steady_clock::now() +
+      std::chrono::microseconds(timeoutUsec);
 
   // Make the initial wait according to the length of read/write.
-  usleep(100 * len);
+  usleep(kI2cMinByteTimeUsec * len);
 
   readReg(rtcStatus);
 
-  while (!rtcStatus.dataUnion.desc0done && --retries) {
-    usleep(1000);
+  // Most transactions complete shortly after the minimum wire time, so spin
+  // on the status for a bit before backing off exponentially.
+  uint32_t polls = 1;
+  uint32_t backoffUsec = kI2cMinBackoffUsec;
+  while (!rtcStatus.dataUnion.desc0done &&
+         std::chrono::steady_clock::now() < deadline) {
+    if (polls++ >= kI2cSpinPolls) {
+      usleep(backoffUsec);
+      backoffUsec = std::min(backoffUsec * 2, kI2cMaxBackoffUsec);
+    }
     readReg(rtcStatus);
   }
 
@@ -218,6 +241,41 @@ uint32_t FbFpgaI2c::getRTCIOBlockSize() {
   }
 }
 
+void FbFpgaI2cTransactionQueue::acquire(uint8_t channel) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (channel >= waiters_.size()) {
+    waiters_.resize(channel + 1);
+  }
+  auto ticket = nextTicket_++;
+  waiters_[channel].push_back(ticket);
+  if (!busy_ && !granted_) {
+    grantNextLocked();
+  }
+  cv_.wait(lock, [&] { return granted_ == ticket; });
+  waiters_[channel].pop_front();
+  granted_.reset();
+  busy_ = true;
+}
+
+void FbFpgaI2cTransactionQueue::release() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  busy_ = false;
+  grantNextLocked();
+}
+
+void FbFpgaI2cTransactionQueue::grantNextLocked() {
+  // Start from the channel after the last one served
+  for (size_t i = 1; i <= waiters_.size(); i++) {
+    auto channel = (lastChannel_ + i) % waiters_.size();
+    if (!waiters_[channel].empty()) {
+      granted_ = waiters_[channel].front();
+      lastChannel_ = channel;
+      cv_.notify_all();
+      return;
+    }
+  }
+}
+
 FbFpgaI2cController::FbFpgaI2cController(
     FbDomFpga* fpga,
     uint32_t rtcId,
@@ -253,6 +311,31 @@ FbFpgaI2cController::~FbFpgaI2cController() {
   thread_->join();
 }
 
+template <typename Fn>
+void FbFpgaI2cController::runTransaction(
+    uint8_t channel,
+    bool isRead,
+    Fn&& fn) {
+  auto start = std::chrono::steady_clock::now();
+  txnQueue_.acquire(channel);
+  SCOPE_EXIT {
+    txnQueue_.release();
+  };
+  auto fbI2c = syncedFbI2c_.lock();
+  SCOPE_EXIT {
+    // Includes the time spent waiting behind other transactions
+    auto usec = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+    if (isRead) {
+      fbI2c->incrReadTimeUsec(usec);
+    } else {
+      fbI2c->incrWriteTimeUsec(usec);
+    }
+  };
+  fn(*fbI2c);
+}
+
 uint8_t FbFpgaI2cController::readByte(
     uint8_t channel,
     uint8_t offset,
@@ -267,7 +350,10 @@ uint8_t FbFpgaI2cController::readByte(
   // As this is a sync and blocking function, we don't have to dump it to
   // EventBase to run the functions. So that we can avoid unexpected
   // EventBase chain issue
-  return syncedFbI2c_.lock()->readByte(channel, offset, i2cAddress);
+  runTransaction(channel, true /* isRead */, [&](FbFpgaI2c& fbI2c) {
+    buf = fbI2c.readByte(channel, offset, i2cAddress);
+  });
+  return buf;
 }
 
 void FbFpgaI2cController::read(
@@ -285,7 +371,9 @@ void FbFpgaI2cController::read(
   // As this is a sync and blocking function, we don't have to dump it to
   // EventBase to run the functions. So that we can avoid unexpected
   // EventBase chain issue
-  syncedFbI2c_.lock()->read(channel, offset, buf, i2cAddress);
+  runTransaction(channel, true /* isRead */, [&](FbFpgaI2c& fbI2c) {
+    fbI2c.read(channel, offset, buf, i2cAddress);
+  });
 }
 
 void FbFpgaI2cController::writeByte(
@@ -303,7 +391,9 @@ void FbFpgaI2cController::writeByte(
   // As this is a sync and blocking function, we don't have to dump it to
   // EventBase to run the functions. So that we can avoid unexpected
   // EventBase chain issue
-  syncedFbI2c_.lock()->writeByte(channel, offset, val, i2cAddress);
+  runTransaction(channel, false /* isRead */, [&](FbFpgaI2c& fbI2c) {
+    fbI2c.writeByte(channel, offset, val, i2cAddress);
+  });
 }
 
 void FbFpgaI2cController::write(
@@ -321,7 +411,9 @@ void FbFpgaI2cController::write(
   // As this is a sync and blocking function, we don't have to dump it to
   // EventBase to run the functions. So that we can avoid unexpected
   // EventBase chain issue
-  syncedFbI2c_.lock()->write(channel, offset, buf, i2cAddress);
+  runTransaction(channel, false /* isRead */, [&](FbFpgaI2c& fbI2c) {
+    fbI2c.write(channel, offset, buf, i2cAddress);
+  });
 }
 
 folly::EventBase* FbFpgaI2cController::getEventBase() {
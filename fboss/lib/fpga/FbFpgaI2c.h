@@ -11,7 +11,12 @@
 #include <folly/io/async/EventBase.h>
 
 #include <stdint.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
 #include <thread>
+#include <vector>
 
 namespace facebook::fboss {
 inline uint8_t getI2cControllerIdx(uint8_t port) {
@@ -76,6 +81,31 @@ class FbFpgaI2c : public I2cController {
   int version_{0};
 };
 
+/* Orders the transactions issued on an RTC. All channels of an RTC share
+ * its descriptor and status registers, so only one transaction can be in
+ * flight at a time. Waiters are queued per channel and the channels are
+ * served round robin, so a long EEPROM dump on one port does not hold up the
+ * other ports the way an unfair mutex can.
+ */
+class FbFpgaI2cTransactionQueue {
+ public:
+  // Blocks until the RTC is granted to this transaction
+  void acquire(uint8_t channel);
+  void release();
+
+ private:
+  void grantNextLocked();
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  // Tickets of the waiting transactions, per channel
+  std::vector<std::deque<uint64_t>> waiters_;
+  uint64_t nextTicket_{0};
+  std::optional<uint64_t> granted_;
+  bool busy_{false};
+  size_t lastChannel_{0};
+};
+
 class FbFpgaI2cController {
  public:
   // TODO(clin82): After refactor Wedge400I2CBus to make use of
@@ -120,6 +150,10 @@ class FbFpgaI2cController {
   }
 
  private:
+  template <typename Fn>
+  void runTransaction(uint8_t channel, bool isRead, Fn&& fn);
+
+  FbFpgaI2cTransactionQueue txnQueue_;
   folly::Synchronized<FbFpgaI2c, std::mutex> syncedFbI2c_;
   std::unique_ptr<folly::EventBase> eventBase_;
   std::unique_ptr<std::thread> thread_;
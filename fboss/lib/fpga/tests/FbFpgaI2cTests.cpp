@@ -0,0 +1,136 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <gtest/gtest.h>
+
+#include "fboss/lib/fpga/FbFpgaI2c.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <string>
+
+namespace {
+constexpr auto kFakePhysicalAddr = 0xfdf00000;
+constexpr auto kFakeSize = 64 * 1024;
+// Version 0 register layout of RTC 0
+constexpr uint32_t kDescUpper = 0x504;
+constexpr uint32_t kRtcStatus = 0x600;
+constexpr uint32_t kReadBlock = 0x3000;
+constexpr uint32_t kValidBit = 1u << 31;
+constexpr uint32_t kDesc0Done = 1;
+} // namespace
+
+namespace facebook::fboss {
+
+// Models a single RTC: a transaction started through the upper descriptor
+// completes after a fixed latency, read data is the byte offset.
+class FakeRtcFpgaDevice : public FpgaDevice {
+ public:
+  explicit FakeRtcFpgaDevice(std::chrono::microseconds latency)
+      : FpgaDevice(kFakePhysicalAddr, kFakeSize), latency_(latency) {}
+
+  void mmap() override {}
+
+  uint32_t read(uint32_t offset) const override {
+    if (offset == kRtcStatus) {
+      statusReads++;
+      return (std::chrono::steady_clock::now() - started_ >= latency_)
+          ? kDesc0Done
+          : 0;
+    }
+    if (offset >= kReadBlock && offset < kReadBlock + 0x200) {
+      uint32_t base = offset - kReadBlock;
+      return base | (base + 1) << 8 | (base + 2) << 16 | (base + 3) << 24;
+    }
+    return 0;
+  }
+
+  void write(uint32_t offset, uint32_t value) override {
+    if (offset == kDescUpper && (value & kValidBit)) {
+      started_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  mutable std::atomic<int> statusReads{0};
+
+ private:
+  std::chrono::microseconds latency_;
+  std::chrono::steady_clock::time_point started_;
+};
+
+class FbFpgaI2cTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<FbFpgaI2cController> makeController(
+      std::chrono::microseconds latency) {
+    device_ = std::make_unique<FakeRtcFpgaDevice>(latency);
+    return std::make_unique<FbFpgaI2cController>(
+        std::make_unique<FpgaMemoryRegion>("pim", device_.get(), 0, kFakeSize),
+        0 /* rtcId */,
+        2 /* pim */);
+  }
+
+  std::unique_ptr<FakeRtcFpgaDevice> device_;
+};
+
+TEST_F(FbFpgaI2cTest, pageReadPollsAdaptively) {
+  auto controller = makeController(std::chrono::microseconds(4000));
+  std::array<uint8_t, 128> page;
+  controller->read(0, 128, folly::MutableByteRange(page.data(), page.size()));
+  for (size_t i = 0; i < page.size(); i++) {
+    EXPECT_EQ(page[i], i);
+  }
+  // A few spins then exponential backoff, instead of a fixed 1ms period
+  EXPECT_LT(device_->statusReads, 30);
+
+  auto stats = controller->getI2cControllerPlatformStats();
+  EXPECT_EQ(*stats.readTotal_(), 1);
+  EXPECT_EQ(*stats.readBytes_(), 128);
+  EXPECT_EQ(*stats.readFailed_(), 0);
+  EXPECT_GE(*stats.readTimeUsec_(), 4000);
+}
+
+TEST_F(FbFpgaI2cTest, readTimesOut) {
+  auto controller = makeController(std::chrono::hours(1));
+  EXPECT_THROW(controller->readByte(0, 0), FbFpgaI2cError);
+  auto stats = controller->getI2cControllerPlatformStats();
+  EXPECT_EQ(*stats.readTotal_(), 1);
+  EXPECT_EQ(*stats.readFailed_(), 1);
+  EXPECT_GE(*stats.readTimeUsec_(), 20000);
+}
+
+TEST(FbFpgaI2cTransactionQueueTest, channelsServedRoundRobin) {
+  FbFpgaI2cTransactionQueue queue;
+  std::vector<std::string> order;
+  std::mutex orderMutex;
+  auto transaction = [&](uint8_t channel, std::string name) {
+    return std::async(std::launch::async, [&, channel, name]() {
+      queue.acquire(channel);
+      {
+        std::lock_guard<std::mutex> g(orderMutex);
+        order.push_back(name);
+      }
+      queue.release();
+    });
+  };
+
+  queue.acquire(0);
+  std::vector<std::future<void>> txns;
+  // Queue up two transactions on channel 0 before one on channel 1
+  for (const auto& [channel, name] :
+       std::vector<std::pair<uint8_t, std::string>>{
+           {0, "chan0.1"}, {0, "chan0.2"}, {1, "chan1.1"}}) {
+    txns.push_back(transaction(channel, name));
+    // sleep override
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+  queue.release();
+  for (auto& txn : txns) {
+    txn.get();
+  }
+  EXPECT_EQ(
+      order, std::vector<std::string>({"chan1.1", "chan0.1", "chan0.2"}));
+}
+
+} // namespace facebook::fboss
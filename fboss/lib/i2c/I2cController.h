@@ -31,6 +31,8 @@ class I2cController {
     *i2cControllerPlatformStats_.writeTotal_() = 0;
     *i2cControllerPlatformStats_.writeFailed_() = 0;
     *i2cControllerPlatformStats_.writeBytes_() = 0;
+    *i2cControllerPlatformStats_.readTimeUsec_() = 0;
+    *i2cControllerPlatformStats_.writeTimeUsec_() = 0;
   }
   // Total number of reads
   void incrReadTotal(uint32_t count = 1) {
@@ -56,6 +58,14 @@ class I2cController {
   void incrWriteBytes(uint32_t count = 1) {
     *i2cControllerPlatformStats_.writeBytes_() += count;
   }
+  // Time spent in reads
+  void incrReadTimeUsec(uint64_t usec) {
+    *i2cControllerPlatformStats_.readTimeUsec_() += usec;
+  }
+  // Time spent in writes
+  void incrWriteTimeUsec(uint64_t usec) {
+    *i2cControllerPlatformStats_.writeTimeUsec_() += usec;
+  }
 
   /* Get the I2c transaction stats from the i2c controller
    */
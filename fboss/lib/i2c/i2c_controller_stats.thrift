@@ -11,4 +11,8 @@ struct I2cControllerStats {
   5: i64 writeTotal_ = STAT_UNINITIALIZED;
   6: i64 writeFailed_ = STAT_UNINITIALIZED;
   7: i64 writeBytes_ = STAT_UNINITIALIZED;
+  // Time spent in reads/writes including the wait for the controller,
+  // in microseconds. Divide by readTotal_/writeTotal_ for the average.
+  8: i64 readTimeUsec_ = STAT_UNINITIALIZED;
+  9: i64 writeTimeUsec_ = STAT_UNINITIALIZED;
 }
@@ -9,25 +9,54 @@
  */
 #pragma once
 
+#include <utility>
+
 #include "fboss/agent/FbossError.h"
 #include "fboss/lib/link_snapshots/RingBuffer.h"
 
 namespace facebook::fboss {
 
 template <typename T, size_t length>
-void RingBuffer<T, length>::write(T val) {
-  if (buf.size() == length) {
-    buf.pop_front();
+RingBuffer<T, length>::RingBuffer() {
+  buf.reserve(length);
+}
+
+template <typename T, size_t length>
+template <typename V>
+void RingBuffer<T, length>::writeImpl(V&& val) {
+  if (buf.size() < length) {
+    buf.push_back(std::forward<V>(val));
+    return;
   }
-  buf.push_back(val);
+  // Overwrite the oldest value in place
+  buf[head] = std::forward<V>(val);
+  head = (head + 1) % length;
+}
+
+template <typename T, size_t length>
+void RingBuffer<T, length>::write(const T& val) {
+  writeImpl(val);
 }
 
 template <typename T, size_t length>
-const T RingBuffer<T, length>::last() const {
+void RingBuffer<T, length>::write(T&& val) {
+  writeImpl(std::move(val));
+}
+
+template <typename T, size_t length>
+T& RingBuffer<T, length>::last() {
   if (buf.empty()) {
     throw FbossError("Attempted to read from empty RingBuffer");
   }
-  return buf.back();
+  return at(buf.size() - 1);
+}
+
+template <typename T, size_t length>
+const T& RingBuffer<T, length>::last() const {
+  if (buf.empty()) {
+    throw FbossError("Attempted to read from empty RingBuffer");
+  }
+  return at(buf.size() - 1);
 }
 
 template <typename T, size_t length>
@@ -37,24 +66,24 @@ bool RingBuffer<T, length>::empty() const {
 
 template <typename T, size_t length>
 typename RingBuffer<T, length>::iterator RingBuffer<T, length>::begin() {
-  return buf.begin();
+  return iterator(this, 0);
 }
 
 template <typename T, size_t length>
 typename RingBuffer<T, length>::iterator RingBuffer<T, length>::end() {
-  return buf.end();
+  return iterator(this, buf.size());
 }
 
 template <typename T, size_t length>
 typename RingBuffer<T, length>::const_iterator RingBuffer<T, length>::begin()
     const {
-  return buf.begin();
+  return const_iterator(this, 0);
 }
 
 template <typename T, size_t length>
 typename RingBuffer<T, length>::const_iterator RingBuffer<T, length>::end()
     const {
-  return buf.end();
+  return const_iterator(this, buf.size());
 }
 
 template <typename T, size_t length>
@@ -67,4 +96,20 @@ size_t RingBuffer<T, length>::maxSize() const {
   return length;
 }
 
+template <typename T, size_t length>
+size_t RingBuffer<T, length>::slot(size_t pos) const {
+  // Until the ring is full head stays at 0 and values are in write order
+  return (head + pos) % length;
+}
+
+template <typename T, size_t length>
+T& RingBuffer<T, length>::at(size_t pos) {
+  return buf[slot(pos)];
+}
+
+template <typename T, size_t length>
+const T& RingBuffer<T, length>::at(size_t pos) const {
+  return buf[slot(pos)];
+}
+
 } // namespace facebook::fboss
@@ -10,17 +10,66 @@
 #pragma once
 
 #include <stddef.h>
-#include <list>
+#include <iterator>
+#include <vector>
 
 namespace facebook::fboss {
+
+/*
+ * Fixed capacity ring keeping the last `length` values written. Values live
+ * in a contiguous block allocated once, and a write overwrites the oldest
+ * slot in place instead of allocating a new node. Iteration goes from the
+ * oldest to the newest value.
+ */
 template <typename T, size_t length>
 class RingBuffer {
+  template <typename Ring, typename Value>
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Value*;
+    using reference = Value&;
+
+    Iterator(Ring* ring, size_t pos) : ring_(ring), pos_(pos) {}
+    reference operator*() const {
+      return ring_->at(pos_);
+    }
+    pointer operator->() const {
+      return &ring_->at(pos_);
+    }
+    Iterator& operator++() {
+      ++pos_;
+      return *this;
+    }
+    Iterator operator++(int) {
+      auto ret = *this;
+      ++pos_;
+      return ret;
+    }
+    bool operator==(const Iterator& other) const {
+      return ring_ == other.ring_ && pos_ == other.pos_;
+    }
+    bool operator!=(const Iterator& other) const {
+      return !(*this == other);
+    }
+
+   private:
+    Ring* ring_;
+    size_t pos_;
+  };
+
  public:
-  using iterator = typename std::list<T>::iterator;
-  using const_iterator = typename std::list<T>::const_iterator;
+  using iterator = Iterator<RingBuffer, T>;
+  using const_iterator = Iterator<const RingBuffer, const T>;
 
-  void write(T val);
-  const T last() const;
+  RingBuffer();
+
+  void write(const T& val);
+  void write(T&& val);
+  T& last();
+  const T& last() const;
   bool empty() const;
   iterator begin();
   iterator end();
@@ -30,7 +79,16 @@ class RingBuffer {
   size_t maxSize() const;
 
  private:
-  std::list<T> buf;
+  // pos-th oldest value
+  T& at(size_t pos);
+  const T& at(size_t pos) const;
+  size_t slot(size_t pos) const;
+  template <typename V>
+  void writeImpl(V&& val);
+
+  std::vector<T> buf;
+  // Slot the next write goes to, once the ring is full
+  size_t head{0};
 };
 
 } // namespace facebook::fboss
@@ -23,13 +23,12 @@ SnapshotManager<intervalSeconds, timespanSeconds>::SnapshotManager(
 template <size_t intervalSeconds, size_t timespanSeconds>
 void SnapshotManager<intervalSeconds, timespanSeconds>::addSnapshot(
     LinkSnapshot val) {
-  auto snapshot = SnapshotWrapper(val);
-  buf_.write(snapshot);
+  buf_.write(SnapshotWrapper(std::move(val)));
 
   if (numSnapshotsToPublish_ > 0) {
-    snapshot.publish(portNames_);
-  }
-  if (numSnapshotsToPublish_ > 0) {
+    // Publish from the slot, so it is not logged again by
+    // publishAllSnapshots
+    buf_.last().publish(portNames_);
     numSnapshotsToPublish_--;
   }
 }
@@ -9,7 +9,9 @@
  */
 
 #include "fboss/lib/link_snapshots/SnapshotManager.h"
+#include <folly/ScopeGuard.h>
 #include <sstream>
+#include <utility>
 #include "fboss/lib/AlertLogger.h"
 
 using namespace std::chrono;
@@ -25,33 +27,41 @@ constexpr auto kMaxLogLineLength = 8000;
 namespace facebook::fboss {
 
 void SnapshotWrapper::publish(const std::set<std::string>& portNames) {
+  if (published_) {
+    return;
+  }
   // S309875: Log length is too long now due to the tcvrStats and tcvrState
   // fields containing lots of duplicate data from other fields. For now lets
   // just clear these fields so that they aren't included in the log.
   // TODO(ccpowers): At some point we should de-duplicate the data at its source
   // rather than just wiping the duplicate data prior to logging it.
-  auto patchedSnapshot = snapshot_;
-  if (patchedSnapshot.transceiverInfo_ref()) {
-    patchedSnapshot.transceiverInfo_ref()->tcvrStats_ref() = TcvrStats();
-    patchedSnapshot.transceiverInfo_ref()->tcvrState_ref() = TcvrState();
-  }
-  auto serializedSnapshot =
-      apache::thrift::SimpleJSONSerializer::serialize<std::string>(
-          patchedSnapshot);
-  if (!published_) {
-    std::stringstream log;
-    log << LinkSnapshotAlert() << "Collected snapshot for ports ";
-    for (const auto& port : portNames) {
-      log << PortParam(port);
+  // Swap them out for the serialization rather than copying the snapshot.
+  TcvrStats tcvrStats;
+  TcvrState tcvrState;
+  auto swapTcvrFields = [&]() {
+    if (snapshot_.transceiverInfo_ref()) {
+      std::swap(tcvrStats, *snapshot_.transceiverInfo_ref()->tcvrStats_ref());
+      std::swap(tcvrState, *snapshot_.transceiverInfo_ref()->tcvrState_ref());
     }
-    log << " " << LinkSnapshotParam(serializedSnapshot);
-    // Check that length isn't too long. Should only trigger in debug mode
-    // (i.e. in link tests)
-    DCHECK(log.str().size() < kMaxLogLineLength)
-        << "CHECK failed, snapshot length was too long.";
-    XLOG(DBG2) << log.str();
-    published_ = true;
+  };
+  swapTcvrFields();
+  SCOPE_EXIT {
+    swapTcvrFields();
+  };
+  auto serializedSnapshot =
+      apache::thrift::SimpleJSONSerializer::serialize<std::string>(snapshot_);
+  std::stringstream log;
+  log << LinkSnapshotAlert() << "Collected snapshot for ports ";
+  for (const auto& port : portNames) {
+    log << PortParam(port);
   }
+  log << " " << LinkSnapshotParam(serializedSnapshot);
+  // Check that length isn't too long. Should only trigger in debug mode
+  // (i.e. in link tests)
+  DCHECK(log.str().size() < kMaxLogLineLength)
+      << "CHECK failed, snapshot length was too long.";
+  XLOG(DBG2) << log.str();
+  published_ = true;
 }
 
 } // namespace facebook::fboss
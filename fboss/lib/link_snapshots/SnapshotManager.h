@@ -26,7 +26,8 @@ using namespace fboss::phy;
 
 class SnapshotWrapper {
  public:
-  explicit SnapshotWrapper(LinkSnapshot snapshot) : snapshot_(snapshot) {}
+  explicit SnapshotWrapper(LinkSnapshot snapshot)
+      : snapshot_(std::move(snapshot)) {}
   void publish(const std::set<std::string>& portNames);
 
   LinkSnapshot snapshot_;
@@ -3,6 +3,7 @@
 #include <folly/Benchmark.h>
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
+#include <malloc.h>
 #include <set>
 #include <vector>
 #include "common/base/Random.h"
@@ -27,6 +28,10 @@ DEFINE_int32(
     lookup_count,
     5000,
     "The number of elements to look up on each lookup iteration");
+DEFINE_int32(
+    rib_prefix_count,
+    200000,
+    "The number of prefixes in the RIB sized trees");
 namespace {
 set<Prefix4> insertSet4;
 set<Prefix4> eraseSet4;
@@ -37,6 +42,11 @@ set<Prefix6> eraseSet6;
 set<Prefix6> exactMatchSet6;
 set<Prefix6> longestMatchSet6;
 vector<int> valueSet;
+// RIB sized trees, looked up with host addresses
+vector<Prefix4> ribPrefixes4;
+vector<IPAddressV4> ribLookups4;
+vector<Prefix6> ribPrefixes6;
+vector<IPAddressV6> ribLookups6;
 
 // V4 Benchmarks
 template <typename TREE>
@@ -197,6 +207,70 @@ BENCHMARK_RELATIVE(RadixTreeLongestMatch6) {
   }
 }
 
+// RIB scale memory and lookup rate
+
+template <typename TREE, typename PREFIXES>
+void setupRib(TREE& tree, const PREFIXES& prefixes) {
+  auto count = 0;
+  for (const auto& pfx : prefixes) {
+    tree.insert(pfx.ip, pfx.mask, count++);
+  }
+}
+
+/*
+ * Reports the memory used per prefix, both as held by the tree's node
+ * slabs and as seen by malloc.
+ */
+template <typename ADDRTYPE, typename PREFIXES>
+void radixTreeRibMemory(folly::UserCounters& counters, const PREFIXES& pfxs) {
+  auto heapBefore = mallinfo2().uordblks;
+  RadixTree<ADDRTYPE, int> rtree;
+  setupRib(rtree, pfxs);
+  counters["bytes_per_prefix"] = rtree.allocatedBytes() / rtree.size();
+  counters["heap_bytes_per_prefix"] =
+      (mallinfo2().uordblks - heapBefore) / rtree.size();
+  BENCHMARK_SUSPEND {
+    rtree.clear();
+  }
+}
+
+BENCHMARK_COUNTERS(RadixTreeRibMemory4, counters) {
+  radixTreeRibMemory<IPAddressV4>(counters, ribPrefixes4);
+}
+
+BENCHMARK_COUNTERS(RadixTreeRibMemory6, counters) {
+  radixTreeRibMemory<IPAddressV6>(counters, ribPrefixes6);
+}
+
+// One host address longest match per iteration, so iters/s is LPM lookups/s
+BENCHMARK(RadixTreeRibLongestMatch4, iters) {
+  RadixTree<IPAddressV4, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupRib(rtree, ribPrefixes4);
+  }
+  for (size_t i = 0; i < iters; ++i) {
+    folly::doNotOptimizeAway(
+        rtree.longestMatch(ribLookups4[i % ribLookups4.size()], 32));
+  }
+  BENCHMARK_SUSPEND {
+    rtree.clear();
+  }
+}
+
+BENCHMARK(RadixTreeRibLongestMatch6, iters) {
+  RadixTree<IPAddressV6, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupRib(rtree, ribPrefixes6);
+  }
+  for (size_t i = 0; i < iters; ++i) {
+    folly::doNotOptimizeAway(
+        rtree.longestMatch(ribLookups6[i % ribLookups6.size()], 128));
+  }
+  BENCHMARK_SUSPEND {
+    rtree.clear();
+  }
+}
+
 } // namespace
 
 int main(int /*argc*/, char* /*argv*/[]) {
@@ -252,5 +326,32 @@ int main(int /*argc*/, char* /*argv*/[]) {
     auto newIp = pfx.ip.mask(newMask);
     longestMatchSet6.insert(Prefix6(newIp, newMask));
   }
+
+  // RIB sized trees, v4 prefixes /8 - /24 and v6 ones /19 - /64 out of
+  // global unicast (2000::/3). Each gets a host address in it to look up.
+  set<Prefix4> ribSet4;
+  while (ribSet4.size() < FLAGS_rib_prefix_count) {
+    auto mask = 8 + folly::Random::rand32(17);
+    auto ip = IPAddressV4::fromLongHBO(folly::Random::rand32()).mask(mask);
+    if (ribSet4.insert(Prefix4(ip, mask)).second) {
+      ribPrefixes4.push_back(Prefix4(ip, mask));
+      auto host = ip.toLongHBO() | folly::Random::rand32(256);
+      ribLookups4.push_back(IPAddressV4::fromLongHBO(host));
+    }
+  }
+  set<Prefix6> ribSet6;
+  while (ribSet6.size() < FLAGS_rib_prefix_count) {
+    auto mask = 19 + folly::Random::rand32(46);
+    ByteArray16 ba;
+    *(uint64_t*)(&ba[0]) = folly::Random::rand64();
+    *(uint64_t*)(&ba[8]) = folly::Random::rand64();
+    ba[0] = 0x20 | (ba[0] & 0x1f);
+    auto host = IPAddressV6(ba);
+    auto ip = host.mask(mask);
+    if (ribSet6.insert(Prefix6(ip, mask)).second) {
+      ribPrefixes6.push_back(Prefix6(ip, mask));
+      ribLookups6.push_back(host);
+    }
+  }
   runBenchmarks();
 }
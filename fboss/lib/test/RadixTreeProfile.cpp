@@ -3,6 +3,7 @@
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
 #include <array>
+#include <chrono>
 #include <set>
 #include <vector>
 #include "common/base/Random.h"
@@ -23,6 +24,8 @@ DEFINE_bool(v6Inserts, false, "Do inserts into v6 trees");
 DEFINE_bool(v6Deletes, false, "Perform deletes on v6 trees");
 DEFINE_bool(v6Exact, false, "Perform exact match on v6 trees");
 DEFINE_bool(v6Longest, false, "Perform longest match on v6 trees");
+DEFINE_bool(v4Rib, false, "Report memory/prefix, LPM lookups/sec on v4 trees");
+DEFINE_bool(v6Rib, false, "Report memory/prefix, LPM lookups/sec on v6 trees");
 
 constexpr auto kTreeCount = 1000;
 constexpr auto kInsertCount = 10000;
@@ -91,6 +94,34 @@ void radixTreeLongestMatch4() {
     }
   }
 }
+/*
+ * Memory per prefix of a tree and the rate of host address longest
+ * matches on it
+ */
+template <typename TREE, typename PREFIXES>
+void reportRibStats(const TREE& rtree, const PREFIXES& lookups) {
+  auto constexpr kLookupRounds = 100;
+  auto hostMask = lookups.front().ip.bitCount();
+  size_t found = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (auto i = 0; i < kLookupRounds; ++i) {
+    for (const auto& pfx : lookups) {
+      found += !rtree.longestMatch(pfx.ip, hostMask).atEnd();
+    }
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  LOG(INFO) << "Prefixes: " << rtree.size()
+            << " bytes/prefix: " << rtree.allocatedBytes() / rtree.size()
+            << " LPM lookups/sec: "
+            << kLookupRounds * lookups.size() / elapsed.count()
+            << " found: " << found;
+}
+
+void radixTreeRib4() {
+  setupV4Trees(1);
+  reportRibStats(v4Trees[0], matchVec4);
+}
 // V6
 void setupV6Trees(uint32_t numTrees = kTreeCount) {
   auto treeCount = 0;
@@ -143,6 +174,11 @@ void radixTreeLongestMatch6() {
   }
 }
 
+void radixTreeRib6() {
+  setupV6Trees(1);
+  reportRibStats(v6Trees[0], matchVec6);
+}
+
 void fillV4MatchVec() {
   if (matchVec4.size()) {
     return;
@@ -170,7 +206,8 @@ void fillV6MatchVec() {
 int main(int argc, char* argv[]) {
   facebook::initFacebook(&argc, &argv);
   // V4 ops
-  if (FLAGS_v4Inserts || FLAGS_v4Deletes || FLAGS_v4Exact || FLAGS_v4Longest) {
+  if (FLAGS_v4Inserts || FLAGS_v4Deletes || FLAGS_v4Exact || FLAGS_v4Longest ||
+      FLAGS_v4Rib) {
     set<Prefix4> inserted4;
     while (inserted4.size() < kInsertCount) {
       auto mask = folly::Random::rand32(32);
@@ -196,10 +233,15 @@ int main(int argc, char* argv[]) {
       fillV4MatchVec();
       radixTreeLongestMatch4();
     }
+    if (FLAGS_v4Rib) {
+      fillV4MatchVec();
+      radixTreeRib4();
+    }
   }
 
   // V6 ops
-  if (FLAGS_v6Inserts || FLAGS_v6Deletes || FLAGS_v6Exact || FLAGS_v6Longest) {
+  if (FLAGS_v6Inserts || FLAGS_v6Deletes || FLAGS_v6Exact || FLAGS_v6Longest ||
+      FLAGS_v6Rib) {
     set<Prefix6> inserted6;
     while (inserted6.size() < kInsertCount) {
       auto mask = folly::Random::rand32(128);
@@ -228,6 +270,10 @@ int main(int argc, char* argv[]) {
       fillV6MatchVec();
       radixTreeLongestMatch6();
     }
+    if (FLAGS_v6Rib) {
+      fillV6MatchVec();
+      radixTreeRib6();
+    }
   }
 
   return 0;
@@ -1457,6 +1457,81 @@ TEST(RadixTree, PyRadixCompare) {
       accumulate(rtree.begin(), rtree.end(), 0, counter));
 }
 
+/*
+ * Longest matches on trees big enough to use the stride index must agree
+ * with the ones recording a trail, which walk the tree from the root.
+ */
+TEST(RadixTree, StrideLongestMatch4) {
+  RadixTree<IPAddressV4, int> rtree;
+  std::vector<std::pair<IPAddressV4, uint8_t>> inserted;
+  auto const kInsertCount = 2000;
+  for (auto i = 0; i < kInsertCount; ++i) {
+    // Plenty of prefixes no longer than the stride too
+    auto mask = i % 4 ? folly::Random::rand32(33) : folly::Random::rand32(9);
+    auto ip = IPAddressV4::fromLongHBO(folly::Random::rand32()).mask(mask);
+    if (rtree.insert(ip, mask, i).second) {
+      inserted.emplace_back(ip, mask);
+    }
+  }
+  auto checkLongestMatches = [&rtree]() {
+    RadixTree<IPAddressV4, int>::VecConstIterators trail;
+    for (auto i = 0; i < 1000; ++i) {
+      auto ip = IPAddressV4::fromLongHBO(folly::Random::rand32());
+      auto mask = i % 2 ? 32 : 8 + folly::Random::rand32(25);
+      EXPECT_EQ(
+          rtree.longestMatchWithTrail(ip, mask, trail),
+          rtree.longestMatch(ip, mask));
+      EXPECT_EQ(
+          rtree.exactMatchWithTrail(ip, mask, trail),
+          rtree.exactMatch(ip, mask));
+    }
+  };
+  checkLongestMatches();
+  // Erase until the tree is too small for the index
+  while (rtree.size() > 100) {
+    auto erase = folly::Random::rand32(inserted.size());
+    rtree.erase(inserted[erase].first, inserted[erase].second);
+    if (rtree.size() % 200 == 0) {
+      checkLongestMatches();
+    }
+  }
+  checkLongestMatches();
+}
+
+/*
+ * The delete callback is the tree's, nodes a tree takes over from another
+ * are deleted with its callback.
+ */
+TEST(RadixTree, DeleteCallbackAfterMove) {
+  auto deleteCount = 0;
+  auto otherDeleteCount = 0;
+  RadixTree<IPAddressV4, int> rtree(
+      [&](const RadixTreeNode<IPAddressV4, int>& /*node*/) { ++deleteCount; });
+  {
+    RadixTree<IPAddressV4, int> other(
+        [&](const RadixTreeNode<IPAddressV4, int>& /*node*/) {
+          ++otherDeleteCount;
+        });
+    setupTestTree4(other);
+    rtree = std::move(other);
+    EXPECT_EQ(0, other.size());
+    EXPECT_EQ(0, other.allocatedBytes());
+  }
+  EXPECT_EQ(0, otherDeleteCount);
+  EXPECT_NE(0, rtree.size());
+  EXPECT_NE(0, rtree.allocatedBytes());
+  auto numNodes = 0;
+  for (RadixTree<IPAddressV4, int>::Iterator itr(rtree.root(), true);
+       !itr.atEnd();
+       ++itr) {
+    ++numNodes;
+  }
+  rtree.clear();
+  EXPECT_EQ(numNodes, deleteCount);
+  EXPECT_EQ(0, otherDeleteCount);
+  EXPECT_EQ(0, rtree.allocatedBytes());
+}
+
 /*
  * Test iterating over subtrees of RadixTree
  */
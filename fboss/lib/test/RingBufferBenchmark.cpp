@@ -0,0 +1,150 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+#include "fboss/lib/link_snapshots/RingBuffer-defs.h"
+
+#include <folly/Benchmark.h>
+#include "common/init/Init.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <list>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace facebook::fboss;
+using namespace folly;
+
+namespace {
+// Counts heap allocations made through operator new
+std::atomic<size_t> allocations{0};
+} // namespace
+
+void* operator new(size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (auto ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t /*size*/) noexcept {
+  std::free(ptr);
+}
+
+namespace {
+constexpr size_t kRingLength = 30;
+
+// Roughly the footprint of a link snapshot: a name and per lane samples
+struct Payload {
+  std::string name;
+  std::vector<double> samples;
+};
+
+Payload makePayload(int i) {
+  return Payload{"eth1/1/1", std::vector<double>(64, i)};
+}
+
+// The previous std::list backed ring, one node allocated per write
+template <typename T, size_t length>
+class ListRingBuffer {
+ public:
+  void write(T val) {
+    buf.push_back(std::move(val));
+    if (buf.size() > length) {
+      buf.pop_front();
+    }
+  }
+  const T& last() const {
+    return buf.back();
+  }
+  typename std::list<T>::const_iterator begin() const {
+    return buf.begin();
+  }
+  typename std::list<T>::const_iterator end() const {
+    return buf.end();
+  }
+
+ private:
+  std::list<T> buf;
+};
+
+/*
+ * Heap allocations per write once the ring is full. Building the payload
+ * allocates its samples, anything beyond that is the ring's own.
+ */
+template <typename Ring>
+void writeAllocations(UserCounters& counters, int n) {
+  Ring ring;
+  BENCHMARK_SUSPEND {
+    for (size_t i = 0; i < kRingLength; i++) {
+      ring.write(makePayload(i));
+    }
+  }
+  auto before = allocations.load();
+  for (int i = 0; i < n; i++) {
+    ring.write(makePayload(i));
+    doNotOptimizeAway(ring.last());
+  }
+  counters["allocs_per_write"] = (allocations.load() - before) / n;
+}
+} // namespace
+
+BENCHMARK(ListRingBufferWrite, n) {
+  ListRingBuffer<Payload, kRingLength> ring;
+  for (int i = 0; i < n; i++) {
+    ring.write(makePayload(i));
+    doNotOptimizeAway(ring.last());
+  }
+}
+
+BENCHMARK_RELATIVE(RingBufferWrite, n) {
+  RingBuffer<Payload, kRingLength> ring;
+  for (int i = 0; i < n; i++) {
+    ring.write(makePayload(i));
+    doNotOptimizeAway(ring.last());
+  }
+}
+
+BENCHMARK_COUNTERS(ListRingBufferWriteAllocations, counters, n) {
+  writeAllocations<ListRingBuffer<Payload, kRingLength>>(counters, n);
+}
+
+BENCHMARK_COUNTERS(RingBufferWriteAllocations, counters, n) {
+  writeAllocations<RingBuffer<Payload, kRingLength>>(counters, n);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(ListRingBufferIterate, n) {
+  ListRingBuffer<int, kRingLength> ring;
+  int64_t sum = 0;
+  for (int i = 0; i < n; i++) {
+    ring.write(i);
+    for (auto val : ring) {
+      sum += val;
+    }
+  }
+  doNotOptimizeAway(sum);
+}
+
+BENCHMARK_RELATIVE(RingBufferIterate, n) {
+  RingBuffer<int, kRingLength> ring;
+  int64_t sum = 0;
+  for (int i = 0; i < n; i++) {
+    ring.write(i);
+    for (auto val : ring) {
+      sum += val;
+    }
+  }
+  doNotOptimizeAway(sum);
+}
+
+int main(int argc, char** argv) {
+  facebook::initFacebook(&argc, &argv);
+  runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/lib/link_snapshots/RingBuffer-defs.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+using namespace facebook::fboss;
+
+namespace {
+template <typename Ring>
+std::vector<int> contents(const Ring& ring) {
+  return std::vector<int>(ring.begin(), ring.end());
+}
+} // namespace
+
+TEST(RingBuffer, emptyBuffer) {
+  RingBuffer<int, 3> ring;
+  EXPECT_TRUE(ring.empty());
+  EXPECT_EQ(ring.size(), 0);
+  EXPECT_EQ(ring.maxSize(), 3);
+  EXPECT_EQ(ring.begin(), ring.end());
+  EXPECT_THROW(ring.last(), FbossError);
+}
+
+TEST(RingBuffer, keepsLastValuesInOrder) {
+  RingBuffer<int, 3> ring;
+  ring.write(1);
+  ring.write(2);
+  EXPECT_EQ(ring.size(), 2);
+  EXPECT_EQ(ring.last(), 2);
+  EXPECT_EQ(contents(ring), std::vector<int>({1, 2}));
+
+  for (int i = 3; i <= 7; i++) {
+    ring.write(i);
+    EXPECT_EQ(ring.last(), i);
+    EXPECT_EQ(ring.size(), std::min(i, 3));
+  }
+  EXPECT_EQ(contents(ring), std::vector<int>({5, 6, 7}));
+}
+
+TEST(RingBuffer, modifyInPlace) {
+  RingBuffer<int, 2> ring;
+  for (int i = 0; i < 3; i++) {
+    ring.write(i);
+  }
+  for (auto& val : ring) {
+    val *= 10;
+  }
+  ring.last()++;
+  EXPECT_EQ(contents(ring), std::vector<int>({10, 21}));
+}
+
+TEST(RingBuffer, copyIsIndependent) {
+  RingBuffer<std::string, 2> ring;
+  ring.write("a");
+  ring.write("b");
+  auto copy = ring;
+  ring.write("c");
+  EXPECT_EQ(copy.last(), "b");
+  EXPECT_EQ(*copy.begin(), "a");
+  EXPECT_EQ(ring.last(), "c");
+  EXPECT_EQ(*ring.begin(), "b");
+}
+
+TEST(RingBuffer, writeMovesValue) {
+  RingBuffer<std::string, 1> ring;
+  std::string val(100, 'x');
+  ring.write(std::move(val));
+  ring.write(std::string(100, 'y'));
+  EXPECT_EQ(ring.size(), 1);
+  EXPECT_EQ(ring.last(), std::string(100, 'y'));
+}
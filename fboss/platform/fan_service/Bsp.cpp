@@ -33,7 +33,15 @@ Bsp::Bsp() {
   fsdbSensorSubscriber_ =
       std::make_unique<FsdbSensorSubscriber>(fsdbPubSubMgr_.get());
   if (FLAGS_subscribe_to_stats_from_fsdb) {
-    fsdbSensorSubscriber_->subscribeToSensorServiceStat(subscribedSensorData);
+    fsdbSensorSubscriber_->subscribeToSensorServiceStat(
+        subscribedSensorData,
+        [this](const FsdbSensorSubscriber::SensorDataMap& updated) {
+          sensorUpdateCb_.withRLock([&](const auto& cb) {
+            if (cb) {
+              cb(updated);
+            }
+          });
+        });
   }
 }
 
@@ -122,6 +130,10 @@ void Bsp::getSensorData(
     initialSensorDataRead_ = true;
   }
 }
+void Bsp::setSensorUpdateCallback(FsdbSensorSubscriber::SensorUpdateCb cb) {
+  *sensorUpdateCb_.wlock() = std::move(cb);
+}
+
 bool Bsp::checkIfInitialSensorDataRead() const {
   return initialSensorDataRead_;
 }
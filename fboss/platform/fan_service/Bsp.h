@@ -71,6 +71,10 @@ class Bsp {
   FsdbSensorSubscriber* fsdbSensorSubscriber() {
     return fsdbSensorSubscriber_.get();
   }
+  // Called from the FSDB thread with the sensors that changed, when
+  // subscribed to sensor data from FSDB. Clearing the callback waits
+  // for an in-flight call to return.
+  void setSensorUpdateCallback(FsdbSensorSubscriber::SensorUpdateCb cb);
   void getSensorDataThrift(
       std::shared_ptr<ServiceConfig> pServiceConfig,
       std::shared_ptr<SensorData> pSensorData);
@@ -143,5 +147,6 @@ class Bsp {
   folly::Synchronized<
       std::map<std::string, fboss::platform::sensor_service::SensorData>>
       subscribedSensorData;
+  folly::Synchronized<FsdbSensorSubscriber::SensorUpdateCb> sensorUpdateCb_;
 };
 } // namespace facebook::fboss::platform
@@ -21,6 +21,14 @@ ControlLogic::ControlLogic(
   numFanFailed_ = 0;
   numSensorFailed_ = 0;
   lastControlUpdateSec_ = pBsp_->getCurrentTime();
+  for (auto& sensor : pConfig_->sensors) {
+    sensorIndex_[sensor.sensorName] = &sensor;
+  }
+  for (auto& zone : pConfig_->zones) {
+    for (const auto& sensorName : zone.sensorNames) {
+      sensorZones_[sensorName].push_back(&zone);
+    }
+  }
 }
 
 ControlLogic::~ControlLogic() {}
@@ -247,147 +255,152 @@ void ControlLogic::updateTargetPwm(Sensor* sensorItem) {
 }
 
 void ControlLogic::getSensorUpdate() {
+  for (auto& sensorItem : pConfig_->sensors) {
+    // Skip readings already applied by updateControlForSensors, so that
+    // the same reading does not step the controller twice.
+    if (sensorsUpdatedByEvent_.count(sensorItem.sensorName) &&
+        pSensor_->checkIfEntryExists(sensorItem.sensorName) &&
+        pSensor_->getLastUpdated(sensorItem.sensorName) ==
+            sensorItem.processedData.lastUpdatedTime) {
+      continue;
+    }
+    processSensorUpdate(&sensorItem);
+  }
+  sensorsUpdatedByEvent_.clear();
+}
+
+void ControlLogic::processSensorUpdate(Sensor* sensorItem) {
   std::string sensorItemName;
   float rawValue = 0.0, adjustedValue;
   uint64_t calculatedTime = 0;
-  for (auto configSensorItem = pConfig_->sensors.begin();
-       configSensorItem != pConfig_->sensors.end();
-       ++configSensorItem) {
-    XLOG(INFO) << "Control :: Sensor Name : " << configSensorItem->sensorName;
-    bool sensorAccessFail = false;
-    sensorItemName = configSensorItem->sensorName;
-    if (pSensor_->checkIfEntryExists(sensorItemName)) {
-      XLOG(INFO) << "Control :: Sensor Exists. Getting the entry type";
-      // 1.a Get the reading
-      SensorEntryType entryType = pSensor_->getSensorEntryType(sensorItemName);
-      switch (entryType) {
-        case SensorEntryType::kSensorEntryInt:
-          rawValue = pSensor_->getSensorDataInt(sensorItemName);
-          rawValue = rawValue / configSensorItem->scale;
-          break;
-        case SensorEntryType::kSensorEntryFloat:
-          rawValue = pSensor_->getSensorDataFloat(sensorItemName);
-          rawValue = rawValue / configSensorItem->scale;
-          break;
-        default:
-          facebook::fboss::FbossError(
-              "Invalid Sensor Entry Type in entry name : ", sensorItemName);
-          break;
-      }
-    } else {
-      XLOG(ERR) << "Control :: Sensor Read Fail : " << sensorItemName;
-      sensorAccessFail = true;
+  XLOG(INFO) << "Control :: Sensor Name : " << sensorItem->sensorName;
+  bool sensorAccessFail = false;
+  sensorItemName = sensorItem->sensorName;
+  if (pSensor_->checkIfEntryExists(sensorItemName)) {
+    XLOG(INFO) << "Control :: Sensor Exists. Getting the entry type";
+    // 1.a Get the reading
+    SensorEntryType entryType = pSensor_->getSensorEntryType(sensorItemName);
+    switch (entryType) {
+      case SensorEntryType::kSensorEntryInt:
+        rawValue = pSensor_->getSensorDataInt(sensorItemName);
+        rawValue = rawValue / sensorItem->scale;
+        break;
+      case SensorEntryType::kSensorEntryFloat:
+        rawValue = pSensor_->getSensorDataFloat(sensorItemName);
+        rawValue = rawValue / sensorItem->scale;
+        break;
+      default:
+        facebook::fboss::FbossError(
+            "Invalid Sensor Entry Type in entry name : ", sensorItemName);
+        break;
     }
-    XLOG(INFO) << "Control :: Done raw sensor reading";
-
-    if (sensorAccessFail) {
-      // If the sensor data cache is stale for a while, we consider it as the
-      // failure of such sensor
-      uint64_t timeDiffInSec = pBsp_->getCurrentTime() -
-          configSensorItem->processedData.lastUpdatedTime;
-      if (timeDiffInSec >= configSensorItem->sensorFailThresholdInSec) {
-        configSensorItem->processedData.sensorFailed = true;
-        numSensorFailed_++;
-      }
-    } else {
-      calculatedTime = pSensor_->getLastUpdated(sensorItemName);
-      configSensorItem->processedData.lastUpdatedTime = calculatedTime;
-      configSensorItem->processedData.sensorFailed = false;
+  } else {
+    XLOG(ERR) << "Control :: Sensor Read Fail : " << sensorItemName;
+    sensorAccessFail = true;
+  }
+  XLOG(INFO) << "Control :: Done raw sensor reading";
+
+  if (sensorAccessFail) {
+    // If the sensor data cache is stale for a while, we consider it as the
+    // failure of such sensor
+    uint64_t timeDiffInSec = pBsp_->getCurrentTime() -
+        sensorItem->processedData.lastUpdatedTime;
+    if (timeDiffInSec >= sensorItem->sensorFailThresholdInSec) {
+      sensorItem->processedData.sensorFailed = true;
+      numSensorFailed_++;
     }
+  } else {
+    calculatedTime = pSensor_->getLastUpdated(sensorItemName);
+    sensorItem->processedData.lastUpdatedTime = calculatedTime;
+    sensorItem->processedData.sensorFailed = false;
+  }
 
-    // 1.b If adjustment table exists, adjust the raw value
-    if (configSensorItem->offsetTable.size() == 0) {
-      adjustedValue = rawValue;
-    } else {
-      float offset = 0;
-      for (auto tableEntry = configSensorItem->offsetTable.begin();
-           tableEntry != configSensorItem->offsetTable.end();
-           ++tableEntry) {
-        if (rawValue >= tableEntry->first) {
-          offset = tableEntry->second;
-        }
-        adjustedValue = rawValue + offset;
+  // 1.b If adjustment table exists, adjust the raw value
+  if (sensorItem->offsetTable.size() == 0) {
+    adjustedValue = rawValue;
+  } else {
+    float offset = 0;
+    for (auto tableEntry = sensorItem->offsetTable.begin();
+         tableEntry != sensorItem->offsetTable.end();
+         ++tableEntry) {
+      if (rawValue >= tableEntry->first) {
+        offset = tableEntry->second;
       }
+      adjustedValue = rawValue + offset;
     }
-    configSensorItem->processedData.adjustedReadCache = adjustedValue;
-    XLOG(INFO) << "Control :: Adjusted Value : " << adjustedValue;
-    // 1.c Check and trigger alarm
-    bool prevMajorAlarm = configSensorItem->processedData.majorAlarmTriggered;
-    configSensorItem->processedData.majorAlarmTriggered =
-        (adjustedValue >= configSensorItem->alarm.high_major);
-    // If major alarm was triggered, write it as a ERR log
-    if (!prevMajorAlarm &&
-        configSensorItem->processedData.majorAlarmTriggered) {
-      XLOG(ERR) << "Major Alarm Triggered on " << configSensorItem->sensorName
-                << " at value " << adjustedValue;
-    } else if (
-        prevMajorAlarm &&
-        !configSensorItem->processedData.majorAlarmTriggered) {
-      XLOG(WARN) << "Major Alarm Cleared on " << configSensorItem->sensorName
-                 << " at value " << adjustedValue;
-    }
-    bool prevMinorAlarm = configSensorItem->processedData.minorAlarmTriggered;
-    if (adjustedValue >= configSensorItem->alarm.high_minor) {
-      if (configSensorItem->processedData.soakStarted) {
-        uint64_t timeDiffInSec = pBsp_->getCurrentTime() -
-            configSensorItem->processedData.soakStartedAt;
-        if (timeDiffInSec >= configSensorItem->alarm.high_minor_soak) {
-          configSensorItem->processedData.minorAlarmTriggered = true;
-          configSensorItem->processedData.soakStarted = false;
-        }
-      } else {
-        configSensorItem->processedData.soakStarted = true;
-        configSensorItem->processedData.soakStartedAt = calculatedTime;
+  }
+  sensorItem->processedData.adjustedReadCache = adjustedValue;
+  XLOG(INFO) << "Control :: Adjusted Value : " << adjustedValue;
+  // 1.c Check and trigger alarm
+  bool prevMajorAlarm = sensorItem->processedData.majorAlarmTriggered;
+  sensorItem->processedData.majorAlarmTriggered =
+      (adjustedValue >= sensorItem->alarm.high_major);
+  // If major alarm was triggered, write it as a ERR log
+  if (!prevMajorAlarm && sensorItem->processedData.majorAlarmTriggered) {
+    XLOG(ERR) << "Major Alarm Triggered on " << sensorItem->sensorName
+              << " at value " << adjustedValue;
+  } else if (
+      prevMajorAlarm && !sensorItem->processedData.majorAlarmTriggered) {
+    XLOG(WARN) << "Major Alarm Cleared on " << sensorItem->sensorName
+               << " at value " << adjustedValue;
+  }
+  bool prevMinorAlarm = sensorItem->processedData.minorAlarmTriggered;
+  if (adjustedValue >= sensorItem->alarm.high_minor) {
+    if (sensorItem->processedData.soakStarted) {
+      uint64_t timeDiffInSec = pBsp_->getCurrentTime() -
+          sensorItem->processedData.soakStartedAt;
+      if (timeDiffInSec >= sensorItem->alarm.high_minor_soak) {
+        sensorItem->processedData.minorAlarmTriggered = true;
+        sensorItem->processedData.soakStarted = false;
       }
     } else {
-      configSensorItem->processedData.minorAlarmTriggered = false;
-      configSensorItem->processedData.soakStarted = false;
-    }
-    // If minor alarm was triggered, write it as a WARN log
-    if (!prevMinorAlarm &&
-        configSensorItem->processedData.minorAlarmTriggered) {
-      XLOG(WARN) << "Minor Alarm Triggered on " << configSensorItem->sensorName
-                 << " at value " << adjustedValue;
-    }
-    if (prevMinorAlarm &&
-        !configSensorItem->processedData.minorAlarmTriggered) {
-      XLOG(WARN) << "Minor Alarm Cleared on " << configSensorItem->sensorName
-                 << " at value " << adjustedValue;
+      sensorItem->processedData.soakStarted = true;
+      sensorItem->processedData.soakStartedAt = calculatedTime;
     }
-    // 1.d Check the range (if required), and do emergency
-    // shutdown, if the value is out of range for more than
-    // the "tolerance" times
-    if (configSensorItem->rangeCheck.enabled) {
-      if ((adjustedValue > configSensorItem->rangeCheck.rangeHigh) ||
-          (adjustedValue < configSensorItem->rangeCheck.rangeLow)) {
-        configSensorItem->rangeCheck.invalidCount += 1;
-        if (configSensorItem->rangeCheck.invalidCount >=
-            configSensorItem->rangeCheck.tolerance) {
-          // ERR log only once.
-          if (configSensorItem->rangeCheck.invalidCount ==
-              configSensorItem->rangeCheck.tolerance) {
-            XLOG(ERR) << "Sensor " << configSensorItem->sensorName
-                      << " out of range for too long!";
-          }
-          // If we are not yet in emergency state, do the emergency shutdown.
-          if ((configSensorItem->rangeCheck.action ==
-               kRangeCheckActionShutdown) &&
-              (pBsp_->getEmergencyState() == false)) {
-            pBsp_->emergencyShutdown(pConfig_, true);
-          }
+  } else {
+    sensorItem->processedData.minorAlarmTriggered = false;
+    sensorItem->processedData.soakStarted = false;
+  }
+  // If minor alarm was triggered, write it as a WARN log
+  if (!prevMinorAlarm && sensorItem->processedData.minorAlarmTriggered) {
+    XLOG(WARN) << "Minor Alarm Triggered on " << sensorItem->sensorName
+               << " at value " << adjustedValue;
+  }
+  if (prevMinorAlarm && !sensorItem->processedData.minorAlarmTriggered) {
+    XLOG(WARN) << "Minor Alarm Cleared on " << sensorItem->sensorName
+               << " at value " << adjustedValue;
+  }
+  // 1.d Check the range (if required), and do emergency
+  // shutdown, if the value is out of range for more than
+  // the "tolerance" times
+  if (sensorItem->rangeCheck.enabled) {
+    if ((adjustedValue > sensorItem->rangeCheck.rangeHigh) ||
+        (adjustedValue < sensorItem->rangeCheck.rangeLow)) {
+      sensorItem->rangeCheck.invalidCount += 1;
+      if (sensorItem->rangeCheck.invalidCount >=
+          sensorItem->rangeCheck.tolerance) {
+        // ERR log only once.
+        if (sensorItem->rangeCheck.invalidCount ==
+            sensorItem->rangeCheck.tolerance) {
+          XLOG(ERR) << "Sensor " << sensorItem->sensorName
+                    << " out of range for too long!";
+        }
+        // If we are not yet in emergency state, do the emergency shutdown.
+        if ((sensorItem->rangeCheck.action == kRangeCheckActionShutdown) &&
+            (pBsp_->getEmergencyState() == false)) {
+          pBsp_->emergencyShutdown(pConfig_, true);
         }
-      } else {
-        configSensorItem->rangeCheck.invalidCount = 0;
       }
+    } else {
+      sensorItem->rangeCheck.invalidCount = 0;
     }
-    // 1.e Calculate the target pwm in percent
-    //     (the table or incremental pid should produce
-    //      percent as its output)
-    updateTargetPwm(&(*configSensorItem));
-    XLOG(INFO) << configSensorItem->sensorName << " has the target PWM of "
-               << configSensorItem->processedData.targetPwmCache;
   }
-  return;
+  // 1.e Calculate the target pwm in percent
+  //     (the table or incremental pid should produce
+  //      percent as its output)
+  updateTargetPwm(sensorItem);
+  XLOG(INFO) << sensorItem->sensorName << " has the target PWM of "
+             << sensorItem->processedData.targetPwmCache;
 }
 
 void ControlLogic::getOpticsUpdate() {
@@ -447,13 +460,10 @@ void ControlLogic::getOpticsUpdate() {
   }
 }
 
-Sensor* ControlLogic::findSensorConfig(std::string sensorName) {
-  for (auto sensorConfig = pConfig_->sensors.begin();
-       sensorConfig != pConfig_->sensors.end();
-       ++sensorConfig) {
-    if (sensorConfig->sensorName == sensorName) {
-      return &(*sensorConfig);
-    }
+Sensor* ControlLogic::findSensorConfig(const std::string& sensorName) {
+  auto it = sensorIndex_.find(sensorName);
+  if (it != sensorIndex_.end()) {
+    return it->second;
   }
   facebook::fboss::FbossError("Enable to find sensorConfig : ", sensorName);
   return nullptr;
@@ -628,74 +638,77 @@ void ControlLogic::setFanFailState(Fan* fan, bool fanFailed) {
 }
 
 void ControlLogic::adjustZoneFans(bool boostMode) {
-  for (auto zone = pConfig_->zones.begin(); zone != pConfig_->zones.end();
-       ++zone) {
-    float pwmSoFar = 0;
-    XLOG(INFO) << "Zone : " << zone->zoneName;
-    // First, calculate the pwm value for this zone
-    auto zoneType = zone->type;
-    int totalPwmConsidered = 0;
-    for (auto sensorName = zone->sensorNames.begin();
-         sensorName != zone->sensorNames.end();
-         sensorName++) {
-      auto pSensorConfig_ = findSensorConfig(*sensorName);
-      if ((pSensorConfig_ != nullptr) ||
-          (pSensor_->checkIfOpticEntryExists(*sensorName))) {
-        totalPwmConsidered++;
-        float pwmForThisSensor;
-        if (pSensorConfig_ != nullptr) {
-          // If this is a sensor name
-          pwmForThisSensor = pSensorConfig_->processedData.targetPwmCache;
-        } else {
-          // If this is an optics name
-          pwmForThisSensor = pSensor_->getOpticsPwm(*sensorName);
-        }
-        switch (zoneType) {
-          case fan_config_structs::ZoneType::kZoneMax:
-            if (pwmSoFar < pwmForThisSensor) {
-              pwmSoFar = pwmForThisSensor;
-            }
-            break;
-          case fan_config_structs::ZoneType::kZoneMin:
-            if (pwmSoFar > pwmForThisSensor) {
-              pwmSoFar = pwmForThisSensor;
-            }
-            break;
-          case fan_config_structs::ZoneType::kZoneAvg:
-            pwmSoFar += pwmForThisSensor;
-            break;
-          case fan_config_structs::ZoneType::kZoneInval:
-          default:
-            facebook::fboss::FbossError(
-                "Undefined Zone Type for zone : ", zone->zoneName);
-            break;
-        }
-        XLOG(INFO) << "  Sensor/Optic " << *sensorName << " : "
-                   << pwmForThisSensor << " Overall so far : " << pwmSoFar;
+  for (auto& zone : pConfig_->zones) {
+    adjustZoneFan(&zone, boostMode);
+  }
+}
+
+void ControlLogic::adjustZoneFan(Zone* zone, bool boostMode) {
+  float pwmSoFar = 0;
+  XLOG(INFO) << "Zone : " << zone->zoneName;
+  // First, calculate the pwm value for this zone
+  auto zoneType = zone->type;
+  int totalPwmConsidered = 0;
+  for (auto sensorName = zone->sensorNames.begin();
+       sensorName != zone->sensorNames.end();
+       sensorName++) {
+    auto pSensorConfig_ = findSensorConfig(*sensorName);
+    if ((pSensorConfig_ != nullptr) ||
+        (pSensor_->checkIfOpticEntryExists(*sensorName))) {
+      totalPwmConsidered++;
+      float pwmForThisSensor;
+      if (pSensorConfig_ != nullptr) {
+        // If this is a sensor name
+        pwmForThisSensor = pSensorConfig_->processedData.targetPwmCache;
+      } else {
+        // If this is an optics name
+        pwmForThisSensor = pSensor_->getOpticsPwm(*sensorName);
       }
-    }
-    if (zoneType == fan_config_structs::ZoneType::kZoneAvg) {
-      pwmSoFar /= (float)totalPwmConsidered;
-    }
-    XLOG(INFO) << "  Final PWM : " << pwmSoFar;
-    if (boostMode) {
-      if (pwmSoFar < pConfig_->getPwmBoostValue()) {
-        pwmSoFar = pConfig_->getPwmBoostValue();
+      switch (zoneType) {
+        case fan_config_structs::ZoneType::kZoneMax:
+          if (pwmSoFar < pwmForThisSensor) {
+            pwmSoFar = pwmForThisSensor;
+          }
+          break;
+        case fan_config_structs::ZoneType::kZoneMin:
+          if (pwmSoFar > pwmForThisSensor) {
+            pwmSoFar = pwmForThisSensor;
+          }
+          break;
+        case fan_config_structs::ZoneType::kZoneAvg:
+          pwmSoFar += pwmForThisSensor;
+          break;
+        case fan_config_structs::ZoneType::kZoneInval:
+        default:
+          facebook::fboss::FbossError(
+              "Undefined Zone Type for zone : ", zone->zoneName);
+          break;
       }
+      XLOG(INFO) << "  Sensor/Optic " << *sensorName << " : "
+                 << pwmForThisSensor << " Overall so far : " << pwmSoFar;
     }
-    // Update the previous pwm value in each associated sensors,
-    // so that they may be used in the next calculation.
-    for (auto sensorName = zone->sensorNames.begin();
-         sensorName != zone->sensorNames.end();
-         sensorName++) {
-      auto pSensorConfig_ = findSensorConfig(*sensorName);
-      if (pSensorConfig_ != nullptr) {
-        pSensorConfig_->incrementPid.previousTargetPwm = pwmSoFar;
-      }
+  }
+  if (zoneType == fan_config_structs::ZoneType::kZoneAvg) {
+    pwmSoFar /= (float)totalPwmConsidered;
+  }
+  XLOG(INFO) << "  Final PWM : " << pwmSoFar;
+  if (boostMode) {
+    if (pwmSoFar < pConfig_->getPwmBoostValue()) {
+      pwmSoFar = pConfig_->getPwmBoostValue();
+    }
+  }
+  // Update the previous pwm value in each associated sensors,
+  // so that they may be used in the next calculation.
+  for (auto sensorName = zone->sensorNames.begin();
+       sensorName != zone->sensorNames.end();
+       sensorName++) {
+    auto pSensorConfig_ = findSensorConfig(*sensorName);
+    if (pSensorConfig_ != nullptr) {
+      pSensorConfig_->incrementPid.previousTargetPwm = pwmSoFar;
     }
-    // Secondly, set Zone pwm value to all the fans in the zone
-    programFan(&(*zone), pwmSoFar);
   }
+  // Secondly, set Zone pwm value to all the fans in the zone
+  programFan(zone, pwmSoFar);
 }
 
 void ControlLogic::setTransitionValue() {
@@ -778,8 +791,44 @@ void ControlLogic::updateControl(std::shared_ptr<SensorData> pS) {
   // It's not recommended to put a fan in multiple zones,
   // even though it's possible to do so.
   adjustZoneFans(boostMode);
+  boostMode_ = boostMode;
   // Update the time stamp
   lastControlUpdateSec_ = pBsp_->getCurrentTime();
 }
 
+void ControlLogic::updateControlForSensors(
+    std::shared_ptr<SensorData> pS,
+    const std::vector<std::string>& sensorNames) {
+  pSensor_ = pS;
+  std::vector<Zone*> zonesToUpdate;
+  for (const auto& sensorName : sensorNames) {
+    auto sensorIt = sensorIndex_.find(sensorName);
+    auto zonesIt = sensorZones_.find(sensorName);
+    // Sensors not used by any zone are left to the periodic update
+    if (sensorIt == sensorIndex_.end() || zonesIt == sensorZones_.end()) {
+      continue;
+    }
+    Sensor* sensorItem = sensorIt->second;
+    // Only a new reading is processed, the same one is never applied twice
+    if (!pSensor_->checkIfEntryExists(sensorName) ||
+        pSensor_->getLastUpdated(sensorName) ==
+            sensorItem->processedData.lastUpdatedTime) {
+      continue;
+    }
+    processSensorUpdate(sensorItem);
+    sensorsUpdatedByEvent_.insert(sensorName);
+    for (auto zone : zonesIt->second) {
+      if (std::find(zonesToUpdate.begin(), zonesToUpdate.end(), zone) ==
+          zonesToUpdate.end()) {
+        zonesToUpdate.push_back(zone);
+      }
+    }
+  }
+  for (auto zone : zonesToUpdate) {
+    XLOG(INFO) << "Control :: Updating Zone " << zone->zoneName
+               << " on sensor update";
+    adjustZoneFan(zone, boostMode_);
+  }
+}
+
 } // namespace facebook::fboss::platform
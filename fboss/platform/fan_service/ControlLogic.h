@@ -2,6 +2,9 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <unordered_set>
+
 #include "Bsp.h"
 #include "SensorData.h"
 
@@ -19,6 +22,13 @@ class ControlLogic {
   // updateControl : Main entry for the control logic to process sensor
   //                 readings and set PWM value accordingly
   void updateControl(std::shared_ptr<SensorData> pS);
+  // updateControlForSensors : Process the new readings of the given sensors
+  //                 right away, and reprogram only the zones using them.
+  //                 Fan status and boost mode are kept as of the last
+  //                 updateControl call.
+  void updateControlForSensors(
+      std::shared_ptr<SensorData> pS,
+      const std::vector<std::string>& sensorNames);
   void setTransitionValue();
 
  private:
@@ -32,16 +42,27 @@ class ControlLogic {
   int numSensorFailed_;
   // Last control update time. Used for dT calculation
   uint64_t lastControlUpdateSec_;
+  // Boost mode decided by the last updateControl call
+  bool boostMode_{false};
+  // Sensor config by name, and the zones each sensor/optic name is used in.
+  // Built once at construction, config is not modified after parsing.
+  std::unordered_map<std::string, Sensor*> sensorIndex_;
+  std::unordered_map<std::string, std::vector<Zone*>> sensorZones_;
+  // Sensors whose current reading was already processed by
+  // updateControlForSensors since the last updateControl call
+  std::unordered_set<std::string> sensorsUpdatedByEvent_;
 
   // Private Methods
   void getSensorUpdate();
   void getFanUpdate();
   void getOpticsUpdate();
+  void processSensorUpdate(Sensor* sensorItem);
   void programFan(Zone* zone, float pwmSoFar);
   void adjustZoneFans(bool boostMode);
+  void adjustZoneFan(Zone* zone, bool boostMode);
   void updateTargetPwm(Sensor* sensorItem);
   void setFanFailState(Fan* fan, bool fanFailed);
   bool checkIfFanPresent(Fan* fan);
-  Sensor* findSensorConfig(std::string sensorName);
+  Sensor* findSensorConfig(const std::string& sensorName);
 };
 } // namespace facebook::fboss::platform
@@ -19,6 +19,13 @@ FanService::FanService() {
   return;
 }
 
+FanService::~FanService() {
+  // Make sure no sensor update comes in while tearing down
+  if (pBsp_) {
+    pBsp_->setSensorUpdateCallback(nullptr);
+  }
+}
+
 void FanService::setControlFrequency(uint64_t sec) {
   controlFrequencySec_ = sec;
 }
@@ -72,9 +79,33 @@ void FanService::kickstart() {
 
   // Start control logic, and attach bsp and sensors
   pControlLogic_ = std::make_shared<ControlLogic>(pConfig_, pBsp_);
+
+  // React to sensor data pushed by FSDB right away
+  pBsp_->setSensorUpdateCallback(
+      [this](const FsdbSensorSubscriber::SensorDataMap& updated) {
+        onSensorUpdate(updated);
+      });
+}
+
+void FanService::onSensorUpdate(
+    const FsdbSensorSubscriber::SensorDataMap& updated) {
+  std::lock_guard<std::mutex> lock(controlMutex_);
+  // Leave everything to controlFan until it ran at least once
+  if (lastControlExecutionTimeSec_ == 0) {
+    return;
+  }
+  std::vector<std::string> sensorNames;
+  sensorNames.reserve(updated.size());
+  for (const auto& [name, sensorData] : updated) {
+    pSensorData_->updateEntryFloat(
+        *sensorData.name(), *sensorData.value(), *sensorData.timeStamp());
+    sensorNames.push_back(*sensorData.name());
+  }
+  pControlLogic_->updateControlForSensors(pSensorData_, sensorNames);
 }
 
 int FanService::controlFan(/*folly::EventBase* evb*/) {
+  std::lock_guard<std::mutex> lock(controlMutex_);
   int rc = 0;
   uint64_t currentTimeSec = pBsp_->getCurrentTime();
   if (!transitionValueSet_) {
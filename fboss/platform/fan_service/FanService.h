@@ -2,6 +2,7 @@
 #pragma once
 
 #include <gflags/gflags.h>
+#include <mutex>
 #include <string>
 #include "Bsp.h"
 #include "ControlLogic.h"
@@ -27,11 +28,14 @@ class FanService {
  public:
   // Constructor / destructor
   FanService();
-  ~FanService() {} // Make compiler happy in handling smart pointers
+  ~FanService();
   // Instantiates all classes used by Fan Service
   void kickstart();
   // Runs Fan PWM control logic
   int controlFan();
+  // Applies sensor readings pushed by FSDB, and reprograms only the zones
+  // using the updated sensors without waiting for the next controlFan run
+  void onSensorUpdate(const FsdbSensorSubscriber::SensorDataMap& updated);
   // A special function to run Fan Service as a Mock
   // (simulation for unit testing)
   int runMock(std::string mockInputFile, std::string mockOutputFile);
@@ -66,6 +70,8 @@ class FanService {
   uint64_t lastSensorFetchTimeSec_;
   // How often we run fan control logic?
   uint64_t controlFrequencySec_;
+  // Serializes controlFan and onSensorUpdate
+  std::mutex controlMutex_;
 
   // Methods
   // Control Logic Execution Frequency in seconds
@@ -9,32 +9,56 @@
 
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 #include <optional>
+#include <utility>
 
 namespace facebook::fboss {
 
 template <typename T>
 void FsdbSensorSubscriber::subscribeToStat(
     std::vector<std::string> path,
-    folly::Synchronized<T>& storage) {
+    folly::Synchronized<T>& storage,
+    std::function<void(const T& oldData, const T& newData)> onUpdate) {
   auto stateCb = [](fsdb::FsdbStreamClient::State /*old*/,
                     fsdb::FsdbStreamClient::State /*new*/) {};
-  auto dataCb = [&](fsdb::OperState&& state) {
-    storage.withWLock([&](auto& locked) {
-      if (auto contents = state.contents()) {
-        locked = apache::thrift::BinarySerializer::deserialize<T>(*contents);
-      } else {
-        locked = {};
-      }
-    });
+  auto dataCb = [&storage, onUpdate](fsdb::OperState&& state) {
+    T newData{};
+    if (auto contents = state.contents()) {
+      newData = apache::thrift::BinarySerializer::deserialize<T>(*contents);
+    }
+    if (!onUpdate) {
+      *storage.wlock() = std::move(newData);
+      return;
+    }
+    T oldData = storage.withWLock(
+        [&](auto& locked) { return std::exchange(locked, newData); });
+    // Outside of the lock, so the callback may read storage
+    onUpdate(oldData, newData);
   };
   pubSubMgr()->addStatPathSubscription(path, stateCb, dataCb);
 }
 
 void FsdbSensorSubscriber::subscribeToSensorServiceStat(
-    folly::Synchronized<
-        std::map<std::string, fboss::platform::sensor_service::SensorData>>&
-        storage) {
-  subscribeToStat(getSensorDataStatsPath(), storage);
+    folly::Synchronized<SensorDataMap>& storage,
+    SensorUpdateCb onUpdate) {
+  std::function<void(const SensorDataMap&, const SensorDataMap&)> diffCb;
+  if (onUpdate) {
+    diffCb = [onUpdate](
+                 const SensorDataMap& oldData, const SensorDataMap& newData) {
+      SensorDataMap updated;
+      for (const auto& [name, sensorData] : newData) {
+        auto it = oldData.find(name);
+        if (it == oldData.end() ||
+            *it->second.timeStamp() != *sensorData.timeStamp() ||
+            *it->second.value() != *sensorData.value()) {
+          updated.emplace(name, sensorData);
+        }
+      }
+      if (!updated.empty()) {
+        onUpdate(updated);
+      }
+    };
+  }
+  subscribeToStat(getSensorDataStatsPath(), storage, std::move(diffCb));
 }
 
 } // namespace facebook::fboss
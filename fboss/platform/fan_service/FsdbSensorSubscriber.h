@@ -6,6 +6,7 @@
 #include "fboss/fsdb/client/FsdbStreamClient.h"
 #include "fboss/platform/sensor_service/if/gen-cpp2/sensor_service_types.h"
 
+#include <functional>
 #include <memory>
 
 namespace facebook::fboss {
@@ -14,6 +15,11 @@ class FsdbPubSubManager;
 }
 class FsdbSensorSubscriber {
  public:
+  using SensorDataMap =
+      std::map<std::string, fboss::platform::sensor_service::SensorData>;
+  // Called with the sensors whose data changed in an update
+  using SensorUpdateCb = std::function<void(const SensorDataMap& updated)>;
+
   explicit FsdbSensorSubscriber(fsdb::FsdbPubSubManager* pubSubMgr)
       : fsdbPubSubMgr_(pubSubMgr) {}
 
@@ -22,9 +28,8 @@ class FsdbSensorSubscriber {
   }
 
   void subscribeToSensorServiceStat(
-      folly::Synchronized<
-          std::map<std::string, fboss::platform::sensor_service::SensorData>>&
-          storage);
+      folly::Synchronized<SensorDataMap>& storage,
+      SensorUpdateCb onUpdate = nullptr);
 
   // Paths
   static std::vector<std::string> getSensorDataStatsPath();
@@ -33,7 +38,8 @@ class FsdbSensorSubscriber {
   template <typename T>
   void subscribeToStat(
       std::vector<std::string> path,
-      folly::Synchronized<T>& storage);
+      folly::Synchronized<T>& storage,
+      std::function<void(const T& oldData, const T& newData)> onUpdate);
   fsdb::FsdbPubSubManager* fsdbPubSubMgr_;
 };
 
@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/platform/fan_service/ControlLogic.h"
+#include "fboss/platform/fan_service/Bsp.h"
+#include "fboss/platform/fan_service/ServiceConfig.h"
+#include "fboss/platform/fan_service/if/gen-cpp2/fan_config_structs_types.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss::platform;
+
+namespace {
+
+// Records fan pwm writes instead of touching sysfs
+class TestBsp : public Bsp {
+ public:
+  uint64_t getCurrentTime() const override {
+    return now;
+  }
+  bool checkIfInitialSensorDataRead() const override {
+    return true;
+  }
+  uint64_t now{100};
+  std::map<std::string, int> writes;
+
+ private:
+  bool writeSysfs(std::string path, int value) override {
+    writes[path] = value;
+    return true;
+  }
+};
+
+} // namespace
+
+class ControlLogicTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    config_ = std::make_shared<ServiceConfig>();
+    for (const std::string name : {"1", "2"}) {
+      Sensor sensor;
+      sensor.sensorName = "sensor" + name;
+      sensor.scale = 1;
+      sensor.calculationType =
+          fan_config_structs::SensorPwmCalcType::kSensorPwmCalcFourLinearTable;
+      std::vector<std::pair<float, float>> table = {
+          {0, 20}, {40, 50}, {60, 80}};
+      sensor.fourCurves.normalUp = table;
+      sensor.fourCurves.normalDown = table;
+      sensor.fourCurves.failUp = table;
+      sensor.fourCurves.failDown = table;
+      config_->sensors.push_back(sensor);
+
+      Fan fan;
+      fan.fanName = "fan" + name;
+      fan.pwmMax = 100;
+      fan.pwm.accessType() = fan_config_structs::SourceType::kSrcSysfs;
+      fan.pwm.path() = "fan" + name + "_pwm";
+      fan.rpmAccess.accessType() = fan_config_structs::SourceType::kSrcThrift;
+      fan.rpmAccess.path() = "fan" + name + "_rpm";
+      config_->fans.push_back(fan);
+
+      Zone zone;
+      zone.zoneName = "zone" + name;
+      zone.type = fan_config_structs::ZoneType::kZoneMax;
+      zone.sensorNames = {sensor.sensorName};
+      zone.fanNames = {fan.fanName};
+      config_->zones.push_back(zone);
+    }
+    bsp_ = std::make_shared<TestBsp>();
+    controlLogic_ = std::make_unique<ControlLogic>(config_, bsp_);
+    sensorData_ = std::make_shared<SensorData>();
+  }
+
+  void setReading(const std::string& name, float value) {
+    sensorData_->updateEntryFloat(name, value, bsp_->now);
+  }
+
+  std::shared_ptr<ServiceConfig> config_;
+  std::shared_ptr<TestBsp> bsp_;
+  std::unique_ptr<ControlLogic> controlLogic_;
+  std::shared_ptr<SensorData> sensorData_;
+};
+
+TEST_F(ControlLogicTest, sensorUpdateReprogramsAffectedZoneOnly) {
+  setReading("fan1_rpm", 1000);
+  setReading("fan2_rpm", 1000);
+  setReading("sensor1", 30);
+  setReading("sensor2", 30);
+  controlLogic_->updateControl(sensorData_);
+  EXPECT_EQ(bsp_->writes["fan1_pwm"], 20);
+  EXPECT_EQ(bsp_->writes["fan2_pwm"], 20);
+
+  bsp_->writes.clear();
+  bsp_->now++;
+  setReading("sensor1", 50);
+  controlLogic_->updateControlForSensors(sensorData_, {"sensor1"});
+  EXPECT_EQ(bsp_->writes.size(), 1);
+  EXPECT_EQ(bsp_->writes["fan1_pwm"], 50);
+
+  // The same reading, or sensors not used by any zone, change nothing
+  bsp_->writes.clear();
+  controlLogic_->updateControlForSensors(sensorData_, {"sensor1", "unknown"});
+  EXPECT_TRUE(bsp_->writes.empty());
+
+  // The periodic update keeps the event driven result
+  bsp_->now++;
+  controlLogic_->updateControl(sensorData_);
+  EXPECT_EQ(bsp_->writes["fan1_pwm"], 50);
+  EXPECT_EQ(bsp_->writes["fan2_pwm"], 20);
+}
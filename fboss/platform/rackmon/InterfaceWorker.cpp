@@ -0,0 +1,95 @@
+// Copyright 2021-present Facebook. All Rights Reserved.
+#include "InterfaceWorker.h"
+#include <future>
+#include "Log.h"
+
+namespace rackmon {
+
+void InterfaceWorker::start() {
+  std::unique_lock lk(mutex_);
+  if (running_) {
+    return;
+  }
+  running_ = true;
+  thread_ = std::thread(&InterfaceWorker::worker, this);
+}
+
+void InterfaceWorker::stop() {
+  {
+    std::unique_lock lk(mutex_);
+    if (!running_ || stopping_) {
+      return;
+    }
+    stopping_ = true;
+    cv_.notify_all();
+  }
+  thread_.join();
+  std::unique_lock lk(mutex_);
+  running_ = false;
+  stopping_ = false;
+}
+
+bool InterfaceWorker::post(InterfacePriority priority, Job job) {
+  std::unique_lock lk(mutex_);
+  if (!running_ || stopping_) {
+    return false;
+  }
+  queue_.push(Entry{priority, nextSequence_++, Clock::now(), std::move(job)});
+  cv_.notify_one();
+  return true;
+}
+
+void InterfaceWorker::run(InterfacePriority priority, const Job& job) {
+  std::promise<void> done;
+  std::future<void> result = done.get_future();
+  bool queued = post(priority, [&job, &done]() {
+    try {
+      job();
+      done.set_value();
+    } catch (...) {
+      done.set_exception(std::current_exception());
+    }
+  });
+  if (!queued) {
+    job();
+    return;
+  }
+  result.get();
+}
+
+void InterfaceWorker::recordPollCycle(std::chrono::milliseconds time) {
+  std::unique_lock lk(mutex_);
+  stats_.pollCycleTime.record(time);
+}
+
+InterfaceStats InterfaceWorker::getStats() const {
+  std::unique_lock lk(mutex_);
+  return stats_;
+}
+
+void InterfaceWorker::worker() {
+  std::unique_lock lk(mutex_);
+  while (true) {
+    cv_.wait(lk, [this]() { return stopping_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      // Stop requested and everything queued before it has run.
+      break;
+    }
+    Entry entry = queue_.top();
+    queue_.pop();
+    if (entry.priority == InterfacePriority::COMMAND) {
+      stats_.commandWaitTime.record(
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              Clock::now() - entry.posted));
+    }
+    lk.unlock();
+    try {
+      entry.job();
+    } catch (std::exception& e) {
+      logError << stats_.name << " job caught: " << e.what() << std::endl;
+    }
+    lk.lock();
+  }
+}
+
+} // namespace rackmon
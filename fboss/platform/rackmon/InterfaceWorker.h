@@ -0,0 +1,87 @@
+// Copyright 2021-present Facebook. All Rights Reserved.
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LatencyHistogram.h"
+
+namespace rackmon {
+
+// Priority of work scheduled on an interface. Lower runs first.
+enum class InterfacePriority { COMMAND = 0, MONITOR = 1 };
+
+struct InterfaceStats {
+  std::string name{};
+  // Time to read all registers of all active devices on the interface.
+  LatencyHistogram pollCycleTime{};
+  // Time a command was queued before it got the interface.
+  LatencyHistogram commandWaitTime{};
+};
+
+// Owns all the traffic on a single Modbus interface. Jobs run on
+// a dedicated thread in priority order (FIFO within a priority),
+// so a user command only ever waits for the transaction in flight
+// and not for a whole monitoring pass.
+class InterfaceWorker {
+ public:
+  using Job = std::function<void()>;
+  using Clock = std::chrono::steady_clock;
+
+  explicit InterfaceWorker(const std::string& name) {
+    stats_.name = name;
+  }
+  ~InterfaceWorker() {
+    stop();
+  }
+
+  void start();
+  // Stops the worker once every job already queued has run.
+  void stop();
+
+  // Queue a job. Returns false (without queueing) if the worker
+  // is not running.
+  bool post(InterfacePriority priority, Job job);
+
+  // Run the job on the worker and wait for it to complete. Anything
+  // thrown by the job is re-thrown here. If the worker is not running
+  // the job is executed inline on the caller's thread.
+  void run(InterfacePriority priority, const Job& job);
+
+  void recordPollCycle(std::chrono::milliseconds time);
+
+  InterfaceStats getStats() const;
+
+ private:
+  struct Entry {
+    InterfacePriority priority;
+    uint64_t sequence;
+    Clock::time_point posted;
+    Job job;
+  };
+  struct EntryCompare {
+    bool operator()(const Entry& a, const Entry& b) const {
+      if (a.priority != b.priority) {
+        return a.priority > b.priority;
+      }
+      return a.sequence > b.sequence;
+    }
+  };
+
+  mutable std::mutex mutex_{};
+  std::condition_variable cv_{};
+  std::priority_queue<Entry, std::vector<Entry>, EntryCompare> queue_{};
+  uint64_t nextSequence_ = 0;
+  bool running_ = false;
+  bool stopping_ = false;
+  std::thread thread_{};
+  InterfaceStats stats_{};
+
+  void worker();
+};
+
+} // namespace rackmon
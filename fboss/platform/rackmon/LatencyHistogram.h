@@ -0,0 +1,51 @@
+// Copyright 2021-present Facebook. All Rights Reserved.
+#pragma once
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+namespace rackmon {
+
+// Coarse log2 histogram of latencies. Bucket 0 counts samples
+// under 1ms, bucket i counts samples in [2^(i-1), 2^i) ms and
+// the last bucket collects everything beyond.
+struct LatencyHistogram {
+  static constexpr size_t kNumBuckets = 20;
+  std::array<uint64_t, kNumBuckets> buckets{};
+  uint64_t count = 0;
+  std::chrono::milliseconds total{0};
+  std::chrono::milliseconds max{0};
+
+  void record(std::chrono::milliseconds latency) {
+    size_t bucket = 0;
+    for (auto ms = latency.count(); ms > 0 && bucket < kNumBuckets - 1;
+         ms >>= 1) {
+      bucket++;
+    }
+    buckets[bucket]++;
+    count++;
+    total += latency;
+    max = std::max(max, latency);
+  }
+
+  // Returns the upper bound of the bucket holding the given
+  // percentile (0-100) of the samples. Capped at the max seen.
+  std::chrono::milliseconds percentile(double pct) const {
+    if (count == 0) {
+      return std::chrono::milliseconds(0);
+    }
+    uint64_t rank = std::max<uint64_t>(1, std::ceil(pct * count / 100));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kNumBuckets; i++) {
+      seen += buckets[i];
+      if (seen >= rank) {
+        return std::min(max, std::chrono::milliseconds((1LL << i) - 1));
+      }
+    }
+    return max;
+  }
+};
+
+} // namespace rackmon
@@ -1,5 +1,6 @@
 // Copyright 2021-present Facebook. All Rights Reserved.
 #include "ModbusDevice.h"
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 #include "Log.h"
@@ -21,6 +22,7 @@ ModbusDevice::ModbusDevice(
   info_.defaultBaudrate = registerMap.defaultBaudrate;
   info_.baudrate = info_.defaultBaudrate;
   info_.deviceType = registerMap.name;
+  maxReadGap_ = registerMap.maxReadGap;
 
   for (auto& it : registerMap.registerDescriptors) {
     info_.registerList.emplace_back(it.second);
@@ -145,62 +147,174 @@ void ModbusDevice::setBaudrate(uint32_t baud) {
   }
 }
 
-void ModbusDevice::reloadRegisters() {
-  setPreferredBaudrate();
-  // If the number of consecutive failures has exceeded
-  // a threshold, mark the device as dormant.
-  uint32_t timestamp = std::time(nullptr);
-  for (auto& specialHandler : specialHandlers_) {
-    // Break early, if we are entering exclusive mode
-    if (exclusiveMode_) {
-      break;
+void ModbusDevice::storeRegister(
+    RegisterStore& registerStore,
+    uint32_t timestamp) {
+  auto& nextRegister = registerStore.front();
+  nextRegister.timestamp = timestamp;
+  // If we dont care about changes or if we do
+  // and we notice that the value is different
+  // from the previous, increment store to
+  // point to the next.
+  if (!nextRegister.desc.storeChangesOnly ||
+      nextRegister != registerStore.back()) {
+    ++registerStore;
+  }
+}
+
+void ModbusDevice::readRegister(
+    RegisterStore& registerStore,
+    uint32_t timestamp) {
+  uint16_t registerOffset = registerStore.regAddr();
+  try {
+    readHoldingRegisters(registerOffset, registerStore.front().value);
+    storeRegister(registerStore, timestamp);
+  } catch (ModbusError& e) {
+    logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
+            << " ReadReg 0x" << std::hex << registerOffset << ' '
+            << registerStore.name() << " caught: " << e.what() << std::endl;
+    if (e.errorCode == ModbusErrorCode::ILLEGAL_DATA_ADDRESS) {
+      logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
+              << " ReadReg 0x" << std::hex << registerOffset << ' '
+              << registerStore.name()
+              << " unsupported. Disabled from monitoring" << std::endl;
+      registerStore.disable();
+      readPlanValid_ = false;
+    } else {
+      logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
+              << " ReadReg 0x" << std::hex << registerOffset << ' '
+              << registerStore.name() << " caught: " << e.what() << std::endl;
     }
-    specialHandler.handle(*this);
+  } catch (std::exception& e) {
+    logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
+            << " ReadReg 0x" << std::hex << registerOffset << ' '
+            << registerStore.name() << " caught: " << e.what() << std::endl;
   }
-  std::unique_lock lk(registerListMutex_);
-  for (auto& registerStore : info_.registerList) {
-    uint16_t registerOffset = registerStore.regAddr();
-    auto& nextRegister = registerStore.front();
-    // Break early, if we are entering exclusive mode
-    if (exclusiveMode_) {
-      break;
+}
+
+void ModbusDevice::readSpan(const ReadSpan& span, uint32_t timestamp) {
+  auto& registerList = info_.registerList;
+  readBuffer_.resize(span.length);
+  try {
+    readHoldingRegisters(span.begin, readBuffer_);
+  } catch (ModbusError& e) {
+    logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
+            << " ReadRegs 0x" << std::hex << span.begin << "+" << std::dec
+            << span.length << " caught: " << e.what() << std::endl;
+    if (e.errorCode != ModbusErrorCode::ILLEGAL_DATA_ADDRESS &&
+        e.errorCode != ModbusErrorCode::ILLEGAL_DATA_VALUE) {
+      return;
     }
+    // The device does not like something about the range. Read
+    // each register on its own to find out which. If none of them
+    // get disabled, it is the read itself that is unsupported
+    // (holes in the gaps or a limit on the count) so stop
+    // coalescing these registers.
+    bool disabledAny = false;
+    for (size_t i = span.first; i < span.last; i++) {
+      if (exclusiveMode_) {
+        return;
+      }
+      readRegister(registerList[i], timestamp);
+      disabledAny |= !registerList[i].isEnabled();
+    }
+    if (!disabledAny) {
+      for (size_t i = span.first; i < span.last; i++) {
+        standaloneRegisters_.insert(registerList[i].regAddr());
+      }
+    }
+    readPlanValid_ = false;
+    return;
+  } catch (std::exception& e) {
+    logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
+            << " ReadRegs 0x" << std::hex << span.begin << "+" << std::dec
+            << span.length << " caught: " << e.what() << std::endl;
+    return;
+  }
+  for (size_t i = span.first; i < span.last; i++) {
+    auto& registerStore = registerList[i];
+    auto& value = registerStore.front().value;
+    auto it = readBuffer_.begin() + (registerStore.regAddr() - span.begin);
+    std::copy(it, it + value.size(), value.begin());
+    storeRegister(registerStore, timestamp);
+  }
+}
+
+void ModbusDevice::buildReadPlan() {
+  const auto& registerList = info_.registerList;
+  readPlan_.clear();
+  // registerList is sorted by address. Grow the current span as long
+  // as the next register is enabled, close enough to its end and the
+  // whole read fits in a single response. Disabled registers always
+  // end a span so we never read them back as part of a gap.
+  bool canExtend = false;
+  for (size_t i = 0; i < registerList.size(); i++) {
+    const auto& registerStore = registerList[i];
     if (!registerStore.isEnabled()) {
+      canExtend = false;
       continue;
     }
-    try {
-      readHoldingRegisters(registerOffset, nextRegister.value);
-      nextRegister.timestamp = timestamp;
-      // If we dont care about changes or if we do
-      // and we notice that the value is different
-      // from the previous, increment store to
-      // point to the next.
-      if (!nextRegister.desc.storeChangesOnly ||
-          nextRegister != registerStore.back()) {
-        ++registerStore;
+    uint32_t begin = registerStore.regAddr();
+    uint32_t end = begin + registerStore.length();
+    bool standalone = standaloneRegisters_.count(begin) != 0;
+    if (canExtend && !standalone) {
+      auto& span = readPlan_.back();
+      uint32_t spanEnd = span.begin + span.length;
+      uint32_t newEnd = std::max(spanEnd, end);
+      if (begin <= spanEnd + maxReadGap_ &&
+          newEnd - span.begin <= kMaxRegistersPerRead) {
+        span.last = i + 1;
+        span.length = newEnd - span.begin;
+        continue;
       }
-    } catch (ModbusError& e) {
-      logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
-              << " ReadReg 0x" << std::hex << registerOffset << ' '
-              << registerStore.name() << " caught: " << e.what() << std::endl;
-      if (e.errorCode == ModbusErrorCode::ILLEGAL_DATA_ADDRESS) {
-        logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
-                << " ReadReg 0x" << std::hex << registerOffset << ' '
-                << registerStore.name()
-                << " unsupported. Disabled from monitoring" << std::endl;
-        registerStore.disable();
-      } else {
-        logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
-                << " ReadReg 0x" << std::hex << registerOffset << ' '
-                << registerStore.name() << " caught: " << e.what() << std::endl;
+    }
+    readPlan_.push_back(ReadSpan{
+        i, i + 1, uint16_t(begin), uint16_t(registerStore.length())});
+    canExtend = !standalone;
+  }
+  readPlanValid_ = true;
+}
+
+bool ModbusDevice::reloadNextRegisters() {
+  if (!reloadInProgress_) {
+    setPreferredBaudrate();
+    reloadTimestamp_ = std::time(nullptr);
+    for (auto& specialHandler : specialHandlers_) {
+      // Break early, if we are entering exclusive mode
+      if (exclusiveMode_) {
+        break;
       }
-      continue;
-    } catch (std::exception& e) {
-      logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
-              << " ReadReg 0x" << std::hex << registerOffset << ' '
-              << registerStore.name() << " caught: " << e.what() << std::endl;
-      continue;
+      specialHandler.handle(*this);
     }
+    reloadInProgress_ = true;
+    nextReadSpan_ = 0;
+  }
+  std::unique_lock lk(registerListMutex_);
+  if (nextReadSpan_ == 0 && !readPlanValid_) {
+    buildReadPlan();
+  }
+  // Failures below may invalidate the plan, it is only rebuilt
+  // at the start of the next cycle so it is safe to keep using it.
+  // Break early, if we are entering exclusive mode
+  if (exclusiveMode_ || nextReadSpan_ >= readPlan_.size()) {
+    reloadInProgress_ = false;
+    return false;
+  }
+  const auto& span = readPlan_[nextReadSpan_++];
+  if (span.last - span.first == 1) {
+    readRegister(info_.registerList[span.first], reloadTimestamp_);
+  } else {
+    readSpan(span, reloadTimestamp_);
+  }
+  if (nextReadSpan_ >= readPlan_.size()) {
+    reloadInProgress_ = false;
+    return false;
+  }
+  return true;
+}
+
+void ModbusDevice::reloadRegisters() {
+  while (reloadNextRegisters()) {
     // Release thread to allow for higher priority tasks to execute.
     std::this_thread::yield();
   }
@@ -215,6 +329,8 @@ void ModbusDevice::setActive() {
   for (auto& registerStore : info_.registerList) {
     registerStore.enable();
   }
+  standaloneRegisters_.clear();
+  readPlanValid_ = false;
   // Clear the num failures so we consider it active.
   info_.numConsecutiveFailures = 0;
   info_.mode = ModbusDeviceMode::ACTIVE;
@@ -81,6 +81,20 @@ void to_json(nlohmann::json& j, const ModbusDeviceValueData& m);
 
 class ModbusDevice {
   static constexpr uint32_t kMaxConsecutiveFailures = 10;
+  // Largest read whose response still fits in a Msg:
+  // addr(1), func(1), bytecount(1), <2 * count regs>, crc(2)
+  static constexpr uint16_t kMaxRegistersPerRead =
+      (Msg::kMaxModbusLength - 5) / 2;
+
+  // A single Read Holding Registers transaction covering the
+  // entries [first, last) of info_.registerList.
+  struct ReadSpan {
+    size_t first = 0;
+    size_t last = 0;
+    uint16_t begin = 0;
+    uint16_t length = 0;
+  };
+
   Modbus& interface_;
   int numCommandRetries_;
   ModbusDeviceRawData info_;
@@ -89,9 +103,27 @@ class ModbusDevice {
   const BaudrateConfig& baudConfig_;
   bool setBaudEnabled_ = true;
   std::atomic<bool> exclusiveMode_{false};
+  uint16_t maxReadGap_ = 0;
+  // Plan used by reloadRegisters, rebuilt whenever the set of
+  // enabled registers changes. Protected by registerListMutex_.
+  std::vector<ReadSpan> readPlan_{};
+  bool readPlanValid_ = false;
+  // Registers which the device refused to return as part of a
+  // larger read. These are always read on their own.
+  std::set<uint16_t> standaloneRegisters_{};
+  std::vector<uint16_t> readBuffer_{};
+  // State of the poll cycle in progress, see reloadNextRegisters().
+  bool reloadInProgress_ = false;
+  size_t nextReadSpan_ = 0;
+  uint32_t reloadTimestamp_ = 0;
 
   void handleCommandFailure(std::exception& baseException);
 
+  void buildReadPlan();
+  void readRegister(RegisterStore& registerStore, uint32_t timestamp);
+  void readSpan(const ReadSpan& span, uint32_t timestamp);
+  void storeRegister(RegisterStore& registerStore, uint32_t timestamp);
+
   void setBaudrate(uint32_t baud);
   void setDefaultBaudrate() {
     setBaudrate(info_.defaultBaudrate);
@@ -140,8 +172,14 @@ class ModbusDevice {
       std::vector<FileRecord>& records,
       ModbusTime timeout = ModbusTime::zero());
 
+  // Read all monitored registers of the device.
   void reloadRegisters();
 
+  // Same as reloadRegisters but performs a single read per call so
+  // the caller can interleave other traffic on the interface. Returns
+  // true as long as there are more reads left in the current cycle.
+  bool reloadNextRegisters();
+
   bool isActive() const {
     return info_.mode == ModbusDeviceMode::ACTIVE;
   }
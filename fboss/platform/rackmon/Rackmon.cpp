@@ -30,6 +30,8 @@ void Rackmon::loadInterface(const nlohmann::json& config) {
   for (const auto& ifaceConf : config["interfaces"]) {
     interfaces_.push_back(makeInterface());
     interfaces_.back()->initialize(ifaceConf);
+    workers_[interfaces_.back().get()] =
+        std::make_unique<InterfaceWorker>(interfaces_.back()->name());
   }
 }
 
@@ -75,13 +77,17 @@ bool Rackmon::probe(Modbus& interface, uint8_t addr) {
     return false;
   }
   const RegisterMap& rmap = registerMapDB_.at(addr);
+  InterfaceWorker& worker = *workers_.at(&interface);
   std::vector<uint16_t> v(1);
   try {
     ReadHoldingRegistersReq req(addr, rmap.probeRegister, v.size());
     ReadHoldingRegistersResp resp(addr, v);
-    interface.command(req, resp, rmap.defaultBaudrate, kProbeTimeout);
+    worker.run(InterfacePriority::MONITOR, [&]() {
+      interface.command(req, resp, rmap.defaultBaudrate, kProbeTimeout);
+    });
     std::unique_lock lock(devicesMutex_);
     devices_[addr] = std::make_unique<ModbusDevice>(interface, addr, rmap);
+    deviceWorkers_[addr] = &worker;
     logInfo << std::hex << std::setw(2) << std::setfill('0') << "Found "
             << int(addr) << " on " << interface.name() << std::endl;
     return true;
@@ -115,7 +121,10 @@ std::vector<uint8_t> Rackmon::inspectDormant() {
       std::vector<uint16_t> v(1);
       try {
         uint8_t addr = it.first;
-        it.second->readHoldingRegisters(probe, v);
+        ModbusDevice& dev = *it.second;
+        deviceWorkers_.at(addr)->run(InterfacePriority::MONITOR, [&]() {
+          dev.readHoldingRegisters(probe, v);
+        });
         ret.push_back(addr);
       } catch (...) {
         continue;
@@ -133,13 +142,73 @@ void Rackmon::recoverDormant() {
   }
 }
 
+std::future<void> Rackmon::pollInterface(
+    InterfaceWorker& worker,
+    std::vector<ModbusDevice*> devices) {
+  auto cycle = std::make_shared<PollCycle>();
+  cycle->devices = std::move(devices);
+  cycle->start = InterfaceWorker::Clock::now();
+  std::future<void> done = cycle->done.get_future();
+  if (!worker.post(InterfacePriority::MONITOR, [this, &worker, cycle]() {
+        pollStep(worker, cycle);
+      })) {
+    cycle->done.set_value();
+  }
+  return done;
+}
+
+void Rackmon::pollStep(
+    InterfaceWorker& worker,
+    std::shared_ptr<PollCycle> cycle) {
+  auto& devices = cycle->devices;
+  // Round robin through the devices one read at a time, dropping
+  // each once it is done with its registers.
+  if (devices[cycle->next]->reloadNextRegisters()) {
+    cycle->next++;
+  } else {
+    devices.erase(devices.begin() + cycle->next);
+  }
+  if (cycle->next >= devices.size()) {
+    cycle->next = 0;
+  }
+  if (devices.empty()) {
+    worker.recordPollCycle(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            InterfaceWorker::Clock::now() - cycle->start));
+    cycle->done.set_value();
+  } else if (!worker.post(
+                 InterfacePriority::MONITOR, [this, &worker, cycle]() {
+                   pollStep(worker, cycle);
+                 })) {
+    // Worker is stopping, the devices resume from where
+    // they are at the next cycle.
+    cycle->done.set_value();
+  }
+}
+
 void Rackmon::monitor(void) {
-  std::shared_lock lock(devicesMutex_);
-  for (const auto& dev_it : devices_) {
-    if (!dev_it.second->isActive()) {
-      continue;
+  std::map<InterfaceWorker*, std::vector<ModbusDevice*>> devicesByWorker;
+  {
+    // Devices are only ever added, never replaced or removed, so the
+    // pointers stay valid once the lock is dropped. Do not hold it
+    // across the poll cycle, probe() and recoverDormant() need it
+    // exclusively.
+    std::shared_lock lock(devicesMutex_);
+    for (const auto& dev_it : devices_) {
+      if (!dev_it.second->isActive()) {
+        continue;
+      }
+      devicesByWorker[deviceWorkers_.at(dev_it.first)].push_back(
+          dev_it.second.get());
     }
-    dev_it.second->reloadRegisters();
+  }
+  // Poll all interfaces in parallel and wait for all of them.
+  std::vector<std::future<void>> cycles;
+  for (auto& [worker, devices] : devicesByWorker) {
+    cycles.push_back(pollInterface(*worker, std::move(devices)));
+  }
+  for (auto& cycle : cycles) {
+    cycle.wait();
   }
   lastMonitorTime_ = std::time(nullptr);
 }
@@ -197,6 +266,9 @@ void Rackmon::start(PollThreadTime interval) {
   for (auto& dev_it : devices_) {
     dev_it.second->setExclusiveMode(false);
   }
+  for (auto& worker_it : workers_) {
+    worker_it.second->start();
+  }
   scanThread_ = makeThread(&Rackmon::scan, interval);
   scanThread_->start();
   monitorThread_ = makeThread(&Rackmon::monitor, interval);
@@ -217,16 +289,28 @@ void Rackmon::stop() {
     scanThread_->stop();
     scanThread_ = nullptr;
   }
+  // Commands from here on execute directly on the caller's thread.
+  for (auto& worker_it : workers_) {
+    worker_it.second->stop();
+  }
 }
 
-void Rackmon::rawCmd(Request& req, Response& resp, ModbusTime timeout) {
-  uint8_t addr = req.addr;
-  RACKMON_PROFILE_SCOPE(raw_cmd, "rawcmd::" + std::to_string(int(req.addr)));
+void Rackmon::runCommand(
+    uint8_t deviceAddress,
+    const std::function<void(ModbusDevice&)>& cmd) {
   std::shared_lock lock(devicesMutex_);
-  if (!devices_.at(addr)->isActive()) {
+  ModbusDevice& dev = *devices_.at(deviceAddress);
+  if (!dev.isActive()) {
     throw std::exception();
   }
-  devices_.at(addr)->command(req, resp, timeout);
+  deviceWorkers_.at(deviceAddress)
+      ->run(InterfacePriority::COMMAND, [&dev, &cmd]() { cmd(dev); });
+}
+
+void Rackmon::rawCmd(Request& req, Response& resp, ModbusTime timeout) {
+  uint8_t addr = req.addr;
+  RACKMON_PROFILE_SCOPE(raw_cmd, "rawcmd::" + std::to_string(int(req.addr)));
+  runCommand(addr, [&](ModbusDevice& dev) { dev.command(req, resp, timeout); });
   // Add back the CRC removed by validate.
   resp.len += 2;
 }
@@ -238,12 +322,9 @@ void Rackmon::readHoldingRegisters(
     ModbusTime timeout) {
   RACKMON_PROFILE_SCOPE(
       raw_cmd, "readRegs::" + std::to_string(int(deviceAddress)));
-  std::shared_lock lock(devicesMutex_);
-  if (!devices_.at(deviceAddress)->isActive()) {
-    throw std::exception();
-  }
-  devices_.at(deviceAddress)
-      ->readHoldingRegisters(registerOffset, registerContents, timeout);
+  runCommand(deviceAddress, [&](ModbusDevice& dev) {
+    dev.readHoldingRegisters(registerOffset, registerContents, timeout);
+  });
 }
 
 void Rackmon::writeSingleRegister(
@@ -253,12 +334,9 @@ void Rackmon::writeSingleRegister(
     ModbusTime timeout) {
   RACKMON_PROFILE_SCOPE(
       raw_cmd, "writeReg::" + std::to_string(int(deviceAddress)));
-  std::shared_lock lock(devicesMutex_);
-  if (!devices_.at(deviceAddress)->isActive()) {
-    throw std::exception();
-  }
-  devices_.at(deviceAddress)
-      ->writeSingleRegister(registerOffset, value, timeout);
+  runCommand(deviceAddress, [&](ModbusDevice& dev) {
+    dev.writeSingleRegister(registerOffset, value, timeout);
+  });
 }
 
 void Rackmon::writeMultipleRegisters(
@@ -268,12 +346,9 @@ void Rackmon::writeMultipleRegisters(
     ModbusTime timeout) {
   RACKMON_PROFILE_SCOPE(
       raw_cmd, "writeRegs::" + std::to_string(int(deviceAddress)));
-  std::shared_lock lock(devicesMutex_);
-  if (!devices_.at(deviceAddress)->isActive()) {
-    throw std::exception();
-  }
-  devices_.at(deviceAddress)
-      ->writeMultipleRegisters(registerOffset, values, timeout);
+  runCommand(deviceAddress, [&](ModbusDevice& dev) {
+    dev.writeMultipleRegisters(registerOffset, values, timeout);
+  });
 }
 
 void Rackmon::readFileRecord(
@@ -282,11 +357,9 @@ void Rackmon::readFileRecord(
     ModbusTime timeout) {
   RACKMON_PROFILE_SCOPE(
       raw_cmd, "ReadFile::" + std::to_string(int(deviceAddress)));
-  std::shared_lock lock(devicesMutex_);
-  if (!devices_.at(deviceAddress)->isActive()) {
-    throw std::exception();
-  }
-  devices_.at(deviceAddress)->readFileRecord(records, timeout);
+  runCommand(deviceAddress, [&](ModbusDevice& dev) {
+    dev.readFileRecord(records, timeout);
+  });
 }
 
 std::vector<ModbusDeviceInfo> Rackmon::listDevices() const {
@@ -338,4 +411,12 @@ void Rackmon::getValueData(
   }
 }
 
+std::vector<InterfaceStats> Rackmon::getInterfaceStats() const {
+  std::vector<InterfaceStats> stats;
+  for (const auto& iface : interfaces_) {
+    stats.push_back(workers_.at(iface.get())->getStats());
+  }
+  return stats;
+}
+
 } // namespace rackmon
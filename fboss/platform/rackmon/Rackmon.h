@@ -1,10 +1,12 @@
 // Copyright 2021-present Facebook. All Rights Reserved.
 #pragma once
 #include <atomic>
+#include <future>
 #include <optional>
 #include <set>
 #include <shared_mutex>
 #include <thread>
+#include "InterfaceWorker.h"
 #include "Modbus.h"
 #include "ModbusDevice.h"
 #include "PollThread.h"
@@ -34,12 +36,25 @@ class Rackmon {
   // Has to be before defining active or dormant devices
   // to ensure users get destroyed before the interface.
   std::vector<std::unique_ptr<Modbus>> interfaces_{};
+  // One worker per interface scheduling all traffic on it. This
+  // allows separate interfaces to be polled in parallel.
+  std::map<const Modbus*, std::unique_ptr<InterfaceWorker>> workers_{};
   RegisterMapDatabase registerMapDB_{};
 
   mutable std::shared_mutex devicesMutex_{};
 
   // These devices discovered on actively monitored busses
   std::map<uint8_t, std::unique_ptr<ModbusDevice>> devices_{};
+  // Worker of the interface each of the above devices sits on.
+  std::map<uint8_t, InterfaceWorker*> deviceWorkers_{};
+
+  // A monitoring pass over the active devices of one interface.
+  struct PollCycle {
+    std::vector<ModbusDevice*> devices{};
+    size_t next = 0;
+    InterfaceWorker::Clock::time_point start{};
+    std::promise<void> done{};
+  };
 
   // contains all the possible address allowed by currently
   // loaded register maps. A majority of these are not expected
@@ -77,6 +92,23 @@ class Rackmon {
   // Monitor loop. Blocks forever as long as req_stop is true.
   void monitor();
 
+  // Start a poll cycle of the given devices on the worker. The
+  // returned future is ready once every device has been read.
+  std::future<void> pollInterface(
+      InterfaceWorker& worker,
+      std::vector<ModbusDevice*> devices);
+
+  // Performs a single register read of the next device in the cycle
+  // and queues the rest of the cycle behind any pending commands.
+  void pollStep(InterfaceWorker& worker, std::shared_ptr<PollCycle> cycle);
+
+  // Runs a command on an active device from its interface's worker
+  // ahead of any monitoring. Throws std::out_of_range for unknown
+  // devices.
+  void runCommand(
+      uint8_t deviceAddress,
+      const std::function<void(ModbusDevice&)>& cmd);
+
   // Scan all possible devices. Skips active/dormant devices.
   void fullScan();
 
@@ -177,6 +209,9 @@ class Rackmon {
       const ModbusDeviceFilter& devFilter = {},
       const ModbusRegisterFilter& regFilter = {},
       bool latestValueOnly = false) const;
+
+  // Get poll cycle and command wait time histograms per interface.
+  std::vector<InterfaceStats> getInterfaceStats() const;
 };
 
 } // namespace rackmon
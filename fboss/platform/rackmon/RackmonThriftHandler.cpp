@@ -9,7 +9,9 @@
  */
 
 #include "fboss/platform/rackmon/RackmonThriftHandler.h"
+#include <fb303/ServiceData.h>
 #include <glog/logging.h>
+#include <filesystem>
 #include "fboss/platform/rackmon/RackmonConfig.h"
 
 namespace rackmonsvc {
@@ -168,10 +170,44 @@ ThriftHandler::ThriftHandler() {
     rackmond_.loadRegisterMap(nlohmann::json::parse(regmap));
   }
   rackmond_.start();
+  exportInterfaceStats();
 
   plsManager_.loadPlsConfig(nlohmann::json::parse(getRackmonPlsConfig()));
 }
 
+void ThriftHandler::exportInterfaceStats() {
+  // Exports rackmon.<iface>.{poll_cycle,command_wait}_ms.{p50,p99,max}
+  // and the matching sample counts.
+  using Histogram = rackmon::LatencyHistogram rackmon::InterfaceStats::*;
+  const std::vector<std::pair<std::string, Histogram>> histograms = {
+      {"poll_cycle", &rackmon::InterfaceStats::pollCycleTime},
+      {"command_wait", &rackmon::InterfaceStats::commandWaitTime},
+  };
+  auto counters = facebook::fb303::fbData->getDynamicCounters();
+  const auto stats = rackmond_.getInterfaceStats();
+  for (size_t idx = 0; idx < stats.size(); idx++) {
+    std::string iface = std::filesystem::path(stats[idx].name).filename();
+    for (const auto& [histName, hist] : histograms) {
+      std::string prefix = "rackmon." + iface + "." + histName;
+      auto getHistogram = [this, idx, hist = hist]() {
+        return rackmond_.getInterfaceStats().at(idx).*hist;
+      };
+      counters->registerCallback(prefix + "_count", [getHistogram]() {
+        return static_cast<int64_t>(getHistogram().count);
+      });
+      counters->registerCallback(prefix + "_ms.p50", [getHistogram]() {
+        return static_cast<int64_t>(getHistogram().percentile(50).count());
+      });
+      counters->registerCallback(prefix + "_ms.p99", [getHistogram]() {
+        return static_cast<int64_t>(getHistogram().percentile(99).count());
+      });
+      counters->registerCallback(prefix + "_ms.max", [getHistogram]() {
+        return static_cast<int64_t>(getHistogram().max.count());
+      });
+    }
+  }
+}
+
 void ThriftHandler::listModbusDevices(std::vector<ModbusDeviceInfo>& devices) {
   std::vector<rackmon::ModbusDeviceInfo> info = rackmond_.listDevices();
   for (auto& dev : info) {
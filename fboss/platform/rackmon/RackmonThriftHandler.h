@@ -37,6 +37,7 @@ class ThriftHandler : virtual public RackmonCtrlSvIf {
   ModbusRegisterValue transformRegisterValue(
       const rackmon::RegisterValue& value);
   RackmonStatusCode exceptionToStatusCode(std::exception& baseException);
+  void exportInterfaceStats();
 
  public:
   ThriftHandler();
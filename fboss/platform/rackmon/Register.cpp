@@ -288,6 +288,7 @@ void from_json(const json& j, RegisterMap& m) {
   j.at("name").get_to(m.name);
   j.at("preferred_baudrate").get_to(m.preferredBaudrate);
   j.at("default_baudrate").get_to(m.defaultBaudrate);
+  m.maxReadGap = j.value("max_read_gap", 0);
   std::vector<RegisterDescriptor> tmp;
   j.at("registers").get_to(tmp);
   for (auto& i : tmp) {
@@ -306,6 +307,7 @@ void to_json(json& j, const RegisterMap& m) {
   j["name"] = m.name;
   j["preferred_baudrate"] = m.preferredBaudrate;
   j["default_baudrate"] = m.preferredBaudrate;
+  j["max_read_gap"] = m.maxReadGap;
   j["registers"] = {};
   std::transform(
       m.registerDescriptors.begin(),
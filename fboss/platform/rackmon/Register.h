@@ -150,7 +150,7 @@ struct RegisterStore {
         regAddr_(desc.begin),
         history_(desc.keep, Register(desc)) {}
 
-  bool isEnabled() {
+  bool isEnabled() const {
     return enabled_;
   }
   void disable() {
@@ -181,6 +181,11 @@ struct RegisterStore {
     return regAddr_;
   }
 
+  // Number of 16bit registers this occupies.
+  uint16_t length() const {
+    return desc_.length;
+  }
+
   const std::string& name() const {
     return desc_.name;
   }
@@ -244,6 +249,11 @@ struct RegisterMap {
   uint32_t defaultBaudrate;
   uint32_t preferredBaudrate;
   BaudrateConfig baudConfig{};
+  // Largest number of unmonitored registers we are allowed to read
+  // (and discard) to coalesce two monitored registers into a single
+  // read. Defaults to 0, that is, only back-to-back registers are
+  // read together.
+  uint16_t maxReadGap = 0;
   std::vector<SpecialHandlerInfo> specialHandlers;
   std::map<uint16_t, RegisterDescriptor> registerDescriptors;
   const RegisterDescriptor& at(uint16_t reg) const {
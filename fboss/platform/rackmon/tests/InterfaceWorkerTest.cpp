@@ -0,0 +1,125 @@
+// Copyright 2021-present Facebook. All Rights Reserved.
+#include "InterfaceWorker.h"
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <future>
+
+using namespace std::literals;
+using namespace testing;
+using namespace rackmon;
+
+// Blocks the worker until released so we can queue up jobs
+// behind it and check the order in which they run.
+class BlockingJob {
+  std::promise<void> started_{};
+  std::promise<void> release_{};
+  std::shared_future<void> released_{release_.get_future().share()};
+
+ public:
+  InterfaceWorker::Job job() {
+    return [this]() {
+      started_.set_value();
+      released_.wait();
+    };
+  }
+  void waitStarted() {
+    started_.get_future().wait();
+  }
+  void release() {
+    release_.set_value();
+  }
+};
+
+TEST(InterfaceWorkerTest, CommandsPreemptMonitoring) {
+  InterfaceWorker worker("/dev/ttyUSB0");
+  worker.start();
+  BlockingJob blocker;
+  std::vector<std::string> order;
+  ASSERT_TRUE(worker.post(InterfacePriority::MONITOR, blocker.job()));
+  blocker.waitStarted();
+  worker.post(InterfacePriority::MONITOR, [&]() { order.push_back("mon1"); });
+  worker.post(InterfacePriority::MONITOR, [&]() { order.push_back("mon2"); });
+  auto cmd = std::async(std::launch::async, [&]() {
+    worker.run(InterfacePriority::COMMAND, [&]() { order.push_back("cmd"); });
+  });
+  // Give the command a chance to be queued behind the monitoring jobs.
+  // sleep override
+  std::this_thread::sleep_for(100ms);
+  blocker.release();
+  cmd.get();
+  worker.stop();
+  EXPECT_THAT(order, ElementsAre("cmd", "mon1", "mon2"));
+
+  InterfaceStats stats = worker.getStats();
+  EXPECT_EQ(stats.name, "/dev/ttyUSB0");
+  EXPECT_EQ(stats.commandWaitTime.count, 1);
+  EXPECT_GE(stats.commandWaitTime.max, 100ms);
+}
+
+TEST(InterfaceWorkerTest, RunPropagatesExceptions) {
+  InterfaceWorker worker("/dev/ttyUSB0");
+  worker.start();
+  EXPECT_THROW(
+      worker.run(
+          InterfacePriority::COMMAND,
+          []() { throw std::out_of_range("no device"); }),
+      std::out_of_range);
+  // Worker is still alive after the failed job.
+  bool ran = false;
+  worker.run(InterfacePriority::MONITOR, [&]() { ran = true; });
+  EXPECT_TRUE(ran);
+}
+
+TEST(InterfaceWorkerTest, RunInlineWhenStopped) {
+  InterfaceWorker worker("/dev/ttyUSB0");
+  EXPECT_FALSE(worker.post(InterfacePriority::MONITOR, []() {}));
+  std::thread::id runner;
+  worker.run(InterfacePriority::COMMAND, [&]() {
+    runner = std::this_thread::get_id();
+  });
+  EXPECT_EQ(runner, std::this_thread::get_id());
+  EXPECT_EQ(worker.getStats().commandWaitTime.count, 0);
+
+  worker.start();
+  worker.run(InterfacePriority::COMMAND, [&]() {
+    runner = std::this_thread::get_id();
+  });
+  EXPECT_NE(runner, std::this_thread::get_id());
+  worker.stop();
+  EXPECT_FALSE(worker.post(InterfacePriority::MONITOR, []() {}));
+}
+
+TEST(InterfaceWorkerTest, StopRunsQueuedJobs) {
+  InterfaceWorker worker("/dev/ttyUSB0");
+  worker.start();
+  BlockingJob blocker;
+  int ran = 0;
+  worker.post(InterfacePriority::MONITOR, blocker.job());
+  blocker.waitStarted();
+  for (int i = 0; i < 10; i++) {
+    worker.post(InterfacePriority::MONITOR, [&]() { ran++; });
+  }
+  blocker.release();
+  worker.stop();
+  EXPECT_EQ(ran, 10);
+}
+
+TEST(LatencyHistogramTest, Percentiles) {
+  LatencyHistogram hist;
+  EXPECT_EQ(hist.percentile(50), 0ms);
+  for (int i = 0; i < 98; i++) {
+    hist.record(3ms);
+  }
+  hist.record(100ms);
+  hist.record(1000ms);
+  EXPECT_EQ(hist.count, 100);
+  EXPECT_EQ(hist.total, 3ms * 98 + 1100ms);
+  EXPECT_EQ(hist.max, 1000ms);
+  // 3ms falls in [2, 4).
+  EXPECT_EQ(hist.percentile(50), 3ms);
+  // 100ms falls in [64, 128).
+  EXPECT_EQ(hist.percentile(99), 127ms);
+  EXPECT_EQ(hist.percentile(100), 1000ms);
+  hist.record(24h);
+  EXPECT_EQ(hist.buckets[LatencyHistogram::kNumBuckets - 1], 1);
+}
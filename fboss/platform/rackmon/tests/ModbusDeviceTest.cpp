@@ -817,3 +817,222 @@ TEST(ModbusDeviceBaudrate, BaudrateNegotiationRejection) {
         std::get<std::string>(data.registerList[0].history[0].value), "abcd");
   }
 }
+
+// Simulates a single device on the bus answering Read Holding
+// Registers requests from a flat register space. Reads touching
+// any address in unsupported get an ILLEGAL_DATA_ADDRESS error.
+// Counts the number of transactions (round trips) on the bus.
+class SimulatedUARTDevice : public UARTDevice {
+  // Gives access to the CRC computation of Msg.
+  struct SimulatedResponse : public Msg {
+    void seal() {
+      finalize();
+    }
+  };
+  SimulatedResponse resp_{};
+
+ public:
+  std::vector<uint16_t> registers;
+  std::set<uint16_t> unsupported{};
+  int transactions = 0;
+
+  explicit SimulatedUARTDevice(size_t numRegisters)
+      : UARTDevice("/dev/ttySIM0", 19200), registers(numRegisters) {
+    for (size_t i = 0; i < numRegisters; i++) {
+      registers[i] = 0x1000 + i;
+    }
+  }
+  void open() override {}
+  void close() override {}
+  bool exists() override {
+    return true;
+  }
+  void setAttribute(bool, int) override {}
+
+  void write(const uint8_t* buf, size_t) override {
+    // addr(1), func(1), reg_off(2), reg_cnt(2), crc(2)
+    uint16_t offset = (buf[2] << 8) | buf[3];
+    uint16_t count = (buf[4] << 8) | buf[5];
+    transactions++;
+    resp_.clear();
+    resp_ << buf[0];
+    for (uint32_t reg = offset; reg < uint32_t(offset) + count; reg++) {
+      if (reg >= registers.size() || unsupported.count(reg)) {
+        resp_ << uint8_t(0x83) << uint8_t(0x02);
+        resp_.seal();
+        return;
+      }
+    }
+    resp_ << uint8_t(0x03) << uint8_t(count * 2);
+    for (uint32_t reg = offset; reg < uint32_t(offset) + count; reg++) {
+      resp_ << registers[reg];
+    }
+    resp_.seal();
+  }
+
+  size_t read(uint8_t* buf, size_t, int) override {
+    std::copy(resp_.begin(), resp_.end(), buf);
+    return resp_.len;
+  }
+};
+
+class SimulatedModbus : public Modbus {
+ public:
+  SimulatedUARTDevice* device = nullptr;
+  SimulatedModbus() : Modbus() {
+    nlohmann::json conf;
+    conf["device_path"] = "/dev/ttySIM0";
+    conf["baudrate"] = 19200;
+    initialize(conf);
+  }
+  ~SimulatedModbus() override {
+    getHealthCheckThread().stop();
+  }
+  std::unique_ptr<UARTDevice>
+  makeDevice(const std::string&, const std::string&, uint32_t) override {
+    auto dev = std::make_unique<SimulatedUARTDevice>(512);
+    device = dev.get();
+    return dev;
+  }
+  // Returns the number of round trips since the last call.
+  int roundTrips() {
+    int ret = device->transactions;
+    device->transactions = 0;
+    return ret;
+  }
+};
+
+static RegisterMap makeRegisterMap(
+    const std::vector<std::pair<uint16_t, uint16_t>>& ranges,
+    uint16_t maxReadGap = 0) {
+  nlohmann::json j = R"({
+    "name": "sim_psu",
+    "address_range": [110, 140],
+    "probe_register": 0,
+    "default_baudrate": 19200,
+    "preferred_baudrate": 19200,
+    "registers": []
+  })"_json;
+  j["max_read_gap"] = maxReadGap;
+  for (const auto& [begin, length] : ranges) {
+    j["registers"].push_back(
+        {{"begin", begin},
+         {"length", length},
+         {"name", "REG_" + std::to_string(begin)}});
+  }
+  return j;
+}
+
+static void expectLatestValues(
+    ModbusDevice& dev,
+    const std::vector<uint16_t>& registers) {
+  ModbusDeviceRawData data = dev.getRawData();
+  for (auto& reg : data.registerList) {
+    // Skip registers which were never read.
+    if (!reg.back()) {
+      continue;
+    }
+    const auto& value = reg.back().value;
+    for (size_t i = 0; i < value.size(); i++) {
+      EXPECT_EQ(value[i], registers[reg.regAddr() + i]);
+    }
+  }
+}
+
+TEST(ModbusDeviceReadPlan, CoalesceAdjacentRegisters) {
+  SimulatedModbus bus;
+  // Before coalescing this was 6 round trips per cycle.
+  RegisterMap regmap =
+      makeRegisterMap({{0, 8}, {8, 2}, {10, 1}, {11, 1}, {20, 4}, {30, 2}});
+  ModbusDevice dev(bus, 0x6e, regmap, 1);
+  dev.reloadRegisters();
+  EXPECT_EQ(bus.roundTrips(), 3);
+  expectLatestValues(dev, bus.device->registers);
+
+  bus.device->registers[9] = 0xbeef;
+  bus.device->registers[31] = 0xcafe;
+  dev.reloadRegisters();
+  EXPECT_EQ(bus.roundTrips(), 3);
+  expectLatestValues(dev, bus.device->registers);
+}
+
+TEST(ModbusDeviceReadPlan, CoalesceAcrossGaps) {
+  SimulatedModbus bus;
+  // Gap between 12 and 20 is 8, 24 to 30 is 6.
+  RegisterMap regmap =
+      makeRegisterMap({{0, 8}, {8, 2}, {10, 1}, {11, 1}, {20, 4}, {30, 2}}, 6);
+  ModbusDevice dev(bus, 0x6e, regmap, 1);
+  dev.reloadRegisters();
+  EXPECT_EQ(bus.roundTrips(), 2);
+  expectLatestValues(dev, bus.device->registers);
+}
+
+TEST(ModbusDeviceReadPlan, MaxRegistersPerRead) {
+  SimulatedModbus bus;
+  std::vector<std::pair<uint16_t, uint16_t>> ranges;
+  for (uint16_t i = 0; i < 300; i++) {
+    ranges.emplace_back(i, 1);
+  }
+  RegisterMap regmap = makeRegisterMap(ranges);
+  ModbusDevice dev(bus, 0x6e, regmap, 1);
+  dev.reloadRegisters();
+  // Response can carry at most 124 registers.
+  EXPECT_EQ(bus.roundTrips(), 3);
+  expectLatestValues(dev, bus.device->registers);
+}
+
+TEST(ModbusDeviceReadPlan, UnsupportedRegisterInRange) {
+  SimulatedModbus bus;
+  bus.device->unsupported = {2};
+  RegisterMap regmap = makeRegisterMap({{0, 2}, {2, 2}, {4, 2}});
+  ModbusDevice dev(bus, 0x6e, regmap, 1);
+  // Failed coalesced read and falls back to one read per register.
+  dev.reloadRegisters();
+  EXPECT_EQ(bus.roundTrips(), 4);
+  // Register 2 is disabled, so we can no longer read across it.
+  dev.reloadRegisters();
+  EXPECT_EQ(bus.roundTrips(), 2);
+  expectLatestValues(dev, bus.device->registers);
+  ModbusDeviceValueData data = dev.getValueData();
+  ASSERT_EQ(data.registerList.size(), 3);
+  EXPECT_EQ(data.registerList[1].history.size(), 0);
+}
+
+TEST(ModbusDeviceReadPlan, UnsupportedGap) {
+  SimulatedModbus bus;
+  bus.device->unsupported = {5};
+  RegisterMap regmap = makeRegisterMap({{0, 4}, {8, 4}, {12, 4}}, 4);
+  ModbusDevice dev(bus, 0x6e, regmap, 1);
+  dev.reloadRegisters();
+  EXPECT_EQ(bus.roundTrips(), 4);
+  expectLatestValues(dev, bus.device->registers);
+  // Nothing got disabled, the registers are read on their own from now.
+  dev.reloadRegisters();
+  EXPECT_EQ(bus.roundTrips(), 3);
+  expectLatestValues(dev, bus.device->registers);
+  // Re-activating the device gives coalescing another try.
+  bus.device->unsupported = {};
+  dev.setActive();
+  dev.reloadRegisters();
+  EXPECT_EQ(bus.roundTrips(), 1);
+}
+
+TEST(ModbusDeviceReadPlan, ReloadOneReadAtATime) {
+  SimulatedModbus bus;
+  RegisterMap regmap = makeRegisterMap({{0, 2}, {10, 2}, {20, 2}});
+  ModbusDevice dev(bus, 0x6e, regmap, 1);
+  EXPECT_TRUE(dev.reloadNextRegisters());
+  EXPECT_EQ(bus.roundTrips(), 1);
+  EXPECT_TRUE(dev.reloadNextRegisters());
+  EXPECT_EQ(bus.roundTrips(), 1);
+  EXPECT_FALSE(dev.reloadNextRegisters());
+  EXPECT_EQ(bus.roundTrips(), 1);
+  expectLatestValues(dev, bus.device->registers);
+  // Next call starts over with a new cycle.
+  EXPECT_TRUE(dev.reloadNextRegisters());
+  EXPECT_EQ(bus.roundTrips(), 1);
+  // Entering exclusive mode ends the cycle early.
+  dev.setExclusiveMode(true);
+  EXPECT_FALSE(dev.reloadNextRegisters());
+  EXPECT_EQ(bus.roundTrips(), 0);
+}
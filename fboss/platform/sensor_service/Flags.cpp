@@ -27,3 +27,8 @@ DEFINE_string(
     "",
     "Optional platform sensor configuration file. "
     "If empty we pick the platform default config");
+
+DEFINE_uint32(
+    sensor_sample_threads,
+    4,
+    "Number of threads reading sysfs sensors in parallel, grouped by device");
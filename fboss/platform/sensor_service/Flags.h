@@ -16,3 +16,4 @@ DECLARE_uint32(sensor_fetch_interval);
 DECLARE_int32(stats_publish_interval);
 DECLARE_int32(thrift_port);
 DECLARE_string(config_file);
+DECLARE_uint32(sensor_sample_threads);
@@ -14,7 +14,7 @@ FsdbSyncer::FsdbSyncer()
     : fsdbPubSubMgr_(
           std::make_unique<fsdb::FsdbPubSubManager>("sensor_service")) {
   if (FLAGS_publish_stats_to_fsdb) {
-    fsdbPubSubMgr_->createStatPathPublisher(
+    fsdbPubSubMgr_->createStatDeltaPublisher(
         getSensorServiceStatsPath(), [this](auto oldState, auto newState) {
           fsdbStatPublisherStateChanged(oldState, newState);
         });
@@ -34,11 +34,50 @@ void FsdbSyncer::statsUpdated(const stats::SensorServiceStats& stats) {
   if (!readyForStatPublishing_.load()) {
     return;
   }
-  fsdb::OperState stateUnit;
-  stateUnit.contents() =
-      apache::thrift::BinarySerializer::serialize<std::string>(stats);
-  stateUnit.protocol() = fsdb::OperProtocol::BINARY;
-  fsdbPubSubMgr_->publishStat(std::move(stateUnit));
+  if (fullSyncRequired_.exchange(false)) {
+    publishedSensorData_.clear();
+  }
+  auto serialize = [](const platform::sensor_service::SensorData& data) {
+    return apache::thrift::BinarySerializer::serialize<std::string>(data);
+  };
+  auto makeDeltaUnit = [](const std::string& sensorName) {
+    fsdb::OperDeltaUnit deltaUnit;
+    deltaUnit.path()->raw() = getSensorServiceStatsPath();
+    deltaUnit.path()->raw()->push_back("sensorData");
+    deltaUnit.path()->raw()->push_back(sensorName);
+    return deltaUnit;
+  };
+  fsdb::OperDelta delta;
+  for (const auto& [sensorName, sensorData] : *stats.sensorData()) {
+    auto it = publishedSensorData_.find(sensorName);
+    if (it != publishedSensorData_.end() &&
+        *it->second.value() == *sensorData.value()) {
+      continue;
+    }
+    auto deltaUnit = makeDeltaUnit(sensorName);
+    if (it != publishedSensorData_.end()) {
+      deltaUnit.oldState() = serialize(it->second);
+    }
+    deltaUnit.newState() = serialize(sensorData);
+    delta.changes()->push_back(std::move(deltaUnit));
+    publishedSensorData_[sensorName] = sensorData;
+  }
+  for (auto it = publishedSensorData_.begin();
+       it != publishedSensorData_.end();) {
+    if (stats.sensorData()->count(it->first)) {
+      ++it;
+      continue;
+    }
+    auto deltaUnit = makeDeltaUnit(it->first);
+    deltaUnit.oldState() = serialize(it->second);
+    delta.changes()->push_back(std::move(deltaUnit));
+    it = publishedSensorData_.erase(it);
+  }
+  if (delta.changes()->empty()) {
+    return;
+  }
+  delta.protocol() = fsdb::OperProtocol::BINARY;
+  fsdbPubSubMgr_->publishStat(std::move(delta));
 }
 
 void FsdbSyncer::fsdbStatPublisherStateChanged(
@@ -49,6 +88,7 @@ void FsdbSyncer::fsdbStatPublisherStateChanged(
     // Stats sync at regular intervals, so let the sync
     // happen in that sequence after a connection.
     XLOG(INFO) << "FSDB Connection Established! Ready for Stat Publishing";
+    fullSyncRequired_.store(true);
     readyForStatPublishing_.store(true);
   } else {
     XLOG(INFO) << "FSDB Disconnected";
@@ -6,6 +6,7 @@
 #include "fboss/fsdb/client/FsdbStreamClient.h"
 #include "fboss/platform/sensor_service/gen-cpp2/sensor_service_stats_types.h"
 
+#include <map>
 #include <memory>
 
 namespace facebook::fboss {
@@ -16,6 +17,8 @@ class FsdbSyncer {
  public:
   FsdbSyncer();
   ~FsdbSyncer();
+  // Publishes the sensors whose value changed since the last publish.
+  // Everything is republished after (re)connecting to FSDB.
   void statsUpdated(const stats::SensorServiceStats& stats);
 
   fsdb::FsdbPubSubManager* pubSubMgr() {
@@ -34,6 +37,10 @@ class FsdbSyncer {
 
   std::unique_ptr<fsdb::FsdbPubSubManager> fsdbPubSubMgr_;
   std::atomic<bool> readyForStatPublishing_{false};
+  std::atomic<bool> fullSyncRequired_{true};
+  // Sensor data as of the last publish, only used from statsUpdated
+  std::map<std::string, platform::sensor_service::SensorData>
+      publishedSensorData_;
 };
 
 } // namespace facebook::fboss
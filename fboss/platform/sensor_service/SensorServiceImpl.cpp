@@ -16,6 +16,7 @@
 #include <filesystem>
 #include "fboss/platform/config_lib/ConfigLib.h"
 #include "fboss/platform/helpers/Utils.h"
+#include "fboss/platform/sensor_service/Flags.h"
 #include "fboss/platform/sensor_service/FsdbSyncer.h"
 #include "fboss/platform/sensor_service/gen-cpp2/sensor_service_stats_types.h"
 
@@ -63,6 +64,7 @@ void SensorServiceImpl::init() {
 
   // Clear everything before init
   sensorNameMap_.clear();
+  sampledSensors_.clear();
   sensorTable_.sensorMapList()->clear();
 
   // folly::dynamic sensorConf;
@@ -106,6 +108,20 @@ void SensorServiceImpl::init() {
     }
   });
 
+  if (sensorSource_ == SensorSource::SYSFS) {
+    sysfsSampler_ =
+        std::make_unique<SysfsSampler>(FLAGS_sensor_sample_threads);
+    liveDataTable_.withRLock([&](const auto& table) {
+      for (const auto& [sensorName, sensorLiveData] : table) {
+        sysfsSampler_->addSensor(sensorLiveData.path);
+        sampledSensors_.push_back(SampledSensor{
+            sensorName,
+            fmt::format(kSensorReadFailure, sensorName),
+            std::nullopt});
+      }
+    });
+  }
+
   fsdbSyncer_ = std::make_unique<FsdbSyncer>();
   XLOG(INFO) << "========================================================";
 }
@@ -211,12 +227,17 @@ void SensorServiceImpl::fetchSensorData() {
 }
 
 void SensorServiceImpl::getSensorDataFromPath() {
+  // Read sysfs outside of the lock, so thrift readers are not held up.
+  auto values = sysfsSampler_->sample();
   liveDataTable_.withWLock([&](auto& liveDataTable) {
     auto now = helpers::nowInSecs();
-    for (auto& [sensorName, sensorLiveData] : liveDataTable) {
-      std::string sensorValue;
-      if (folly::readFile(sensorLiveData.path.c_str(), sensorValue)) {
-        sensorLiveData.value = folly::to<float>(sensorValue);
+    for (size_t idx = 0; idx < sampledSensors_.size(); idx++) {
+      auto& sampledSensor = sampledSensors_[idx];
+      const auto& sensorName = sampledSensor.name;
+      auto& sensorLiveData = liveDataTable.at(sensorName);
+      bool readFailed = !values[idx].has_value();
+      if (!readFailed) {
+        sensorLiveData.value = *values[idx];
         sensorLiveData.timeStamp = now;
         if (sensorLiveData.compute != "") {
           sensorLiveData.value =
@@ -227,15 +248,17 @@ void SensorServiceImpl::getSensorDataFromPath() {
             sensorName,
             sensorLiveData.path,
             sensorLiveData.value);
-        fb303::fbData->setCounter(
-            fmt::format(kSensorReadFailure, sensorName), 0);
       } else {
         XLOG(INFO) << fmt::format(
             "Could not read data for {} from {}",
             sensorName,
             sensorLiveData.path);
+      }
+      // Counters keep their value, only touch them on a change.
+      if (sampledSensor.readFailed != readFailed) {
         fb303::fbData->setCounter(
-            fmt::format(kSensorReadFailure, sensorName), 1);
+            sampledSensor.readFailureCounter, readFailed ? 1 : 0);
+        sampledSensor.readFailed = readFailed;
       }
     }
   });
@@ -14,6 +14,7 @@
 #include <unordered_map>
 #include <vector>
 #include "fboss/platform/sensor_service/FsdbSyncer.h"
+#include "fboss/platform/sensor_service/SysfsSampler.h"
 #include "fboss/platform/sensor_service/if/gen-cpp2/sensor_config_types.h"
 #include "fboss/platform/sensor_service/if/gen-cpp2/sensor_service_types.h"
 #include "folly/Synchronized.h"
@@ -77,6 +78,15 @@ class SensorServiceImpl {
   folly::Synchronized<std::unordered_map<SensorName, struct SensorLiveData>>
       liveDataTable_;
 
+  // Sensors read through sysfsSampler_, in the order they were added
+  struct SampledSensor {
+    SensorName name;
+    std::string readFailureCounter;
+    std::optional<bool> readFailed;
+  };
+  std::vector<SampledSensor> sampledSensors_;
+  std::unique_ptr<SysfsSampler> sysfsSampler_;
+
   void init();
   void parseSensorJsonData(const std::string&);
   void getSensorDataFromPath();
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2004-present, Meta Platforms, Inc. and affiliates.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/platform/sensor_service/SysfsSampler.h"
+
+#include <fcntl.h>
+#include <folly/Conv.h>
+#include <folly/FileUtil.h>
+#include <folly/String.h>
+#include <folly/futures/Future.h>
+
+#include <array>
+#include <filesystem>
+
+namespace {
+// sysfs sensor attributes are a single short number
+constexpr size_t kMaxSensorValueLen = 64;
+} // namespace
+
+namespace facebook::fboss::platform::sensor_service {
+
+SysfsSampler::SysfsSampler(size_t numThreads) {
+  if (numThreads > 1) {
+    executor_ = std::make_unique<folly::CPUThreadPoolExecutor>(numThreads);
+  }
+}
+
+SysfsSampler::~SysfsSampler() {
+  if (executor_) {
+    executor_->join();
+  }
+}
+
+size_t SysfsSampler::addSensor(const std::string& path) {
+  auto device = std::filesystem::path(path).parent_path().string();
+  auto [it, inserted] =
+      deviceGroupIndex_.emplace(device, deviceGroups_.size());
+  if (inserted) {
+    deviceGroups_.emplace_back();
+  }
+  deviceGroups_[it->second].push_back(sensors_.size());
+  sensors_.push_back(SensorFile{path, folly::File()});
+  return sensors_.size() - 1;
+}
+
+std::vector<std::optional<float>> SysfsSampler::sample() {
+  std::vector<std::optional<float>> values(sensors_.size());
+  // Each group touches a disjoint set of sensors and values.
+  auto sampleGroup = [this, &values](const std::vector<size_t>& group) {
+    for (auto idx : group) {
+      values[idx] = readSensor(sensors_[idx]);
+    }
+  };
+  if (!executor_ || deviceGroups_.size() <= 1) {
+    for (const auto& group : deviceGroups_) {
+      sampleGroup(group);
+    }
+    return values;
+  }
+  std::vector<folly::Future<folly::Unit>> futures;
+  futures.reserve(deviceGroups_.size());
+  for (const auto& group : deviceGroups_) {
+    futures.push_back(folly::via(
+        executor_.get(), [&sampleGroup, &group]() { sampleGroup(group); }));
+  }
+  folly::collectAll(std::move(futures)).get();
+  return values;
+}
+
+std::optional<float> SysfsSampler::readSensor(SensorFile& sensor) {
+  if (!sensor.file) {
+    int fd = folly::openNoInt(sensor.path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return std::nullopt;
+    }
+    sensor.file = folly::File(fd, true /* ownsFd */);
+  }
+  // sysfs regenerates the attribute on every read at offset 0.
+  std::array<char, kMaxSensorValueLen> buf;
+  auto bytes = folly::preadNoInt(sensor.file.fd(), buf.data(), buf.size(), 0);
+  if (bytes <= 0) {
+    // Device may have been unbound/rebound, reopen on the next sample.
+    sensor.file.closeNoThrow();
+    return std::nullopt;
+  }
+  auto value = folly::tryTo<float>(
+      folly::trimWhitespace(folly::StringPiece(buf.data(), bytes)));
+  if (value.hasError()) {
+    return std::nullopt;
+  }
+  return value.value();
+}
+
+} // namespace facebook::fboss::platform::sensor_service
@@ -0,0 +1,56 @@
+/*
+ *  Copyright (c) 2004-present, Meta Platforms, Inc. and affiliates.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#pragma once
+
+#include <folly/File.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace facebook::fboss::platform::sensor_service {
+
+// Samples sysfs/hwmon sensor values. Sensor files are opened once and
+// re-read with pread, instead of an open/read/close per sensor on every
+// sample. Sensors are grouped by the device (directory) they belong to
+// and the groups are read in parallel on a small thread pool, so one
+// slow device does not hold up all others.
+class SysfsSampler {
+ public:
+  explicit SysfsSampler(size_t numThreads);
+  ~SysfsSampler();
+
+  // Adds a sensor to sample. Returns its index in the sample() result.
+  size_t addSensor(const std::string& path);
+
+  // Reads all sensors. Values are returned in the order the sensors were
+  // added, std::nullopt for sensors that could not be read or parsed.
+  std::vector<std::optional<float>> sample();
+
+ private:
+  struct SensorFile {
+    std::string path;
+    folly::File file;
+  };
+
+  static std::optional<float> readSensor(SensorFile& sensor);
+
+  std::vector<SensorFile> sensors_;
+  // Indices of sensors_, grouped by their device directory
+  std::vector<std::vector<size_t>> deviceGroups_;
+  std::map<std::string, size_t> deviceGroupIndex_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
+};
+
+} // namespace facebook::fboss::platform::sensor_service
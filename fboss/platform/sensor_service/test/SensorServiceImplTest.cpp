@@ -41,4 +41,31 @@ TEST_F(SensorServiceImplTest, fetchAndCheckSensorData) {
   }
 }
 
+TEST_F(SensorServiceImplTest, fetchSysfsSensorData) {
+  auto tmpPath = tmpDir.path().string();
+  auto impl = createSysfsSensorServiceImplForTest(tmpPath);
+  impl->fetchSensorData();
+  auto sensorData = impl->getAllSensorData();
+  EXPECT_EQ(sensorData.size(), 4);
+  EXPECT_EQ(sensorData["SYSFS_FRU_1_TEMP"].value(), 25);
+  EXPECT_EQ(sensorData["SYSFS_FRU_1_FAN"].value(), 11152);
+  EXPECT_EQ(sensorData["SYSFS_FRU_2_VIN"].value(), 11.875);
+  // Never read
+  EXPECT_EQ(sensorData["SYSFS_FRU_2_MISSING"].timeStamp(), 0);
+
+  // Files are kept open, new values must be picked up on the next fetch.
+  writeSysfsSensorValue(tmpPath, "hwmon1/fan1_input", "9000\n");
+  writeSysfsSensorValue(tmpPath, "hwmon2/in1_input", "12000\n");
+  impl->fetchSensorData();
+  sensorData = impl->getAllSensorData();
+  EXPECT_EQ(sensorData["SYSFS_FRU_1_TEMP"].value(), 25);
+  EXPECT_EQ(sensorData["SYSFS_FRU_1_FAN"].value(), 9000);
+  EXPECT_EQ(sensorData["SYSFS_FRU_2_VIN"].value(), 12);
+
+  // Unparsable values count as read failures and keep the last value.
+  writeSysfsSensorValue(tmpPath, "hwmon1/fan1_input", "N/A\n");
+  impl->fetchSensorData();
+  EXPECT_EQ(impl->getAllSensorData()["SYSFS_FRU_1_FAN"].value(), 9000);
+}
+
 } // namespace facebook::fboss
@@ -3,6 +3,7 @@
 #include <folly/FileUtil.h>
 #include <folly/dynamic.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
+#include <filesystem>
 
 #include "fboss/platform/sensor_service/test/TestUtils.h"
 
@@ -88,3 +89,43 @@ std::unique_ptr<SensorServiceImpl> createSensorServiceImplForTest(
 std::string createMockSensorDataFile(const std::string& tmpDirPath) {
   return mockSensorData(tmpDirPath);
 }
+
+void writeSysfsSensorValue(
+    const std::string& tmpDirPath,
+    const std::string& sensorFile,
+    const std::string& value) {
+  auto path = std::filesystem::path(tmpDirPath) / sensorFile;
+  std::filesystem::create_directories(path.parent_path());
+  folly::writeFile(value, path.c_str());
+}
+
+std::unique_ptr<SensorServiceImpl> createSysfsSensorServiceImplForTest(
+    const std::string& tmpDirPath) {
+  SensorConfig config;
+  config.source_ref() = "sysfs";
+
+  writeSysfsSensorValue(tmpDirPath, "hwmon1/temp1_input", "25000\n");
+  writeSysfsSensorValue(tmpDirPath, "hwmon1/fan1_input", "11152\n");
+  writeSysfsSensorValue(tmpDirPath, "hwmon2/in1_input", "11875\n");
+
+  Sensor temp, fan, vin, missing;
+  temp.path_ref() = tmpDirPath + "/hwmon1/temp1_input";
+  temp.compute_ref() = "@/1000.0";
+  fan.path_ref() = tmpDirPath + "/hwmon1/fan1_input";
+  vin.path_ref() = tmpDirPath + "/hwmon2/in1_input";
+  vin.compute_ref() = "@/1000.0";
+  missing.path_ref() = tmpDirPath + "/hwmon2/in2_input";
+
+  sensorMap sMapFru1, sMapFru2;
+  sMapFru1["SYSFS_FRU_1_TEMP"] = temp;
+  sMapFru1["SYSFS_FRU_1_FAN"] = fan;
+  sMapFru2["SYSFS_FRU_2_VIN"] = vin;
+  sMapFru2["SYSFS_FRU_2_MISSING"] = missing;
+  config.sensorMapList_ref() = {{"FRU1", sMapFru1}, {"FRU2", sMapFru2}};
+
+  std::string fileName = tmpDirPath + "/sysfs_sensor_config";
+  folly::writeFile(
+      apache::thrift::SimpleJSONSerializer::serialize<std::string>(config),
+      fileName.c_str());
+  return std::make_unique<SensorServiceImpl>(fileName);
+}
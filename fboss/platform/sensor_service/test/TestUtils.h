@@ -8,3 +8,13 @@ std::unique_ptr<facebook::fboss::platform::sensor_service::SensorServiceImpl>
 createSensorServiceImplForTest(const std::string& tmpDirPath);
 
 std::string createMockSensorDataFile(const std::string& tmpDirPath);
+
+// Creates a sysfs sourced service reading <tmpDirPath>/hwmon{1,2}/* files
+// written by writeSysfsSensorValue.
+std::unique_ptr<facebook::fboss::platform::sensor_service::SensorServiceImpl>
+createSysfsSensorServiceImplForTest(const std::string& tmpDirPath);
+
+void writeSysfsSensorValue(
+    const std::string& tmpDirPath,
+    const std::string& sensorFile,
+    const std::string& value);
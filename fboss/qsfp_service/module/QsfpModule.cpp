@@ -307,7 +307,7 @@ void QsfpModule::updateCachedTransceiverInfoLocked(ModuleStatus moduleStatus) {
 
   phy::LinkSnapshot snapshot;
   snapshot.transceiverInfo_ref() = info;
-  snapshots_.wlock()->addSnapshot(snapshot);
+  snapshots_.wlock()->addSnapshot(std::move(snapshot));
   *info_.wlock() = info;
 }
 
@@ -594,6 +594,14 @@ void WedgeManager::publishI2cTransactionStats() {
     statName = folly::to<std::string>(
         "qsfp.", *counter.controllerName_(), ".writeBytes");
     tcData().setCounter(statName, *counter.writeBytes_());
+
+    statName = folly::to<std::string>(
+        "qsfp.", *counter.controllerName_(), ".readTimeUsec");
+    tcData().setCounter(statName, *counter.readTimeUsec_());
+
+    statName = folly::to<std::string>(
+        "qsfp.", *counter.controllerName_(), ".writeTimeUsec");
+    tcData().setCounter(statName, *counter.writeTimeUsec_());
   }
 }
 
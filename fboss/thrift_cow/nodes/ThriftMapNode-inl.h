@@ -221,6 +221,10 @@ struct ThriftMapFields {
     return storage_.find(key);
   }
 
+  const_iterator lower_bound(const key_type& key) const {
+    return storage_.lower_bound(key);
+  }
+
   const_iterator cbegin() const {
     return storage_.cbegin();
   }
@@ -421,6 +425,10 @@ class ThriftMapNode
     return this->getFields()->find(key);
   }
 
+  typename Fields::const_iterator lower_bound(const key_type& key) const {
+    return this->getFields()->lower_bound(key);
+  }
+
   std::size_t size() const {
     return this->getFields()->size();
   }